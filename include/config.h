@@ -5,49 +5,259 @@
    Board Configuration
    ============================================ */
 #define BOARD_STM32F411CE
+#define HSE_CRYSTAL_HZ (25000000UL)     // Black Pill 25 MHz crystal
+
+/* ============================================
+   Clock Profile
+   ============================================ */
+#define CLOCK_PROFILE_HSI_16MHZ 0       // Reset default, no crystal needed
+#define CLOCK_PROFILE_HSE_PLL_100MHZ 1  // Maximum speed (no USB clock)
+#define CLOCK_PROFILE_HSE_PLL_96MHZ 2   // 48 MHz PLLQ for USB OTG FS
+#define CLOCK_PROFILE CLOCK_PROFILE_HSE_PLL_100MHZ
+
+#if CLOCK_PROFILE == CLOCK_PROFILE_HSI_16MHZ
 #define CLOCK_SOURCE_HSI
-#define CLOCK_FREQ_MHZ 16
+#define CLOCK_PROFILE_NAME "16 MHz (HSI)"
 #define SYSCLK_FREQ (16000000UL)
+#define CLOCK_APB1_DIV 1
+#define CLOCK_APB2_DIV 1
+#define FLASH_WAIT_STATES 0
+#elif CLOCK_PROFILE == CLOCK_PROFILE_HSE_PLL_100MHZ
+#define CLOCK_SOURCE_HSE_PLL
+#define CLOCK_PROFILE_NAME "100 MHz (HSE+PLL)"
+#define CLOCK_PLL_M 25                  // 25 MHz / 25 = 1 MHz VCO input
+#define CLOCK_PLL_N 200                 // VCO = 200 MHz
+#define CLOCK_PLL_P 2                   // SYSCLK = 100 MHz
+#define CLOCK_PLL_Q 9                   // 200 / 9 = 22.2 MHz (USB unusable)
+#define SYSCLK_FREQ ((HSE_CRYSTAL_HZ / CLOCK_PLL_M) * CLOCK_PLL_N / CLOCK_PLL_P)
+#define CLOCK_APB1_DIV 2                // APB1 max 50 MHz
+#define CLOCK_APB2_DIV 1
+#define FLASH_WAIT_STATES 3             // 90-100 MHz @ 2.7-3.6 V
+#elif CLOCK_PROFILE == CLOCK_PROFILE_HSE_PLL_96MHZ
+#define CLOCK_SOURCE_HSE_PLL
+#define CLOCK_PROFILE_NAME "96 MHz (HSE+PLL, USB)"
+#define CLOCK_PLL_M 25
+#define CLOCK_PLL_N 192                 // VCO = 192 MHz
+#define CLOCK_PLL_P 2                   // SYSCLK = 96 MHz
+#define CLOCK_PLL_Q 4                   // 48 MHz USB clock
+#define SYSCLK_FREQ ((HSE_CRYSTAL_HZ / CLOCK_PLL_M) * CLOCK_PLL_N / CLOCK_PLL_P)
+#define CLOCK_APB1_DIV 2
+#define CLOCK_APB2_DIV 1
+#define FLASH_WAIT_STATES 3
+#else
+#error "Unknown CLOCK_PROFILE"
+#endif
+
+#define CLOCK_FREQ_MHZ (SYSCLK_FREQ / 1000000UL)
+#define HCLK_FREQ SYSCLK_FREQ           // AHB prescaler fixed at 1
+#define PCLK1_FREQ (HCLK_FREQ / CLOCK_APB1_DIV)
+#define PCLK2_FREQ (HCLK_FREQ / CLOCK_APB2_DIV)
+
+// Timers on an APB bus with prescaler > 1 run at twice the bus clock
+#define TIM_APB1_CLK_FREQ ((CLOCK_APB1_DIV == 1) ? PCLK1_FREQ : (2UL * PCLK1_FREQ))
 
 /* ============================================
    ADC Configuration
    ============================================ */
-#define ADC_CHANNELS 1                  // Number of ADC channels
+#define ADC_CHANNELS (ENABLE_MULTICHANNEL ? 8 : 1)  // Channels per scan frame (PA0-PA7)
 #define ADC_SAMPLE_RATE_HZ 100          // Sampling frequency
 #define ADC_RESOLUTION 12               // 12-bit resolution
 #define ADC_MAX_VALUE ((1 << ADC_RESOLUTION) - 1)  // 4095
+#ifndef ADC_OVERSAMPLE_SHIFT
+#define ADC_OVERSAMPLE_SHIFT 2          // k: 4^k samples per output, 12+k effective bits (native_test: 4)
+#endif
+#define ADC_OVERSAMPLE_RATIO (1U << (2 * ADC_OVERSAMPLE_SHIFT))
+// Most outputs n inputs can complete, counting a group carried in from the last block
+#define ADC_OVERSAMPLE_MAX_OUTPUTS(n) (((n) + ADC_OVERSAMPLE_RATIO - 1U) / ADC_OVERSAMPLE_RATIO)
+#define ADC_OUTPUT_BITS (ENABLE_OVERSAMPLING ? (ADC_RESOLUTION + ADC_OVERSAMPLE_SHIFT) : ADC_RESOLUTION)
 #define ADC_REFERENCE_MV 3300           // 3.3V reference
+#define ADC_BLOCK_SIZE 10               // Frames per DMA half-buffer (ping-pong block)
+#define ADC_MAX_CLOCK_HZ (36000000UL)   // Datasheet limit for ADCCLK
+
+// Smallest ADCPRE divider (/2, /4, /6, /8) keeping ADCCLK in spec
+#define ADC_PRESCALER_DIV ((PCLK2_FREQ / 2U <= ADC_MAX_CLOCK_HZ) ? 2U : \
+                           (PCLK2_FREQ / 4U <= ADC_MAX_CLOCK_HZ) ? 4U : \
+                           (PCLK2_FREQ / 6U <= ADC_MAX_CLOCK_HZ) ? 6U : 8U)
+#define ADC_CCR_ADCPRE_BITS ((ADC_PRESCALER_DIV / 2U) - 1U)
+#define ADC_CLOCK_FREQ (PCLK2_FREQ / ADC_PRESCALER_DIV)
+
+// Raw-to-millivolt lookup table (built at compile time, core/adc_convert.h)
+#define ADC_CAL_OFFSET_COUNTS 0         // Zero offset subtracted before scaling
+#define ADC_CAL_GAIN_Q16 65536UL        // Gain correction, Q16 (65536 = 1.0)
+#define ADC_CONVERT_SPLIT_LUT 0         // Also store packed volts/millivolts (+8 KB flash)
+
+// VREFINT self-calibration (ENABLE_CALIBRATION, core/calibration.h)
+#define CAL_INTERVAL_MS 10000           // Re-measure VDDA this often
+#define CAL_VREFINT_SAMPLES 16          // Injected conversions averaged per update
+#define CAL_VDDA_MIN_MV 1700            // Reject measurements outside the
+#define CAL_VDDA_MAX_MV 3600            // F411 VDDA operating range
+#define CAL_GAIN_HYSTERESIS_Q16 16      // Skip table rebuild below ~0.025% change
 
 /* ============================================
    Timer Configuration
    ============================================ */
-#define TIM2_PRESCALER (1600 - 1)       // Prescale to 10kHz
-#define TIM2_PERIOD (100 - 1)           // 100Hz sampling rate
+#define TIM2_TICK_HZ 10000              // Counter clock after prescaler
+#define TIM2_PRESCALER ((TIM_APB1_CLK_FREQ / TIM2_TICK_HZ) - 1)   // Prescale to 10kHz
+#define TIM2_PERIOD ((TIM2_TICK_HZ / ADC_SAMPLE_RATE_HZ) - 1)     // 100Hz sampling rate
+#define TIM3_TICK_HZ 1000000UL          // Fast trigger timer (16-bit): 1 us rate steps
+#define TIM3_PRESCALER ((TIM_APB1_CLK_FREQ / TIM3_TICK_HZ) - 1)
+#define TIMEBASE_TICK_HZ 1000000UL      // TIM5 free-running 32-bit timebase (1 us)
+#define TIMEBASE_PRESCALER ((TIM_APB1_CLK_FREQ / TIMEBASE_TICK_HZ) - 1)
 
 /* ============================================
    UART Configuration
    ============================================ */
 #define UART_BAUDRATE 115200
+#define UART_BRR_VALUE ((PCLK2_FREQ + (UART_BAUDRATE / 2U)) / UART_BAUDRATE)   // USART1 on APB2
 #define UART_BUFFER_SIZE 256
 #define UART_TX_TIMEOUT_MS 1000
+#define UART_TX_BUFFER_SIZE (ENABLE_USB_CDC ? 4096 : 1024)  // Output ring (power of two); USB drains it ~10x faster
+
+/* ============================================
+   USB CDC Configuration
+   ============================================ */
+#define USB_CDC_VID 0x0483              // STMicroelectronics
+#define USB_CDC_PID 0x5740              // Virtual COM port
+#define USB_CDC_TX_PACKETS 8            // 64-byte packets queued per bulk IN transfer (1-8)
+#define USB_CDC_OUTPUT_DEFAULT 1        // Route output to USB at boot ("out" switches)
+#define FAULT_RETRY_INTERVAL_MS 500     // Re-check for an open port / TX space while a fault dump is undelivered
+
+/* ============================================
+   Filter Configuration
+   ============================================ */
+#define FILTER_DECIMATION 4             // Output rate = ADC_SAMPLE_RATE_HZ / N
+#define FILTER_MAX_TAPS 64              // Coefficient table limit (even)
+#define FILTER_MAX_INPUT 64             // Samples filtered per internal chunk
+#define FILTER_MAX_DECIMATION 16        // Upper bound for runtime "dec" changes
+
+/* ============================================
+   Command Interface Configuration
+   ============================================ */
+#define COMMAND_LINE_LENGTH 64          // Longest accepted command line
+#define COMMAND_MAX_ARGS 4              // Tokens per line, command name included
+
+/* ============================================
+   Logging Configuration
+   ============================================ */
+#define LOG_FLASH_FIRST_SECTOR 6        // Log region: sectors 6-7 = 0x08040000, 256 KB
+#define LOG_FLASH_SECTORS 2
+#define LOG_PAGE_SIZE 2048              // Program/index unit (divides the 128 KB sector)
+#define LOG_PROGRAM_WORDS 64            // Words per logger_service() call (~1 ms flash stall)
+#define LOG_SERVICE_INTERVAL_MS 5       // Program/readback task period
+#define LOG_ERASE_WHILE_SAMPLING 0      // 1: erase on demand, stalling acquisition 1-2 s per sector
+
+/* ============================================
+   Trigger Configuration
+   ============================================ */
+#define TRIGGER_PRE_FRAMES 256          // Max history kept ahead of the trigger point
+#define TRIGGER_POST_FRAMES 768         // Max frames captured from the trigger point on
+#define TRIGGER_LEVEL (1U << (ADC_OUTPUT_BITS - 1))  // Default edge threshold: mid-scale
+#define TRIGGER_HYSTERESIS 32           // Counts an edge must retreat before re-arming
+#define TRIGGER_SHIP_INTERVAL_MS 10     // Capture drain task period
+
+/* ============================================
+   Telemetry Configuration
+   ============================================ */
+#define TELEMETRY_FORMAT_ASCII 0        // "Smp ... | ADC ... | V ..." lines
+#define TELEMETRY_FORMAT_BINARY 1       // Packed 12-bit frames (tools/telemetry_decode.py)
+#define TELEMETRY_FORMAT_SUMMARY 2      // Periodic statistics lines only (ENABLE_STATISTICS)
+#define TELEMETRY_FORMAT TELEMETRY_FORMAT_ASCII
+#define TELEMETRY_MAX_SAMPLES 256       // Samples per binary frame
+#define LOSS_REPORT_INTERVAL_MS 1000    // Loss counters: status frame (binary) or line on change (0 = never)
+
+/* ============================================
+   Error Log Configuration
+   ============================================ */
+#define ERROR_LOG_SIZE 16               // Logged events kept (power of two), oldest overwritten
+#define ERROR_RATE_LIMIT_MS 1000        // Min gap between logged events of one code (all are counted)
+#define ERROR_REPORT_INTERVAL_MS 1000   // New events printed as "Err ..." lines in text formats (0 = never)
+#define ERROR_REPORT_MAX_LINES 4        // Lines per interval; the rest wait for the next one
+
+/* ============================================
+   Watchdog Configuration
+   ============================================ */
+#define WATCHDOG_TIMEOUT_MS (ENABLE_LOGGING ? 6000 : 1000)  // IWDG period; must outlast a 128 KB sector erase stall
+#define WATCHDOG_SERVICE_MS 100         // Deadline check / feed period
+#define WATCHDOG_STAGE_MARGIN_MS 500    // Slack on top of twice a stage's expected check-in period
+
+/* ============================================
+   Scheduler Configuration
+   ============================================ */
+#define SCHED_TICK_HZ 1000              // SysTick rate (1 ms tick)
+#define SCHED_MAX_TASKS 16              // Task table size
+#define LED_BLINK_PERIOD_MS 100         // Status LED toggle period
+#define SCHED_REPORT_INTERVAL_MS 0      // Per-task runs/overruns dump (0 = never)
+#define PIPELINE_REPORT_INTERVAL_MS 0   // Per-stage cycles/backlog dump (0 = never)
+
+/* ============================================
+   Power Configuration
+   ============================================ */
+#define POWER_POLICY_RUN 0              // Never halt the core (lowest wake latency)
+#define POWER_POLICY_SLEEP 1            // WFI between tasks, peripherals keep running
+#define POWER_POLICY_STOP 2             // WFI, plus Stop mode in long gaps while acquisition is paused
+#define POWER_POLICY POWER_POLICY_SLEEP
+#define POWER_STOP_MIN_MS 20            // Shortest idle gap worth a Stop entry (HSE/PLL restart ~2 ms)
+#define POWER_RX_HOLDOFF_MS 5000        // No Stop this long after an RX byte woke it, so a command can be typed
+#define POWER_REPORT_INTERVAL_MS 0      // Sleep/wake/duty-cycle dump (0 = never)
+
+/* ============================================
+   Statistics Configuration
+   ============================================ */
+#define STATS_WINDOW_SIZE 64            // Sliding-window length (power of two)
+#define STATS_REPORT_INTERVAL_MS 1000   // Summary period in TELEMETRY_FORMAT_SUMMARY
 
 /* ============================================
    Buffer Configuration
    ============================================ */
-#define DATA_BUFFER_SIZE 1024           // ADC data circular buffer
-#define UART_RX_BUFFER_SIZE 256
-#define LOG_BUFFER_SIZE 4096
+#define UART_RX_BUFFER_SIZE 256        // DMA circular RX ring (even)
+#define LOG_BUFFER_SIZE 4096            // Logger RAM staging (whole LOG_PAGE_SIZE pages)
+
+/* ============================================
+   Memory Configuration
+   ============================================ */
+#define MEMORY_ALIGN 16                 // Arena block alignment (DMA FIFO bursts)
+#define MEMORY_ROUND(bytes) (((bytes) + MEMORY_ALIGN - 1U) & ~(MEMORY_ALIGN - 1U))
+
+// Arena budget per subsystem (utils/memory.h); 0 while the feature is off
+#define MEMORY_ADC_BYTES MEMORY_ROUND(2U * ADC_BLOCK_SIZE * ADC_CHANNELS * 2U)
+#define MEMORY_PIPELINE_BYTES (((ADC_CONVERT_SPLIT_LUT && ADC_OUTPUT_BITS == ADC_RESOLUTION) ? 0 : MEMORY_ROUND(ADC_BLOCK_SIZE * 2U)) \
+    + (ENABLE_FILTER ? MEMORY_ROUND(ADC_BLOCK_SIZE * ADC_CHANNELS * 2U) : 0) \
+    + (ENABLE_OVERSAMPLING ? MEMORY_ROUND(ADC_OVERSAMPLE_MAX_OUTPUTS(ADC_BLOCK_SIZE) * ADC_CHANNELS * 2U) : 0))
+#define MEMORY_UART_BYTES (MEMORY_ROUND(UART_TX_BUFFER_SIZE) + MEMORY_ROUND(UART_RX_BUFFER_SIZE))
+#define MEMORY_LOGGER_BYTES (ENABLE_LOGGING ? MEMORY_ROUND(LOG_BUFFER_SIZE) : 0)
+#define MEMORY_TRIGGER_BYTES (ENABLE_TRIGGER ? (MEMORY_ROUND(TRIGGER_PRE_FRAMES * ADC_CHANNELS * 2U) \
+    + MEMORY_ROUND((TRIGGER_PRE_FRAMES + TRIGGER_POST_FRAMES) * ADC_CHANNELS * 2U)) : 0)
+#define MEMORY_ARENA_SPARE 0            // Extra arena bytes beyond the budgets
+#define MEMORY_ARENA_SIZE (MEMORY_ADC_BYTES + MEMORY_PIPELINE_BYTES + MEMORY_UART_BYTES \
+    + MEMORY_LOGGER_BYTES + MEMORY_TRIGGER_BYTES + MEMORY_ARENA_SPARE)
+
+/* ============================================
+   Sampling Mode Configuration
+   ============================================ */
+#define SAMPLING_MODE_TIM2 0            // TIM2 TRGO, TIM2_TICK_HZ rate steps, scan-list sample times
+#define SAMPLING_MODE_TIM3 1            // TIM3 TRGO, TIM3_TICK_HZ rate steps
+#define SAMPLING_MODE_INTERLEAVED 2     // TIM3 50% PWM, ADC fires on both edges: 2 frames per period
+#define SAMPLING_MODE_CONTINUOUS 3      // Free-running ADC, no timer: rate = ADCCLK / frame cycles
+#define SAMPLING_MODE SAMPLING_MODE_TIM2                        // Boot mode ("mode" switches)
+#define SAMPLING_TIM3_SAMPLE_TIME ADC_SAMPLE_15_CYCLES          // Per-mode SMPR setting
+#define SAMPLING_INTERLEAVED_SAMPLE_TIME ADC_SAMPLE_15_CYCLES
+#define SAMPLING_CONTINUOUS_SAMPLE_TIME ADC_SAMPLE_144_CYCLES   // 25 MHz / 156 = 160 ksps (100 MHz clock, one channel)
 
 /* ============================================
    Feature Flags (Phase 1+)
    ============================================ */
-#define ENABLE_WATCHDOG 0               // Watchdog timer
+#define ENABLE_WATCHDOG 0               // IWDG fed only while every pipeline stage checks in (middleware/supervisor.h)
 #define ENABLE_ERROR_HANDLING 1         // Error detection
-#define ENABLE_LOGGING 0                // Data logging to flash
-#define ENABLE_CALIBRATION 0            // ADC calibration
-#define ENABLE_STATISTICS 0             // Min/max/avg calculation
-#define ENABLE_COMMAND_INTERFACE 0      // UART command parser
-#define ENABLE_MULTICHANNEL 0           // Multiple ADC channels
+#define ENABLE_LOGGING 0                // Circular flash log of binary frames (middleware/logger.h)
+#define ENABLE_CALIBRATION 0            // VREFINT gain correction folded into LUT
+#define ENABLE_STATISTICS 0             // Running + windowed min/max/mean/stddev/RMS
+#define ENABLE_COMMAND_INTERFACE 0      // UART RX command parser (middleware/command.h)
+#define ENABLE_MULTICHANNEL 0           // Multiple ADC channels (scan mode)
+#define ENABLE_FILTER 0                 // FIR low-pass + decimation per block
+#define ENABLE_OVERSAMPLING 0           // 4^k accumulate + shift for 13-16 bit output
+#define ENABLE_PROFILING 0              // DWT cycle-count probes (utils/profile.h)
+#define ENABLE_TRIGGER 0                // Triggered pre/post capture replaces the stream
+#define ENABLE_USB_CDC 0                // USB virtual COM port on PA11/PA12 (needs CLOCK_PROFILE_HSE_PLL_96MHZ)
 
 /* ============================================
    Debug Configuration
@@ -62,4 +272,10 @@
 #define INTERRUPT_PRIORITY 0
 #define USE_FLOATING_POINT 0            // Use integer math only
 
+/* ============================================
+   Profiling Configuration
+   ============================================ */
+#define PROFILE_HISTOGRAM_BINS 24       // log2 buckets: [2^b, 2^(b+1)) cycles, last is open-ended
+#define PROFILE_REPORT_INTERVAL_MS 5000 // Periodic probe dump (0 = never)
+
 #endif // __CONFIG_H__
@@ -24,22 +24,65 @@ typedef struct {
     uint32_t voltage_mv;                // Voltage in millivolts
     uint32_t voltage_whole;             // Whole volts (V)
     uint32_t voltage_decimal;           // Decimal portion (mV)
-    uint64_t timestamp_ms;              // Timestamp
+    uint64_t timestamp_ms;              // Trigger time of the value's frame (timebase)
+    uint8_t resolution_bits;            // Effective bit depth of raw_value (12-16)
     adc_status_t status;                // Conversion status
 } adc_reading_t;
 
+/* ============================================
+   Scan Sequence Types
+   ============================================ */
+#define ADC_MAX_SCAN_CHANNELS 16        // SQ1..SQ16
+
+typedef enum {
+    ADC_SAMPLE_3_CYCLES = 0,
+    ADC_SAMPLE_15_CYCLES = 1,
+    ADC_SAMPLE_28_CYCLES = 2,
+    ADC_SAMPLE_56_CYCLES = 3,
+    ADC_SAMPLE_84_CYCLES = 4,
+    ADC_SAMPLE_112_CYCLES = 5,
+    ADC_SAMPLE_144_CYCLES = 6,
+    ADC_SAMPLE_480_CYCLES = 7,
+    ADC_SAMPLE_TIME_LIST = 0xFF         // adc_set_sample_time(): keep the scan list's times
+} adc_sample_time_t;
+
+typedef struct {
+    uint8_t channel;                    // ADC input (0-18)
+    adc_sample_time_t sample_time;      // SMPR setting for this input
+} adc_scan_channel_t;
+
+/* ============================================
+   Conversion Trigger
+   ============================================ */
+typedef enum {
+    ADC_TRIGGER_TIM2_TRGO = 0,          // EXTSEL = 0110, rising edge
+    ADC_TRIGGER_TIM3_TRGO,              // EXTSEL = 1000, rising edge
+    ADC_TRIGGER_TIM3_TRGO_BOTH,         // EXTSEL = 1000, both edges
+    ADC_TRIGGER_CONTINUOUS              // No trigger: CONT = 1, started by SWSTART
+} adc_trigger_t;
+
+/**
+ * Strided, zero-copy view of one channel inside an interleaved block.
+ * Sample i of the channel is base[i * stride].
+ */
+typedef struct {
+    const volatile uint16_t *base;      // First sample of the channel
+    uint16_t stride;                    // Samples between frames (scan length)
+    uint16_t count;                     // Frames in the block
+} adc_channel_view_t;
+
 /* ============================================
    Public Function Declarations
    ============================================ */
 
 /**
- * @brief Initialize ADC1 with DMA trigger
+ * @brief Initialize ADC1 with DMA, triggered by TIM2 TRGO
  * @return ADC status
  */
 adc_status_t adc_init(void);
 
 /**
- * @brief Start ADC conversions
+ * @brief Start ADC conversions (software start in continuous mode)
  */
 void adc_start(void);
 
@@ -50,18 +93,116 @@ void adc_stop(void);
 
 /**
  * @brief Get latest ADC reading
+ *
+ * Returns the value last passed to adc_publish_reading(), once; a
+ * second call before the next block returns ADC_STATUS_NOT_READY.
+ *
  * @param reading Pointer to adc_reading_t structure
  * @return ADC status
  */
 adc_status_t adc_get_reading(adc_reading_t *reading);
 
 /**
- * @brief Convert raw ADC value to voltage
+ * @brief Publish the newest output value for adc_get_reading()
+ *
+ * Called by the processing pipeline once per block with the last
+ * value of the first scan channel: raw 12-bit counts, or the
+ * oversampled result with its effective depth.
+ *
+ * @param value Raw or oversampled count
+ * @param bits Effective resolution of value (12-16)
+ * @param timestamp_us Trigger time of the value's (first) frame
+ */
+void adc_publish_reading(uint16_t value, uint8_t bits, uint64_t timestamp_us);
+
+/**
+ * @brief Convert raw ADC value to voltage (adc_mv_table lookup)
  * @param raw_value Raw ADC count
  * @return Voltage in millivolts
  */
 uint32_t adc_raw_to_voltage_mv(uint16_t raw_value);
 
+/**
+ * @brief Program the regular scan sequence
+ *
+ * One trigger converts the whole list in order; DMA writes one
+ * interleaved frame (channel 0..count-1) per trigger. Call with
+ * conversions stopped, and restart DMA afterwards so frames stay
+ * aligned to the block buffer.
+ *
+ * @param channels Channel list with per-channel sample times
+ * @param count Number of entries (1-ADC_MAX_SCAN_CHANNELS)
+ * @return ADC status
+ */
+adc_status_t adc_configure_scan(const adc_scan_channel_t *channels, uint8_t count);
+
+/**
+ * @brief Select what starts a frame (conversions stopped)
+ *
+ * In ADC_TRIGGER_CONTINUOUS the next frame starts as soon as the last
+ * one ends; adc_start() issues the software start, and the overrun
+ * handler re-issues it after a resync.
+ *
+ * @param trigger Trigger source and edge
+ */
+void adc_set_trigger(adc_trigger_t trigger);
+
+/**
+ * @brief Use one sample time for every channel in the sequence
+ *
+ * Applies now and to later adc_configure_scan() calls, whose
+ * per-channel times are ignored until ADC_SAMPLE_TIME_LIST is set
+ * again.
+ *
+ * @param sample_time SMPR setting, or ADC_SAMPLE_TIME_LIST
+ */
+void adc_set_sample_time(adc_sample_time_t sample_time);
+
+/**
+ * @brief ADCCLK cycles to convert one frame of the current sequence
+ *
+ * Sample time plus ADC_RESOLUTION cycles (successive approximation)
+ * per channel, as RM0383 11.5 gives it. ADC_CLOCK_FREQ divided by this
+ * is the highest frame rate the ADC can sustain.
+ *
+ * @param sample_time Time to assume for every channel, or
+ *                    ADC_SAMPLE_TIME_LIST for the scan list's own
+ * @return Cycles per frame
+ */
+uint32_t adc_get_frame_cycles(adc_sample_time_t sample_time);
+
+/**
+ * @brief Get the programmed scan length
+ * @return Channels per frame
+ */
+uint8_t adc_get_scan_length(void);
+
+/**
+ * @brief Build a strided view of one channel in an interleaved block
+ * @param block First sample of a DMA block
+ * @param length Samples in the block (frames * scan length)
+ * @param index Position of the channel in the scan list
+ * @param view Pointer to adc_channel_view_t
+ * @return true if successful
+ */
+bool adc_get_channel_view(const volatile uint16_t *block, uint16_t length,
+                          uint8_t index, adc_channel_view_t *view);
+
+/**
+ * @brief Read sample i of a channel view
+ */
+static inline uint16_t adc_view_get(const adc_channel_view_t *view, uint16_t i) {
+    return view->base[(uint32_t)i * view->stride];
+}
+
+/**
+ * @brief Convert a value of any effective bit depth to voltage
+ * @param value Raw or oversampled count
+ * @param bits Effective resolution of value (12-16)
+ * @return Voltage in millivolts
+ */
+uint32_t adc_value_to_voltage_mv(uint32_t value, uint8_t bits);
+
 /**
  * @brief Check if ADC is ready
  * @return true if ready, false otherwise
@@ -74,4 +215,14 @@ bool adc_is_ready(void);
  */
 adc_status_t adc_get_status(void);
 
+/**
+ * @brief Get number of ADC overruns (OVR) since adc_init()
+ *
+ * Each overrun loses at least one conversion plus the unfinished part
+ * of the current DMA block (see dma_get_lost_samples()).
+ *
+ * @return Overrun count
+ */
+uint32_t adc_get_overrun_count(void);
+
 #endif // __ADC_H__
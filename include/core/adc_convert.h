@@ -0,0 +1,125 @@
+#ifndef __ADC_CONVERT_H__
+#define __ADC_CONVERT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   Raw-to-Millivolt Lookup Tables
+   ============================================
+   adc_mv_table[raw] = round(max(raw - ADC_CAL_OFFSET_COUNTS, 0)
+                             * ADC_REFERENCE_MV * ADC_CAL_GAIN_Q16
+                             / (ADC_MAX_VALUE * 65536))
+
+   Both tables are generated by the preprocessor and live in flash, so a
+   conversion is one load instead of a multiply and a divide. With
+   ADC_CONVERT_SPLIT_LUT each entry is also available pre-split as
+   (volts << 10) | millivolts, removing the /1000 and %1000 from
+   formatting paths.
+
+   With ENABLE_CALIBRATION the lookups go through adc_mv_lut, which
+   starts on the flash table and is switched to a RAM copy rebuilt by
+   adc_convert_rebuild() with the measured gain, so a corrected
+   conversion is still a single load.
+   ============================================ */
+#define ADC_CONVERT_TABLE_SIZE (ADC_MAX_VALUE + 1)
+
+#define ADC_CONVERT_SPLIT_WHOLE(e)      ((uint16_t)(e) >> 10)
+#define ADC_CONVERT_SPLIT_DECIMAL(e)    ((uint16_t)(e) & 0x3FFU)
+
+extern const uint16_t adc_mv_table[ADC_CONVERT_TABLE_SIZE];
+
+#if ADC_CONVERT_SPLIT_LUT
+extern const uint16_t adc_mv_split_table[ADC_CONVERT_TABLE_SIZE];
+#endif
+
+#if ENABLE_CALIBRATION
+extern const uint16_t *adc_mv_lut;
+#define ADC_CONVERT_LUT adc_mv_lut
+#if ADC_CONVERT_SPLIT_LUT
+extern const uint16_t *adc_mv_split_lut;
+#define ADC_CONVERT_SPLIT_TABLE adc_mv_split_lut
+#endif
+#else
+#define ADC_CONVERT_LUT adc_mv_table
+#define ADC_CONVERT_SPLIT_TABLE adc_mv_split_table
+#endif
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Convert a 12-bit raw count to millivolts (table lookup)
+ * @param raw Raw ADC count (masked to ADC_MAX_VALUE)
+ * @return Voltage in millivolts
+ */
+static inline uint16_t adc_convert_raw_to_mv(uint16_t raw) {
+    return ADC_CONVERT_LUT[raw & ADC_MAX_VALUE];
+}
+
+/**
+ * @brief Convert a 12-bit raw count to whole volts and millivolts
+ * @param raw Raw ADC count (masked to ADC_MAX_VALUE)
+ * @param whole Receives volts
+ * @param decimal Receives millivolts (0-999)
+ */
+static inline void adc_convert_raw_to_split(uint16_t raw, uint32_t *whole, uint32_t *decimal) {
+#if ADC_CONVERT_SPLIT_LUT
+    uint16_t entry = ADC_CONVERT_SPLIT_TABLE[raw & ADC_MAX_VALUE];
+    *whole = ADC_CONVERT_SPLIT_WHOLE(entry);
+    *decimal = ADC_CONVERT_SPLIT_DECIMAL(entry);
+#else
+    uint16_t mv = ADC_CONVERT_LUT[raw & ADC_MAX_VALUE];
+    *whole = mv / 1000U;
+    *decimal = mv % 1000U;
+#endif
+}
+
+/**
+ * @brief Convert a value of any effective bit depth to millivolts
+ *
+ * 12-bit values are a direct lookup; 13-16 bit (oversampled) values
+ * interpolate linearly between the two neighbouring table entries.
+ *
+ * @param value Raw or oversampled count
+ * @param bits Effective resolution of value (12-16)
+ * @return Voltage in millivolts
+ */
+uint32_t adc_convert_value_to_mv(uint32_t value, uint8_t bits);
+
+/**
+ * @brief Convert a whole block to millivolts in one pass
+ *
+ * Intended for complete DMA half-buffers: the 12-bit path is a plain
+ * unrolled table walk with no per-sample branches.
+ *
+ * @param in Raw or oversampled samples
+ * @param out Millivolt results (may alias in)
+ * @param count Number of samples
+ * @param bits Effective resolution of the samples (12-16)
+ */
+void adc_convert_block_mv(const uint16_t *in, uint16_t *out, uint16_t count, uint8_t bits);
+
+#if ENABLE_CALIBRATION
+/**
+ * @brief Rebuild the RAM conversion table(s) and make them active
+ *
+ * entry(raw) = round(max(raw - offset, 0) * ADC_REFERENCE_MV * gain
+ *                    / (ADC_MAX_VALUE * 65536))
+ * Runs in about 4096 adds; call from the same context that converts
+ * (main loop), since the table is updated in place.
+ *
+ * @param gain_q16 Gain correction, Q16 (65536 = 1.0)
+ * @param offset_counts Zero offset subtracted before scaling
+ */
+void adc_convert_rebuild(uint32_t gain_q16, uint16_t offset_counts);
+
+/**
+ * @brief Switch back to the build-time flash table(s)
+ */
+void adc_convert_use_default(void);
+#endif
+
+#endif // __ADC_CONVERT_H__
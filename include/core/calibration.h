@@ -0,0 +1,84 @@
+#ifndef __CALIBRATION_H__
+#define __CALIBRATION_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   VREFINT Calibration Constants
+   ============================================
+   VREFINT (ADC1 channel 17) is a ~1.21 V bandgap. The factory converts
+   it once at VDDA = 3.3 V, 30 °C and stores the 12-bit result in system
+   memory, so the actual supply is
+
+     VDDA = CAL_VREFINT_CAL_MV * VREFINT_CAL / VREFINT_measured
+   ============================================ */
+#define CAL_VREFINT_CHANNEL     17
+#define CAL_VREFINT_CAL_ADDR    0x1FFF7A2AUL
+#define CAL_VREFINT_CAL_MV      3300U
+#define CAL_VREFINT_CAL         (*(const volatile uint16_t *)CAL_VREFINT_CAL_ADDR)
+
+/* ============================================
+   Calibration Status and Cache
+   ============================================ */
+typedef enum {
+    CAL_STATUS_OK = 0,
+    CAL_STATUS_TIMEOUT = 1,             // Injected conversion never finished
+    CAL_STATUS_OUT_OF_RANGE = 2         // Measured VDDA outside CAL_VDDA_MIN/MAX_MV
+} calibration_status_t;
+
+typedef struct {
+    uint16_t vrefint_raw;               // Last averaged VREFINT reading
+    uint16_t vrefint_cal;               // Factory reading (system memory)
+    uint16_t vdda_mv;                   // Derived supply / reference voltage
+    uint16_t offset_counts;             // Zero offset folded into the table
+    uint32_t gain_q16;                  // Gain folded into the table (65536 = 1.0)
+    uint32_t updates;                   // Measurements taken
+    uint32_t rebuilds;                  // Conversion table rebuilds
+    uint32_t rejected;                  // Measurements outside the valid range
+    bool valid;                         // Table reflects a measurement
+} calibration_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Enable VREFINT, set up the injected channel, run a first update
+ *
+ * Call after adc_init() (and adc_configure_scan()). VREFINT is read
+ * with a software-started injected conversion, so the regular
+ * timer/DMA stream keeps running; the 480-cycle sample time meets the
+ * VREFINT minimum sampling time.
+ *
+ * @return Calibration status of the first update
+ */
+calibration_status_t calibration_init(void);
+
+/**
+ * @brief Measure VREFINT and refresh the cached correction
+ *
+ * Averages CAL_VREFINT_SAMPLES injected conversions, derives the gain
+ * and rebuilds the conversion table when it moved by more than
+ * CAL_GAIN_HYSTERESIS_Q16. Main-loop context only (same context as the
+ * conversions that read the table). Busy-waits ~0.4 ms.
+ *
+ * @return Calibration status
+ */
+calibration_status_t calibration_update(void);
+
+/**
+ * @brief Set the zero offset applied on the next table rebuild
+ * @param offset_counts Counts subtracted before scaling
+ */
+void calibration_set_offset(uint16_t offset_counts);
+
+/**
+ * @brief Get the cached calibration
+ * @return Pointer to calibration data
+ */
+const calibration_t *calibration_get(void);
+
+#endif // __CALIBRATION_H__
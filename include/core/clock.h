@@ -0,0 +1,46 @@
+#ifndef __CLOCK_H__
+#define __CLOCK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Clock Status Enumeration
+   ============================================ */
+typedef enum {
+    CLOCK_STATUS_OK = 0,
+    CLOCK_STATUS_HSE_FAILED = 1,        // Crystal did not start, reverted to HSI
+    CLOCK_STATUS_PLL_FAILED = 2         // PLL did not lock, reverted to HSI
+} clock_status_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Configure the clock tree for CLOCK_PROFILE
+ *
+ * Sets voltage scaling, flash wait states, prefetch and ART caches,
+ * APB dividers and (for PLL profiles) HSE + PLL, then switches SYSCLK.
+ * Must run before any peripheral whose timing derives from the bus
+ * clocks (UART BRR, timer prescalers, ADC prescaler). Also restores
+ * the tree after Stop mode, which wakes on HSI with HSE and PLL off.
+ *
+ * On failure the tree is put back to plain 16 MHz HSI with all buses
+ * at /1. UART BRR, timer prescalers, ADC_CLOCK_FREQ and the SysTick
+ * tick are fixed at build time for SYSCLK_FREQ, so they are all wrong
+ * on HSI: callers must not go on running the application.
+ *
+ * @return Clock status
+ */
+clock_status_t clock_init(void);
+
+/**
+ * @brief Get the running system clock
+ * @return SYSCLK in Hz (SYSCLK_FREQ on success, 16 MHz after a failure)
+ */
+uint32_t clock_get_sysclk_hz(void);
+
+#endif // __CLOCK_H__
@@ -0,0 +1,167 @@
+#ifndef __DMA_H__
+#define __DMA_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   DMA Block Descriptor
+   ============================================ */
+typedef struct {
+    const volatile uint16_t *data;      // First sample of the finished half
+    uint16_t length;                    // Samples in the block
+    uint8_t half;                       // 0 = first half, 1 = second half
+    uint32_t sequence;                  // Block sequence number
+    uint64_t timestamp_us;              // Trigger time of the first frame (timebase)
+} dma_block_t;
+
+/* ============================================
+   Block Timestamp Source
+   ============================================ */
+typedef enum {
+    DMA_STAMP_TRIGGER = 0,              // TIM5 capture of the last frame's trigger
+    DMA_STAMP_TRIGGER_PAIRED,           // Capture sees every second trigger (both-edge ADC trigger)
+    DMA_STAMP_ISR                       // No trigger to capture: time of the DMA interrupt
+} dma_stamp_t;
+
+/**
+ * Spread of the block-to-block stamp interval. With a timer trigger
+ * the stamps are hardware captures, so any spread beyond the 1 us
+ * timebase step is the ISR reading a later trigger than the block's
+ * own; with DMA_STAMP_ISR it is the interrupt latency itself.
+ */
+typedef struct {
+    uint32_t intervals;                 // Intervals measured since dma_reset_jitter()
+    uint32_t interval_min_us;           // Shortest (0xFFFFFFFF before the first)
+    uint32_t interval_max_us;           // Longest
+} dma_jitter_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Initialize DMA2 Stream0 (Channel 0) for ADC1 transfers
+ *
+ * Peripheral-to-memory, 16-bit, circular, memory increment.
+ * Half-transfer and transfer-complete interrupts are enabled.
+ */
+void dma_init(void);
+
+/**
+ * @brief Point the stream at a ping-pong buffer
+ * @param buffer Buffer holding 2 * block_size samples
+ * @param block_size Samples per half (one block)
+ * @return true if successful
+ */
+bool dma_set_block_buffer(volatile uint16_t *buffer, uint16_t block_size);
+
+/**
+ * @brief Describe the frames in a block for first-sample timestamps
+ *
+ * The DMA ISR records the capture of the last frame's trigger; the
+ * first frame is (frames - 1) periods earlier. dma_set_block_buffer()
+ * defaults to one channel at 1 / ADC_SAMPLE_RATE_HZ.
+ *
+ * @param frames Trigger events per block (block size / scan length)
+ * @param frame_period_us Time between triggers
+ */
+void dma_set_block_timing(uint16_t frames, uint32_t frame_period_us);
+
+/**
+ * @brief Choose how finished blocks are timestamped
+ *
+ * DMA_STAMP_TRIGGER_PAIRED expects captures on every second trigger
+ * only; the ISR tells which edge ended the block from the capture's
+ * age, so it needs the conversion plus interrupt latency to stay below
+ * one frame period. DMA_STAMP_ISR counts back from the interrupt,
+ * i.e. it is late by the conversion time and the latency.
+ *
+ * @param source Stamp source (DMA_STAMP_TRIGGER after reset)
+ */
+void dma_set_stamp_source(dma_stamp_t source);
+
+/**
+ * @brief Copy the block interval spread measured so far
+ * @param out Destination
+ */
+void dma_get_jitter(dma_jitter_t *out);
+
+/**
+ * @brief Restart the interval measurement (e.g. after a rate change)
+ */
+void dma_reset_jitter(void);
+
+/**
+ * @brief Enable DMA stream
+ */
+void dma_enable(void);
+
+/**
+ * @brief Disable DMA stream
+ */
+void dma_disable(void);
+
+/**
+ * @brief Re-arm the stream at the start of the ping-pong buffer
+ *
+ * Used by the ADC overrun handler: the unfinished half is discarded
+ * and its samples are counted in dma_get_lost_samples(). Block
+ * sequence numbers keep counting, so consumers see a continuous
+ * sequence with a timestamp gap.
+ */
+void dma_restart(void);
+
+/**
+ * @brief Fetch the most recently finished half of the ping-pong buffer
+ *
+ * The returned block stays valid until DMA wraps back onto it,
+ * i.e. for one block period.
+ *
+ * @param block Pointer to dma_block_t
+ * @return true if a new block was ready
+ */
+bool dma_get_ready_block(dma_block_t *block);
+
+/**
+ * @brief Check if a block transfer is complete
+ * @return true if a finished block is waiting
+ */
+bool dma_is_transfer_complete(void);
+
+/**
+ * @brief Clear the transfer complete flag
+ */
+void dma_clear_transfer_complete_flag(void);
+
+/**
+ * @brief Get number of blocks overwritten before being fetched
+ * @return Overrun count
+ */
+uint32_t dma_get_overrun_count(void);
+
+/**
+ * @brief Get number of dma_restart() resynchronisations
+ * @return Restart count
+ */
+uint32_t dma_get_restart_count(void);
+
+/**
+ * @brief Get samples discarded by dma_restart()
+ * @return Lost sample count
+ */
+uint32_t dma_get_lost_samples(void);
+
+/**
+ * @brief Register a function called from the DMA ISR per finished block
+ *
+ * Runs in interrupt context: keep it to flagging work (e.g.
+ * scheduler_post_event()).
+ *
+ * @param callback Function to call, NULL to disable
+ */
+void dma_set_block_callback(void (*callback)(void));
+
+#endif // __DMA_H__
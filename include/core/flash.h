@@ -0,0 +1,81 @@
+#ifndef __FLASH_H__
+#define __FLASH_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Internal Flash Programming
+   ============================================
+   STM32F411CE, 512 KB single bank:
+
+     Sector 0-3   16 KB   0x08000000 - 0x0800FFFF
+     Sector 4     64 KB   0x08010000 - 0x0801FFFF
+     Sector 5-7  128 KB   0x08020000 - 0x0807FFFF
+
+   x32 parallelism (VDD 2.7-3.6 V). Any flash read, including
+   instruction fetch and vector fetch, stalls while an operation runs:
+   about 16 us per programmed word and 1-2 s per 128 KB sector erase
+   (RM0383, DS10314). Callers bound the stall by programming in small
+   batches; DMA keeps running meanwhile.
+   ============================================ */
+#define FLASH_SECTOR_COUNT 8
+
+typedef enum {
+    FLASH_STATUS_OK = 0,
+    FLASH_STATUS_BUSY,
+    FLASH_STATUS_ERROR,                 // Programming/erase error flag set
+    FLASH_STATUS_INVALID                // Bad sector, address or alignment
+} flash_status_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Get a sector's base address
+ * @param sector Sector number
+ * @return Address, 0 if out of range
+ */
+uint32_t flash_sector_address(uint8_t sector);
+
+/**
+ * @brief Get a sector's size
+ * @param sector Sector number
+ * @return Size in bytes, 0 if out of range
+ */
+uint32_t flash_sector_size(uint8_t sector);
+
+/**
+ * @brief Erase one sector (blocks for the whole erase)
+ * @param sector Sector number
+ * @return FLASH_STATUS_OK on success
+ */
+flash_status_t flash_erase_sector(uint8_t sector);
+
+/**
+ * @brief Program words (blocks ~16 us per word)
+ * @param address Word-aligned destination, previously erased
+ * @param data Words to write
+ * @param words Number of words
+ * @return FLASH_STATUS_OK on success
+ */
+flash_status_t flash_program(uint32_t address, const uint32_t *data, uint16_t words);
+
+/**
+ * @brief Check that a range reads as erased (all 0xFF)
+ * @param address Word-aligned start
+ * @param length Bytes (multiple of 4)
+ * @return true if every word is 0xFFFFFFFF
+ */
+bool flash_is_erased(uint32_t address, uint32_t length);
+
+/**
+ * @brief Get the end of the firmware image (text + initialised data)
+ * @return First flash address after the image
+ */
+uint32_t flash_image_end(void);
+
+#endif // __FLASH_H__
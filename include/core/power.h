@@ -0,0 +1,108 @@
+#ifndef __POWER_H__
+#define __POWER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Idle Policy
+   ============================================
+   RUN   - never halt the core; lowest wake latency, highest current
+   SLEEP - WFI (Sleep mode): only the core clock stops, so TIM2, ADC,
+           DMA, USART and SysTick keep running and any of their
+           interrupts wakes the core within a few cycles
+   STOP  - as SLEEP, but idle gaps of at least POWER_STOP_MIN_MS enter
+           Stop mode (all clocks off, regulator in low-power mode) with
+           the RTC wakeup timer (LSI) armed for the next task release.
+           Stop halts the sample timer and DMA, so it is only entered
+           while power_set_stop_allowed(true) says acquisition is paused
+   ============================================ */
+typedef enum {
+    POWER_RUN = POWER_POLICY_RUN,
+    POWER_SLEEP = POWER_POLICY_SLEEP,
+    POWER_STOP = POWER_POLICY_STOP
+} power_policy_t;
+
+/* ============================================
+   Sleep / Wake Statistics
+   ============================================ */
+typedef struct {
+    uint32_t sleeps;                    // WFI entries (Sleep mode)
+    uint32_t stops;                     // Stop mode entries
+    uint32_t early_wakes;               // Stops ended by an interrupt other than the RTC
+    uint32_t rx_wakes;                  // Early wakes from a UART RX start bit
+    uint64_t sleep_cycles;              // HCLK cycles spent halted in Sleep mode
+    uint32_t stop_ticks;                // Scheduler ticks spent in Stop mode
+    uint32_t wake_samples;              // SysTick wakes measured below
+    uint32_t wake_latency_min;          // Cycles from SysTick event to WFI return
+    uint32_t wake_latency_max;
+    uint64_t wake_latency_total;
+    uint32_t restore_cycles_max;        // Cycles to relock HSE/PLL after Stop
+} power_stats_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Enable the PWR clock and apply POWER_POLICY
+ *
+ * Call after clock_init(); starts the DWT cycle counter used for the
+ * clock restore measurement.
+ */
+void power_init(void);
+
+/**
+ * @brief Select the idle policy at runtime
+ *
+ * POWER_STOP brings up LSI and the RTC wakeup timer on first use.
+ *
+ * @param policy Idle policy
+ * @return false if LSI did not start (policy falls back to POWER_SLEEP)
+ */
+bool power_set_policy(power_policy_t policy);
+
+/**
+ * @brief Get the current idle policy
+ * @return Idle policy
+ */
+power_policy_t power_get_policy(void);
+
+/**
+ * @brief Allow or forbid Stop mode (POWER_STOP policy only)
+ *
+ * Stop freezes TIM2 and DMA, so keep this false while sampling; the
+ * "acq off" command sets it once the trigger and DMA are halted.
+ *
+ * @param allowed true while acquisition is paused
+ */
+void power_set_stop_allowed(bool allowed);
+
+/**
+ * @brief Halt the core until the next interrupt, per the idle policy
+ *
+ * Called by the scheduler with interrupts masked after it found no
+ * ready task; a pending interrupt still ends WFI, and its handler runs
+ * once the caller unmasks. Stop mode is entered only when idle_ticks
+ * covers POWER_STOP_MIN_MS, output goes to USART1 and it has finished
+ * sending, and no RX byte woke the core in the last POWER_RX_HOLDOFF_MS.
+ *
+ * @param idle_ticks Scheduler ticks until the next periodic release
+ * @return Scheduler ticks that elapsed with SysTick halted (Stop mode)
+ */
+uint32_t power_idle(uint32_t idle_ticks);
+
+/**
+ * @brief Copy the sleep/wake counters (interrupt-safe)
+ * @param stats Pointer to power_stats_t
+ */
+void power_get_stats(power_stats_t *stats);
+
+/**
+ * @brief Clear the sleep/wake counters
+ */
+void power_reset_stats(void);
+
+#endif // __POWER_H__
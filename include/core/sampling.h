@@ -0,0 +1,131 @@
+#ifndef __SAMPLING_H__
+#define __SAMPLING_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+#include "core/adc.h"
+#include "core/dma.h"
+
+/* ============================================
+   Sampling Modes
+   ============================================
+   A mode bundles what starts each ADC frame, the sample time and how
+   blocks are timestamped:
+
+   - tim2: TIM2 update, rate steps of TIM2_TICK_HZ, scan-list sample
+     times. The boot default; slow sensors.
+   - tim3: TIM3 update, rate steps of TIM3_TICK_HZ (16-bit counter, so
+     not below TIM3_TICK_HZ / 65536).
+   - ilv: TIM3 runs a 50% PWM on TRGO and the ADC converts on both
+     edges, so one timer period yields two evenly spaced frames. The
+     F411 has a single ADC, so this is the time-interleaved split of
+     one converter rather than a dual-ADC interleave: it doubles the
+     rate one timer can pace, not what the ADC can convert.
+   - cont: no timer; the ADC restarts the sequence as soon as it ends
+     (CONT) and circular DMA drains it. The rate is ADC_CLOCK_FREQ /
+     frame cycles and cannot be set; blocks are stamped at the DMA
+     interrupt.
+
+   Each mode declares a ceiling: the lower of what its timer can pace
+   and what the ADC can convert for the current scan list and the
+   mode's sample time. Triggers arriving while a frame is still
+   converting are ignored by the ADC, so rates above it lose frames
+   silently. The block interval spread (dma_jitter_t) is measured
+   while a mode runs and kept per mode.
+
+   The 1 MHz timestamps make frame periods whole microseconds; above
+   1 MHz and in cont mode they are rounded (sampling_get_period_us()).
+   ============================================ */
+typedef enum {
+    SAMPLING_TIM2 = SAMPLING_MODE_TIM2,
+    SAMPLING_TIM3 = SAMPLING_MODE_TIM3,
+    SAMPLING_INTERLEAVED = SAMPLING_MODE_INTERLEAVED,
+    SAMPLING_CONTINUOUS = SAMPLING_MODE_CONTINUOUS,
+    SAMPLING_MODE_COUNT
+} sampling_mode_t;
+
+typedef struct {
+    const char *name;                   // Command name ("tim2", "tim3", "ilv", "cont")
+    uint32_t step_hz;                   // Rates must divide this (0 = fixed rate)
+    uint32_t min_rate_hz;               // Slowest the counter can pace (0 = fixed rate)
+    uint32_t max_rate_hz;               // Declared ceiling, frames/s for the current scan list
+    uint32_t frame_cycles;              // ADCCLK cycles per frame at the mode's sample time
+    adc_sample_time_t sample_time;      // SMPR setting, ADC_SAMPLE_TIME_LIST = scan list's
+    dma_jitter_t jitter;                // Measured while the mode was (last) active
+} sampling_info_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Apply the boot mode at ADC_SAMPLE_RATE_HZ
+ *
+ * Call after timebase_init(), adc_init() and timer_init(); conversions
+ * start with sampling_start().
+ *
+ * @param mode Boot mode (SAMPLING_MODE)
+ * @return false if ADC_SAMPLE_RATE_HZ is not reachable in the mode
+ *         (tim2 is used instead)
+ */
+bool sampling_init(sampling_mode_t mode);
+
+/**
+ * @brief Switch mode (conversions stopped, see sampling_stop())
+ *
+ * The last timer rate is carried over, so switching to cont and back
+ * restores it. Restart DMA afterwards so frames stay aligned to the
+ * block buffer.
+ *
+ * @param mode New mode
+ * @return false if the current rate is not reachable in the new mode
+ *         (mode unchanged)
+ */
+bool sampling_set_mode(sampling_mode_t mode);
+
+/**
+ * @brief Get the active mode
+ * @return Mode
+ */
+sampling_mode_t sampling_get_mode(void);
+
+/**
+ * @brief Start conversions (trigger timer, or the ADC software start)
+ */
+void sampling_start(void);
+
+/**
+ * @brief Stop the trigger timer and the ADC
+ */
+void sampling_stop(void);
+
+/**
+ * @brief Change the frame rate of a timer-paced mode
+ * @param rate_hz Frames per second
+ * @return false in cont mode or if the rate is not reachable
+ */
+bool sampling_set_rate(uint32_t rate_hz);
+
+/**
+ * @brief Get the frame rate of the active mode
+ * @return Frames per second (cont: computed from the frame cycles)
+ */
+uint32_t sampling_get_rate(void);
+
+/**
+ * @brief Get the frame period of the active mode
+ * @return Microseconds, rounded to nearest, at least 1
+ */
+uint32_t sampling_get_period_us(void);
+
+/**
+ * @brief Describe a mode, with its ceiling for the current scan list
+ * @param mode Mode
+ * @param info Destination
+ * @return false if mode is out of range
+ */
+bool sampling_get_info(sampling_mode_t mode, sampling_info_t *info);
+
+#endif // __SAMPLING_H__
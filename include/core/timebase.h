@@ -0,0 +1,87 @@
+#ifndef __TIMEBASE_H__
+#define __TIMEBASE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Monotonic Microsecond Timebase
+   ============================================
+   TIM5 (32-bit) free-runs at TIMEBASE_TICK_HZ = 1 MHz and wraps every
+   ~71.6 minutes; its update interrupt counts wraps into the upper 32
+   bits. CC1 captures TRC = the trigger timer's TRGO (ITR0 = TIM2,
+   ITR1 = TIM3, selected with timebase_set_trigger_source()), so
+   TIM5->CCR1 always holds the exact time of the most recent sampling
+   trigger. The capture fires on rising TRGO edges only: with a
+   both-edge ADC trigger it sees every second conversion.
+
+   The 32-bit reads are a single register load and are meant for ISRs;
+   widen them with timebase_extend_us() outside the hot path.
+   ============================================ */
+
+#define TIMEBASE_ITR_TIM2 0U             // TIM5 ITR0 = TIM2 TRGO
+#define TIMEBASE_ITR_TIM3 1U             // TIM5 ITR1 = TIM3 TRGO
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Start TIM5 as the 1 MHz timebase and trigger capture
+ *
+ * Call after clock_init(). The wrap interrupt runs at
+ * INTERRUPT_PRIORITY, so no other handler can preempt it between
+ * clearing the flag and counting the wrap.
+ */
+void timebase_init(void);
+
+/**
+ * @brief Select the TRGO that CCR1 captures
+ * @param itr TIMEBASE_ITR_TIM2 or TIMEBASE_ITR_TIM3
+ */
+void timebase_set_trigger_source(uint8_t itr);
+
+#ifndef NATIVE_BUILD
+/**
+ * @brief Low 32 bits of the timebase (one register read)
+ * @return Microseconds, wraps at 2^32
+ */
+static inline uint32_t timebase_now_us32(void) {
+    return TIM5->CNT;
+}
+
+/**
+ * @brief Time of the most recent (captured) sampling trigger
+ * @return Low 32 bits of the timebase at the trigger edge
+ */
+static inline uint32_t timebase_last_trigger_us32(void) {
+    return TIM5->CCR1;
+}
+#endif
+
+/**
+ * @brief Read the full 64-bit timebase (any context)
+ *
+ * Accounts for a wrap whose interrupt has not run yet (interrupts
+ * masked, or called from an equal-priority handler).
+ *
+ * @return Microseconds since timebase_init()
+ */
+uint64_t timebase_now_us(void);
+
+/**
+ * @brief Read the timebase in milliseconds
+ * @return Milliseconds since timebase_init()
+ */
+uint64_t timebase_now_ms(void);
+
+/**
+ * @brief Widen a recent 32-bit stamp to 64 bits
+ * @param stamp_us Low 32 bits of a time less than 2^32 us in the past
+ * @return Full timestamp in microseconds
+ */
+uint64_t timebase_extend_us(uint32_t stamp_us);
+
+#endif // __TIMEBASE_H__
@@ -0,0 +1,83 @@
+#ifndef __TIMER_H__
+#define __TIMER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Trigger Timer Selection
+   ============================================
+   One timer at a time drives the ADC trigger through its TRGO:
+
+   - TIM2 (32-bit), TIM2_TICK_HZ counter clock, update event on TRGO
+   - TIM3 (16-bit), TIM3_TICK_HZ counter clock, update event on TRGO
+   - TIM3 paired: OC1REF on TRGO as a 50% PWM (MMS = 100), for an ADC
+     triggering on both edges - two evenly spaced triggers per period
+   - none: the ADC free-runs
+
+   TIM5 is the timebase (core/timebase.h) and TIM1/TIM4 are not wired
+   to any ADC trigger the firmware uses, so these are the only choices.
+   ============================================ */
+typedef enum {
+    TIMER_SOURCE_TIM2 = 0,
+    TIMER_SOURCE_TIM3,
+    TIMER_SOURCE_TIM3_PAIRED,
+    TIMER_SOURCE_NONE
+} timer_source_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Initialize TIM2 and TIM3, TIM2 selected as the ADC trigger
+ *
+ * Counter clock = TIM_APB1_CLK_FREQ / (TIMx_PRESCALER + 1) = TIMx_TICK_HZ,
+ * TIM2 update rate = TIM2_TICK_HZ / (TIM2_PERIOD + 1) = ADC_SAMPLE_RATE_HZ.
+ * TRGO is driven by the update event.
+ */
+void timer_init(void);
+
+/**
+ * @brief Select the trigger timer (stops both)
+ *
+ * The rate is not carried over: call timer_set_rate() before
+ * timer_start().
+ *
+ * @param source Timer and TRGO mode
+ */
+void timer_select(timer_source_t source);
+
+/**
+ * @brief Start the selected timer (begins triggering ADC conversions)
+ */
+void timer_start(void);
+
+/**
+ * @brief Stop the selected timer
+ */
+void timer_stop(void);
+
+/**
+ * @brief Change the trigger rate at runtime
+ *
+ * Only rates that divide the selected timer's tick exactly are
+ * accepted, so the sample period stays an exact number of ticks; TIM3
+ * additionally needs the period to fit its 16-bit counter. In paired
+ * mode rate_hz counts both edges. Restarts the current period (no
+ * TRGO is generated by the change itself).
+ *
+ * @param rate_hz New trigger rate (ADC triggers per second)
+ * @return false if the rate is not reachable (rate unchanged)
+ */
+bool timer_set_rate(uint32_t rate_hz);
+
+/**
+ * @brief Get the current trigger rate
+ * @return ADC triggers per second, 0 with no timer selected
+ */
+uint32_t timer_get_rate(void);
+
+#endif // __TIMER_H__
@@ -0,0 +1,200 @@
+#ifndef __UART_H__
+#define __UART_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   TX Routing
+   ============================================
+   Every producer writes to the one TX ring. By default DMA2 Stream7
+   drains it into USART1; UART_TX_ROUTE_EXTERNAL hands the ring to
+   another transport (USB CDC) which pulls spans with uart_tx_peek()
+   and uart_tx_consume() from its own interrupt and is kicked,
+   with interrupts masked, whenever new bytes are queued.
+   ============================================ */
+typedef enum {
+    UART_TX_ROUTE_USART = 0,            // DMA into USART1 (PA9)
+    UART_TX_ROUTE_EXTERNAL              // Drained by the registered transport
+} uart_tx_route_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Initialize USART1 (PA9 TX) and its DMA transmit stream
+ *
+ * TX is drained by DMA2 Stream7 (Channel 4) from a byte ring of
+ * UART_TX_BUFFER_SIZE bytes. RX (PA10) lands in a circular ring of
+ * UART_RX_BUFFER_SIZE bytes via DMA2 Stream5 (Channel 4).
+ */
+void uart_init(void);
+
+/**
+ * @brief Queue a string for transmission (non-blocking)
+ * @param str Null-terminated string
+ * @return true if the whole string was queued
+ */
+bool uart_send_string(const char *str);
+
+/**
+ * @brief Queue bytes for transmission (non-blocking)
+ *
+ * All-or-nothing: if the ring cannot hold the whole span, nothing is
+ * queued and the bytes are counted as dropped.
+ * Single producer: call from main-loop context only.
+ *
+ * @param data Pointer to bytes
+ * @param length Number of bytes
+ * @return true if queued
+ */
+bool uart_tx_write(const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Get free space in the TX ring
+ * @return Free bytes
+ */
+uint16_t uart_tx_free(void);
+
+/**
+ * @brief Get bytes queued but not yet handed to DMA or sent
+ * @return Pending bytes
+ */
+uint16_t uart_tx_pending(void);
+
+/**
+ * @brief Check if TX ring is drained and DMA is idle
+ * @return true if idle
+ */
+bool uart_tx_is_idle(void);
+
+/**
+ * @brief Block until every queued byte has left the shift register
+ */
+void uart_tx_flush(void);
+
+/**
+ * @brief Get number of bytes rejected because the ring was full
+ * @return Dropped byte count
+ */
+uint32_t uart_tx_get_dropped(void);
+
+/**
+ * @brief Get the most bytes ever queued at once (for sizing the ring)
+ * @return Peak ring occupancy in bytes
+ */
+uint16_t uart_tx_get_high_water(void);
+
+/**
+ * @brief Get the running count of bytes taken out of the ring
+ * @return Drained bytes, modulo 65536 (changes whenever the link makes progress)
+ */
+uint16_t uart_tx_get_drained(void);
+
+/**
+ * @brief Register a function called from the TX DMA ISR when the ring drains
+ *
+ * Runs in interrupt context once the last queued span has been handed
+ * off (the final byte may still be shifting out).
+ *
+ * @param callback Function to call, NULL to disable
+ */
+void uart_set_tx_idle_callback(void (*callback)(void));
+
+/**
+ * @brief Select which transport drains the TX ring
+ *
+ * Task context only. Switching away from the USART waits for the DMA
+ * span in flight, so no byte is sent twice or skipped.
+ *
+ * @param route UART_TX_ROUTE_USART or UART_TX_ROUTE_EXTERNAL
+ * @param kick Called with interrupts masked when bytes are queued
+ *             (required for UART_TX_ROUTE_EXTERNAL)
+ * @return false if kick is missing
+ */
+bool uart_tx_set_route(uart_tx_route_t route, void (*kick)(void));
+
+/**
+ * @brief Get the current TX route
+ * @return Route
+ */
+uart_tx_route_t uart_tx_get_route(void);
+
+/**
+ * @brief Get the oldest contiguous span of queued bytes (external drain)
+ *
+ * Call from the external transport's ISR or its kick.
+ *
+ * @param data Set to the first queued byte
+ * @return Span length (0 if the ring is empty)
+ */
+uint16_t uart_tx_peek(const uint8_t **data);
+
+/**
+ * @brief Release bytes taken by the external drain
+ * @param length Bytes returned by uart_tx_peek() that have been copied
+ */
+void uart_tx_consume(uint16_t length);
+
+/**
+ * @brief Get bytes received and not yet read
+ * @return Pending bytes (at most UART_RX_BUFFER_SIZE)
+ */
+uint16_t uart_rx_available(void);
+
+/**
+ * @brief Read received bytes (non-blocking)
+ *
+ * Bytes become visible at the end of each burst (line idle) or every
+ * half ring. If the reader fell a full ring behind, the overwritten
+ * bytes are skipped and counted in uart_rx_get_dropped().
+ * Single consumer: call from task context only.
+ *
+ * @param data Destination
+ * @param max_length Size of the destination
+ * @return Bytes read
+ */
+uint16_t uart_rx_read(uint8_t *data, uint16_t max_length);
+
+/**
+ * @brief Get bytes lost because the RX ring was not read in time
+ * @return Dropped byte count
+ */
+uint32_t uart_rx_get_dropped(void);
+
+/**
+ * @brief Get USART receive errors (overrun, framing, noise)
+ * @return Error count
+ */
+uint32_t uart_rx_get_errors(void);
+
+/**
+ * @brief Register a function called from the RX ISRs when bytes arrive
+ *
+ * Runs in interrupt context; post a scheduler event and parse in a
+ * task.
+ *
+ * @param callback Function to call, NULL to disable
+ */
+void uart_set_rx_callback(void (*callback)(void));
+
+/**
+ * @brief Send one character, busy-waiting on the USART (bypasses the ring)
+ *
+ * Flushes the ring first so output stays ordered. Intended for
+ * startup and fault paths where interrupts cannot be relied on.
+ *
+ * @param c Character to send
+ */
+void uart_send_char_blocking(char c);
+
+/**
+ * @brief Send a string, busy-waiting on the USART (bypasses the ring)
+ * @param str Null-terminated string
+ */
+void uart_send_string_blocking(const char *str);
+
+#endif // __UART_H__
@@ -0,0 +1,79 @@
+#ifndef __USB_CDC_H__
+#define __USB_CDC_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   USB OTG FS CDC-ACM Device
+   ============================================
+   Full-speed device on PA11 (DM) / PA12 (DP), enumerating as a
+   virtual COM port:
+
+     EP0        Control, 64 bytes
+     EP1 IN     Bulk, 64-byte packets: the output stream
+     EP1 OUT    Bulk, read and discarded (commands stay on USART1 RX)
+     EP2 IN     Interrupt, CDC notifications (never sent)
+
+   Streaming drains the UART TX ring (uart_tx_set_route) straight into
+   the EP1 TX FIFO: each transfer moves up to USB_CDC_TX_PACKETS packets
+   and the next one is loaded from the transfer-complete interrupt, so
+   the host always finds a queued packet while the ring has data. A
+   transfer ending on a full packet is followed by a zero-length packet
+   once the ring runs dry, so the host never holds back a read.
+
+   Needs the 48 MHz PLLQ clock (CLOCK_PROFILE_HSE_PLL_96MHZ). VBUS
+   sensing is off: PA9 is USART1 TX. Stop mode halts the core and must
+   not be allowed while USB is in use.
+   ============================================ */
+#define USB_CDC_PACKET_SIZE 64
+
+typedef struct {
+    uint32_t resets;                    // Bus resets seen
+    uint32_t transfers;                 // Bulk IN transfers completed
+    uint32_t tx_bytes;                  // Bytes moved into the EP1 FIFO
+    uint32_t discarded;                 // Output dropped while no host had the port open
+    uint32_t rx_bytes;                  // Bytes received (discarded) on EP1 OUT
+    uint32_t stalls;                    // Unsupported control requests
+} usb_cdc_stats_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Initialize OTG FS in device mode and connect to the bus
+ * @return false if SYSCLK is not running from the PLL (no 48 MHz clock)
+ */
+bool usb_cdc_init(void);
+
+/**
+ * @brief Route all output (the UART TX ring) to USB or back to USART1
+ *
+ * Task context only.
+ *
+ * @param enable true for USB, false for USART1
+ */
+void usb_cdc_set_output(bool enable);
+
+/**
+ * @brief Check that the host has configured the device
+ * @return true after SET_CONFIGURATION, until reset or suspend
+ */
+bool usb_cdc_is_configured(void);
+
+/**
+ * @brief Check that a host program has the port open
+ * @return true while DTR is asserted
+ */
+bool usb_cdc_is_open(void);
+
+/**
+ * @brief Get transport counters
+ * @param stats Destination
+ */
+void usb_cdc_get_stats(usb_cdc_stats_t *stats);
+
+#endif // __USB_CDC_H__
@@ -0,0 +1,57 @@
+#ifndef __WATCHDOG_H__
+#define __WATCHDOG_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Independent Watchdog (IWDG)
+   ============================================
+   Clocked from LSI (32 kHz nominal, 17-47 kHz across parts and
+   temperature), so a programmed timeout is only accurate to tens of
+   percent. Once started it cannot be stopped; it keeps counting in
+   Stop mode, and it is frozen while a debugger halts the core.
+   ============================================ */
+typedef enum {
+    RESET_CAUSE_UNKNOWN = 0,
+    RESET_CAUSE_POWER_ON,               // Power-on / power-down reset
+    RESET_CAUSE_BROWN_OUT,              // Supply dipped below the BOR level
+    RESET_CAUSE_PIN,                    // NRST pin (reset button, debugger)
+    RESET_CAUSE_SOFTWARE,               // NVIC_SystemReset()
+    RESET_CAUSE_IWDG,                   // Independent watchdog expired
+    RESET_CAUSE_WWDG,                   // Window watchdog
+    RESET_CAUSE_LOW_POWER               // Illegal Stop/Standby entry
+} reset_cause_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Decode and clear the RCC reset flags (call once, early at boot)
+ * @return Cause of the last reset
+ */
+reset_cause_t watchdog_read_reset_cause(void);
+
+/**
+ * @brief Get a short name for a reset cause
+ * @param cause Reset cause
+ * @return "por", "bor", "pin", "soft", "iwdg", "wwdg", "lpwr" or "?"
+ */
+const char *watchdog_reset_cause_name(reset_cause_t cause);
+
+/**
+ * @brief Start the IWDG
+ * @param timeout_ms Nominal timeout (1 ms to ~32 s)
+ * @return false if the timeout is out of range (watchdog not started)
+ */
+bool watchdog_init(uint32_t timeout_ms);
+
+/**
+ * @brief Reload the IWDG counter
+ */
+void watchdog_feed(void);
+
+#endif // __WATCHDOG_H__
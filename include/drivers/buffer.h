@@ -15,8 +15,17 @@ typedef struct {
     uint16_t size;                      // Buffer size
     uint16_t count;                     // Number of elements
     bool full;                          // Buffer full flag
+    uint32_t overwritten;               // Oldest elements lost to writes while full
 } ring_buffer_t;
 
+/* ============================================
+   Contiguous Span (zero-copy access)
+   ============================================ */
+typedef struct {
+    uint16_t *data;                     // First element of the span
+    uint16_t length;                    // Contiguous elements
+} ring_buffer_span_t;
+
 /* ============================================
    Public Function Declarations
    ============================================ */
@@ -32,6 +41,10 @@ bool ring_buffer_init(ring_buffer_t *rb, uint16_t *buffer, uint16_t size);
 
 /**
  * @brief Add element to buffer (write)
+ *
+ * When full, the oldest element is overwritten and counted in
+ * overwritten (see ring_buffer_get_overwritten()).
+ *
  * @param rb Pointer to ring_buffer_t
  * @param data Data to write
  * @return true if successful
@@ -76,6 +89,55 @@ bool ring_buffer_is_full(ring_buffer_t *rb);
  */
 uint16_t ring_buffer_count(ring_buffer_t *rb);
 
+/**
+ * @brief Get number of elements lost to ring_buffer_write() overwrites
+ * @param rb Pointer to ring_buffer_t
+ * @return Overwrite count since init
+ */
+uint32_t ring_buffer_get_overwritten(ring_buffer_t *rb);
+
+/**
+ * @brief Claim free space for in-place writing
+ *
+ * Free space is returned as up to two contiguous spans: spans[0] starts
+ * at head, spans[1] is the part wrapped to the start of the buffer
+ * (length 0 if none). Unlike ring_buffer_write(), claimed space never
+ * overwrites unread data. Fill the spans, then ring_buffer_commit_write().
+ *
+ * @param rb Pointer to ring_buffer_t
+ * @param spans Array of two spans to fill
+ * @return Total free elements (spans[0].length + spans[1].length)
+ */
+uint16_t ring_buffer_claim_write(ring_buffer_t *rb, ring_buffer_span_t spans[2]);
+
+/**
+ * @brief Publish elements written into claimed spans
+ * @param rb Pointer to ring_buffer_t
+ * @param count Elements written (<= free space)
+ * @return true if successful
+ */
+bool ring_buffer_commit_write(ring_buffer_t *rb, uint16_t count);
+
+/**
+ * @brief Peek at buffered data in place
+ *
+ * Data is returned as up to two contiguous spans: spans[0] starts at
+ * tail (oldest element), spans[1] is the wrapped remainder.
+ *
+ * @param rb Pointer to ring_buffer_t
+ * @param spans Array of two spans to fill
+ * @return Total buffered elements (spans[0].length + spans[1].length)
+ */
+uint16_t ring_buffer_peek_read(ring_buffer_t *rb, ring_buffer_span_t spans[2]);
+
+/**
+ * @brief Release elements consumed from peeked spans
+ * @param rb Pointer to ring_buffer_t
+ * @param count Elements consumed (<= count)
+ * @return true if successful
+ */
+bool ring_buffer_release_read(ring_buffer_t *rb, uint16_t count);
+
 /**
  * @brief Clear/Reset buffer
  * @param rb Pointer to ring_buffer_t
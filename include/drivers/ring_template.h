@@ -0,0 +1,134 @@
+#ifndef __RING_TEMPLATE_H__
+#define __RING_TEMPLATE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "stm32f4xx.h"
+
+/* ============================================
+   Typed Ring Buffer Generator
+   ============================================
+   RING_DECLARE(name, type, capacity, index_type) generates:
+
+     name_t                 struct with inline storage
+     name_init(r)           reset indices
+     name_push(r, &item)    copy in, false (and dropped++) when full
+     name_push_overwrite    copy in, drop oldest when full
+     name_pop(r, &item)     copy out, false when empty
+     name_peek(r, offset)   pointer to element offset from oldest, or NULL
+     name_back(r)           pointer to newest element, or NULL
+     name_count / name_free / name_is_empty / name_is_full / name_clear
+
+   capacity is a compile-time power of two, so wrapping is a mask and
+   every call is a static inline the compiler can fold and unroll.
+   index_type (uint8_t, uint16_t or uint32_t) sets the maximum capacity:
+   indices run free, so capacity may be at most half the index range.
+
+   push/pop follow the same single-producer/single-consumer ownership as
+   spsc_ring_t (producer writes head, consumer writes tail) with a full
+   barrier between data and index. push_overwrite and clear touch both
+   indices and are for single-context use only.
+
+   Library-only: no firmware module instantiates it. The trigger's
+   pre-trigger history is sized at run time for the scan length,
+   lives in the memory arena and moves whole blocks in spans, so it
+   stays on ring_buffer_t. Use this where a queue of a fixed type and
+   compile-time depth is wanted; the bench and test_ring_template
+   cover it.
+
+   Example:
+     RING_DECLARE(reading_ring, adc_reading_t, 64, uint16_t)
+     static reading_ring_t readings;
+     reading_ring_push(&readings, &reading);
+   ============================================ */
+
+#define RING_BARRIER() __DMB()
+
+#define RING_DECLARE(name, type, capacity, index_type)                                  \
+    _Static_assert(((capacity) & ((capacity) - 1)) == 0 && (capacity) > 0,              \
+                   #name ": capacity must be a power of two");                          \
+    _Static_assert((uint64_t)(capacity) <= ((uint64_t)(index_type)~(index_type)0 / 2 + 1), \
+                   #name ": capacity too large for index type");                        \
+                                                                                        \
+    typedef struct {                                                                    \
+        type buffer[capacity];                                                          \
+        volatile index_type head;                                                       \
+        volatile index_type tail;                                                       \
+        volatile uint32_t dropped;                                                      \
+    } name##_t;                                                                         \
+                                                                                        \
+    static inline void name##_init(name##_t *r) {                                       \
+        r->head = 0;                                                                    \
+        r->tail = 0;                                                                    \
+        r->dropped = 0;                                                                 \
+    }                                                                                   \
+                                                                                        \
+    static inline index_type name##_count(const name##_t *r) {                          \
+        return (index_type)(r->head - r->tail);                                         \
+    }                                                                                   \
+                                                                                        \
+    static inline index_type name##_free(const name##_t *r) {                           \
+        return (index_type)((capacity) - name##_count(r));                              \
+    }                                                                                   \
+                                                                                        \
+    static inline bool name##_is_empty(const name##_t *r) {                             \
+        return r->head == r->tail;                                                      \
+    }                                                                                   \
+                                                                                        \
+    static inline bool name##_is_full(const name##_t *r) {                              \
+        return name##_count(r) == (index_type)(capacity);                               \
+    }                                                                                   \
+                                                                                        \
+    static inline bool name##_push(name##_t *r, const type *item) {                     \
+        index_type head = r->head;                                                      \
+        if ((index_type)(head - r->tail) == (index_type)(capacity)) {                   \
+            r->dropped++;                                                               \
+            return false;                                                               \
+        }                                                                               \
+        r->buffer[head & ((capacity) - 1)] = *item;                                     \
+        RING_BARRIER();                                                                 \
+        r->head = (index_type)(head + 1);                                               \
+        return true;                                                                    \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_push_overwrite(name##_t *r, const type *item) {           \
+        if (name##_is_full(r)) {                                                        \
+            r->tail = (index_type)(r->tail + 1);                                        \
+            r->dropped++;                                                               \
+        }                                                                               \
+        r->buffer[r->head & ((capacity) - 1)] = *item;                                  \
+        r->head = (index_type)(r->head + 1);                                            \
+    }                                                                                   \
+                                                                                        \
+    static inline bool name##_pop(name##_t *r, type *item) {                            \
+        index_type tail = r->tail;                                                      \
+        if (r->head == tail) {                                                          \
+            return false;                                                               \
+        }                                                                               \
+        RING_BARRIER();                                                                 \
+        *item = r->buffer[tail & ((capacity) - 1)];                                     \
+        RING_BARRIER();                                                                 \
+        r->tail = (index_type)(tail + 1);                                               \
+        return true;                                                                    \
+    }                                                                                   \
+                                                                                        \
+    static inline type *name##_peek(name##_t *r, index_type offset) {                   \
+        if (offset >= name##_count(r)) {                                                \
+            return NULL;                                                                \
+        }                                                                               \
+        return &r->buffer[(index_type)(r->tail + offset) & ((capacity) - 1)];           \
+    }                                                                                   \
+                                                                                        \
+    static inline type *name##_back(name##_t *r) {                                      \
+        if (name##_is_empty(r)) {                                                       \
+            return NULL;                                                                \
+        }                                                                               \
+        return &r->buffer[(index_type)(r->head - 1) & ((capacity) - 1)];                \
+    }                                                                                   \
+                                                                                        \
+    static inline void name##_clear(name##_t *r) {                                      \
+        r->tail = r->head;                                                              \
+    }
+
+#endif // __RING_TEMPLATE_H__
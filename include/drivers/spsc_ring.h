@@ -0,0 +1,107 @@
+#ifndef __SPSC_RING_H__
+#define __SPSC_RING_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   Lock-Free SPSC Ring Buffer Structure
+   ============================================
+   Single producer (e.g. DMA ISR) / single consumer (e.g. main loop).
+   head is written only by the producer, tail only by the consumer;
+   both run free and are masked on access, so no shared count, no
+   full flag and no critical sections. Size must be a power of two.
+   When full, writes fail (the producer never touches tail) and the
+   rejected elements are counted in dropped. Per-element and bulk
+   calls do not re-validate rb; it must have been initialized.
+
+   Library-only: the DMA path hands blocks over in place
+   (dma_get_ready_block()), since a queued descriptor would outlive
+   the half-buffer it points at. Use this ring where a producer must
+   be buffered from a slower consumer.
+   ============================================ */
+typedef struct {
+    uint16_t *buffer;                   // Data buffer
+    uint32_t mask;                      // size - 1
+    volatile uint32_t head;             // Write index (producer-owned)
+    volatile uint32_t tail;             // Read index (consumer-owned)
+    volatile uint32_t dropped;          // Rejected writes (producer-owned)
+} spsc_ring_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Initialize SPSC ring
+ * @param rb Pointer to spsc_ring_t
+ * @param buffer Pointer to data buffer
+ * @param size Buffer size in elements (power of two)
+ * @return true if successful
+ */
+bool spsc_ring_init(spsc_ring_t *rb, uint16_t *buffer, uint32_t size);
+
+/**
+ * @brief Write one element (producer side)
+ * @param rb Pointer to spsc_ring_t
+ * @param data Data to write
+ * @return true if written, false if full
+ */
+bool spsc_ring_write(spsc_ring_t *rb, uint16_t data);
+
+/**
+ * @brief Read one element (consumer side)
+ * @param rb Pointer to spsc_ring_t
+ * @param data Pointer to data location
+ * @return true if read, false if empty
+ */
+bool spsc_ring_read(spsc_ring_t *rb, uint16_t *data);
+
+/**
+ * @brief Write up to count elements with at most two memcpy spans
+ * @param rb Pointer to spsc_ring_t
+ * @param data Source elements
+ * @param count Number of elements
+ * @return Elements written (the rest are counted as dropped)
+ */
+uint32_t spsc_ring_write_n(spsc_ring_t *rb, const uint16_t *data, uint32_t count);
+
+/**
+ * @brief Read up to count elements with at most two memcpy spans
+ * @param rb Pointer to spsc_ring_t
+ * @param data Destination
+ * @param count Maximum elements to read
+ * @return Elements read
+ */
+uint32_t spsc_ring_read_n(spsc_ring_t *rb, uint16_t *data, uint32_t count);
+
+/**
+ * @brief Get number of elements available to the consumer
+ * @param rb Pointer to spsc_ring_t
+ * @return Element count
+ */
+uint32_t spsc_ring_count(const spsc_ring_t *rb);
+
+/**
+ * @brief Get free space available to the producer
+ * @param rb Pointer to spsc_ring_t
+ * @return Free elements
+ */
+uint32_t spsc_ring_free(const spsc_ring_t *rb);
+
+/**
+ * @brief Check if ring is empty
+ * @param rb Pointer to spsc_ring_t
+ * @return true if empty
+ */
+bool spsc_ring_is_empty(const spsc_ring_t *rb);
+
+/**
+ * @brief Check if ring is full
+ * @param rb Pointer to spsc_ring_t
+ * @return true if full
+ */
+bool spsc_ring_is_full(const spsc_ring_t *rb);
+
+#endif // __SPSC_RING_H__
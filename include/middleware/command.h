@@ -0,0 +1,94 @@
+#ifndef __COMMAND_H__
+#define __COMMAND_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   Command Interface
+   ============================================
+   Line-oriented text commands over the UART RX ring:
+
+     <name> [arg ...]\r\n   ->   handler output, then "OK" or "ERR <reason>"
+
+   command_poll() runs in task context and only drains what has already
+   arrived; it never waits for input, so a half-typed line simply stays
+   buffered until the next poll. Tokens are separated by spaces or tabs;
+   names are matched exactly. Lines longer than COMMAND_LINE_LENGTH are
+   discarded whole. "help" is built in and lists the table; it only
+   queues lines that fit in the TX ring, and the listing (and the lines
+   typed after it) continue on a later poll once the ring has drained.
+   ============================================ */
+
+typedef enum {
+    COMMAND_OK = 0,
+    COMMAND_ERROR_USAGE,                // Wrong number or form of arguments
+    COMMAND_ERROR_RANGE,                // Argument out of range
+    COMMAND_ERROR_UNSUPPORTED,          // Feature compiled out
+    COMMAND_ERROR_UNKNOWN               // No such command (parser only)
+} command_status_t;
+
+typedef command_status_t (*command_handler_t)(uint8_t argc, char *argv[]);
+
+typedef struct {
+    const char *name;
+    command_handler_t handler;          // argv[0] is the command name
+    const char *usage;                  // One-line help text
+} command_t;
+
+typedef struct {
+    uint32_t lines;                     // Lines executed (including errors)
+    uint32_t errors;                    // Lines answered with ERR
+    uint32_t overlong;                  // Lines discarded for length
+} command_stats_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Install the command table and clear the line buffer
+ * @param table Commands (must stay valid)
+ * @param count Number of entries
+ */
+void command_init(const command_t *table, uint8_t count);
+
+/**
+ * @brief Execute every complete line received so far
+ *
+ * Call from a task released by uart_set_rx_callback().
+ */
+void command_poll(void);
+
+/**
+ * @brief Check whether "help" output is waiting for TX space
+ *
+ * Release the command task again once the ring drains (TX-idle event).
+ *
+ * @return true while the listing is incomplete
+ */
+bool command_output_pending(void);
+
+/**
+ * @brief Parse and execute one line (modified in place)
+ * @param line Null-terminated line without terminator
+ * @return Handler result, COMMAND_ERROR_UNKNOWN, or COMMAND_OK for a blank line
+ */
+command_status_t command_execute(char *line);
+
+/**
+ * @brief Get parser counters
+ * @param stats Destination
+ */
+void command_get_stats(command_stats_t *stats);
+
+/**
+ * @brief Parse an unsigned decimal argument
+ * @param text Argument
+ * @param value Destination
+ * @return false if text is empty, not a number, or above UINT32_MAX
+ */
+bool command_parse_u32(const char *text, uint32_t *value);
+
+#endif // __COMMAND_H__
@@ -0,0 +1,68 @@
+#ifndef __FILTER_H__
+#define __FILTER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   FIR Decimator Structure
+   ============================================
+   Low-pass FIR followed by keep-1-of-N decimation, computed only at
+   the kept output positions. Coefficients are Q15 (sum 32768 = unity
+   DC gain). On Cortex-M4 the dot product uses SMLAD (two 16x16 MACs
+   per instruction); elsewhere a plain C loop gives identical results.
+   ============================================ */
+typedef struct {
+    int16_t coeffs[FILTER_MAX_TAPS];    // Time-reversed, zero-padded to even length
+    int16_t state[FILTER_MAX_TAPS + FILTER_MAX_INPUT];  // History + current chunk
+    uint16_t num_taps;                  // Padded (even) tap count
+    uint16_t decimation;                // Keep 1 output per N inputs
+    uint16_t phase;                     // Input samples until the next output
+} fir_decimator_t;
+
+/* ============================================
+   Default Coefficient Table
+   ============================================ */
+#define FILTER_LOWPASS_D4_TAPS 32
+extern const int16_t filter_lowpass_d4[FILTER_LOWPASS_D4_TAPS];   // Cutoff 0.1 fs, Hamming
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Initialize a FIR decimator
+ * @param f Pointer to fir_decimator_t
+ * @param coeffs Q15 coefficients in natural order (h[0] first)
+ * @param num_taps Number of coefficients (<= FILTER_MAX_TAPS)
+ * @param decimation Decimation factor (>= 1)
+ * @return true if successful
+ */
+bool fir_decimator_init(fir_decimator_t *f, const int16_t *coeffs, uint16_t num_taps,
+                        uint16_t decimation);
+
+/**
+ * @brief Clear filter history (coefficients are kept)
+ * @param f Pointer to fir_decimator_t
+ */
+void fir_decimator_reset(fir_decimator_t *f);
+
+/**
+ * @brief Filter and decimate a block of 12-bit samples
+ *
+ * Strides allow filtering one channel straight out of an interleaved
+ * scan block and writing back into an interleaved output block.
+ *
+ * @param f Pointer to fir_decimator_t
+ * @param in First input sample
+ * @param count Input samples (per channel)
+ * @param in_stride Elements between consecutive input samples
+ * @param out First output slot
+ * @param out_stride Elements between consecutive output slots
+ * @return Number of outputs written (about count / decimation)
+ */
+uint16_t fir_decimator_process(fir_decimator_t *f, const uint16_t *in, uint16_t count,
+                               uint16_t in_stride, uint16_t *out, uint16_t out_stride);
+
+#endif // __FILTER_H__
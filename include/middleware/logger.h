@@ -0,0 +1,175 @@
+#ifndef __LOGGER_H__
+#define __LOGGER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   Flash Data Logger
+   ============================================
+   Output blocks are encoded as ordinary binary sample frames
+   (telemetry_encode_samples, own sequence counter) and appended to a
+   RAM staging page. Full pages are queued and logger_service() programs
+   LOG_PROGRAM_WORDS words per call into the next page slot of the
+   LOG_FLASH_SECTORS sector region, payload first and header last, so a
+   page is valid only once completely written. A frame never straddles
+   two pages.
+
+   The region is circular: before the write slot enters a sector, that
+   sector (holding the oldest pages) must be erased. The F411 has a
+   single bank and every flash read, including instruction fetch,
+   stalls for the 1-2 s of a 128 KB erase, so erases only run while
+   sampling is stopped: at boot and while logger_set_erase_allowed()
+   says acquisition is paused, logger_service() keeps the next sector
+   erased ahead. If sampling outruns the erased space, the writer waits
+   at the sector boundary (erase_pending) and new frames are dropped
+   until the next erase window. LOG_ERASE_WHILE_SAMPLING restores the
+   erase-on-demand stall for builds that never pause.
+
+   Page layout (LOG_PAGE_SIZE bytes, little-endian):
+     word 0  LOGGER_PAGE_MAGIC
+     word 1  Page sequence (1, 2, ...; survives reset)
+     word 2  Erase count of the page's sector
+     word 3  First frame timestamp, us, lower 32 bits
+     word 4  First frame timestamp, us, upper 32 bits
+     word 5  Payload bytes (15:0), CRC-16 of bytes 0-21 (31:16)
+     ...     Whole telemetry frames, then erased (0xFF) padding
+
+   logger_init() scans the page headers into a RAM index (sequence and
+   first timestamp per slot), resumes after the newest page and serves
+   seeks by time from that index. Readback streams the stored frames
+   from memory-mapped flash, one whole frame per uart_tx_write(), so
+   it interleaves cleanly with live telemetry.
+   ============================================ */
+#define LOGGER_PAGE_MAGIC        0x31474F4CUL   // "LOG1"
+#define LOGGER_PAGE_HEADER_SIZE  24
+#define LOGGER_SECTOR_SIZE       0x20000UL      // Sectors 5-7
+#define LOGGER_PAGES_PER_SECTOR  (LOGGER_SECTOR_SIZE / LOG_PAGE_SIZE)
+#define LOGGER_PAGE_COUNT        (LOG_FLASH_SECTORS * LOGGER_PAGES_PER_SECTOR)
+
+typedef struct {
+    bool enabled;                       // false if the region overlaps the image
+    bool reading;                       // Readback in progress
+    uint32_t pages_stored;              // Valid pages in the region
+    uint32_t oldest_sequence;           // 0 if the log is empty
+    uint32_t newest_sequence;
+    uint32_t pages_written;             // Pages programmed since boot
+    uint32_t frames_logged;             // Frames staged since boot
+    uint32_t frames_dropped;            // Frames lost to full staging
+    uint32_t flash_errors;              // Erase/program failures
+    uint32_t erases;                    // Sector erases since boot
+    uint32_t erase_us_max;              // Longest erase stall
+    bool erase_pending;                 // Writer waits for an erase window
+    uint32_t program_us_max;            // Longest logger_service() program stall
+    uint32_t erase_count[LOG_FLASH_SECTORS];    // Erases per sector, carried in page headers
+} logger_stats_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Scan the log region, rebuild the page index and resume writing
+ * @return false if the log region overlaps the firmware image
+ */
+bool logger_init(void);
+
+/**
+ * @brief Stage an output block (never touches flash)
+ * @param samples Samples (interleaved frames when channels > 1)
+ * @param count Number of samples
+ * @param channels Channels per frame
+ * @param timestamp_us Timestamp of the first frame
+ * @param period_us Frame period, for timestamps of split frames
+ * @return false if any frame was dropped because staging was full
+ */
+bool logger_write_samples(const uint16_t *samples, uint16_t count, uint8_t channels,
+                          uint64_t timestamp_us, uint32_t period_us);
+
+/**
+ * @brief Close the staging page now (it is programmed by logger_service)
+ */
+void logger_flush(void);
+
+/**
+ * @brief Program one batch and advance any readback by what the TX
+ *        ring takes; while erases are allowed, erase the next sector
+ *        ahead of the writer first
+ *
+ * Call periodically (LOG_SERVICE_INTERVAL_MS) from task context.
+ */
+void logger_service(void);
+
+/**
+ * @brief Continue a readback only (no programming or erase)
+ *
+ * For the UART TX-idle event: queues stored frames while they fit.
+ */
+void logger_service_readback(void);
+
+/**
+ * @brief Allow or forbid sector erases from logger_service()
+ *
+ * An erase stalls every flash fetch for 1-2 s, so keep this false
+ * while sampling (always true with LOG_ERASE_WHILE_SAMPLING).
+ *
+ * @param allowed true while acquisition is paused
+ */
+void logger_set_erase_allowed(bool allowed);
+
+/**
+ * @brief Erase the sector the writer enters next, if it holds pages
+ *
+ * Blocks for the erase; call only with sampling stopped (boot). Does
+ * nothing during a readback or when the writer is inside the only
+ * sector of the region.
+ *
+ * @return false on a flash error
+ */
+bool logger_erase_ahead(void);
+
+/**
+ * @brief Start streaming stored pages, oldest first
+ * @param first_sequence First page to send (clamped to the oldest stored)
+ * @return false if the log is empty or disabled
+ */
+bool logger_start_readback(uint32_t first_sequence);
+
+/**
+ * @brief Abort a readback
+ */
+void logger_stop_readback(void);
+
+/**
+ * @brief Find the page holding a point in time
+ * @param time_ms Timebase time in milliseconds
+ * @param sequence Page whose first frame is the last at or before time_ms
+ *                 (the oldest page if time_ms predates the log)
+ * @return false if the log is empty
+ */
+bool logger_seek_ms(uint64_t time_ms, uint32_t *sequence);
+
+/**
+ * @brief Erase the whole log region (blocks for every sector erase)
+ *
+ * Refused unless logger_set_erase_allowed(true) is in effect (or
+ * LOG_ERASE_WHILE_SAMPLING), like the erase-ahead in logger_service().
+ *
+ * @return false on a flash error or while erases are not allowed
+ */
+bool logger_erase_all(void);
+
+/**
+ * @brief Get the number of full staging pages waiting to be programmed
+ * @return 0 to LOG_STAGING_PAGES
+ */
+uint16_t logger_get_backlog(void);
+
+/**
+ * @brief Get logger counters
+ * @param stats Destination
+ */
+void logger_get_stats(logger_stats_t *stats);
+
+#endif // __LOGGER_H__
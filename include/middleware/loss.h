@@ -0,0 +1,75 @@
+#ifndef __LOSS_H__
+#define __LOSS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   Loss Accounting
+   ============================================
+   Collects every place the pipeline can lose data into one set of
+   monotonic counters:
+
+     ADC OVR -> DMA resync -> block consumer -> UART TX
+
+   The sources keep their own ISR-side counters; loss_poll() runs in
+   task context, folds them in and raises one error_report() event per
+   source that lost data since the previous poll. The trigger's
+   pre-trigger history ring overwrites its oldest frames by design, so
+   ring overwrites are not counted as loss.
+   ============================================ */
+
+typedef enum {
+    LOSS_ADC_OVERRUN = 0,               // ADC OVR events (>= 1 conversion each)
+    LOSS_DMA_SAMPLES,                   // Samples discarded by DMA resynchronisation
+    LOSS_BLOCKS_MISSED,                 // Block sequence gaps seen by the consumer
+    LOSS_TX_BYTES,                      // Bytes rejected by the UART TX ring
+    LOSS_TX_FRAMES,                     // Telemetry frames rejected
+    LOSS_COUNTER_COUNT
+} loss_counter_t;
+
+typedef struct {
+    uint32_t counters[LOSS_COUNTER_COUNT];
+    uint32_t blocks_seen;               // Blocks handed to loss_track_block()
+    uint32_t tx_high_water;             // Peak UART TX ring occupancy (bytes)
+} loss_report_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Clear counters; baseline the source counters
+ */
+void loss_init(void);
+
+/**
+ * @brief Check a consumed block's sequence number for gaps
+ * @param sequence dma_block_t.sequence of the block being processed
+ */
+void loss_track_block(uint32_t sequence);
+
+/**
+ * @brief Fold in the source counters and report new losses
+ *
+ * Call periodically from task context.
+ *
+ * @return true if anything was lost since the previous poll
+ */
+bool loss_poll(void);
+
+/**
+ * @brief Copy the counters as of the last loss_poll()
+ * @param report Pointer to loss_report_t
+ */
+void loss_get(loss_report_t *report);
+
+/**
+ * @brief Get a counter's short name
+ * @param counter Counter id
+ * @return Name, or "?" if out of range
+ */
+const char *loss_get_name(loss_counter_t counter);
+
+#endif // __LOSS_H__
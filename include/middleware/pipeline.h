@@ -0,0 +1,163 @@
+#ifndef __PIPELINE_H__
+#define __PIPELINE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Static Block Pipeline
+   ============================================
+   A pipeline is a fixed chain of stage functions, each taking a whole
+   block. The chain is declared at compile time as an X-macro list of
+   X(id, name, run, backlog) entries:
+
+     #define APP_PIPELINE(X) \
+         X(ACQUIRE, "acquire", stage_acquire, NULL) \
+         APP_FILTER(X) \
+         X(ENCODE,  "encode",  stage_encode,  uart_tx_pending)
+
+   where APP_FILTER(X) expands to an entry or to nothing depending on a
+   feature flag. PIPELINE_DEFINE(app_pipeline, APP_PIPELINE) then emits
+   a PIPELINE_STAGE_<id> enum, the counters, the descriptor
+   app_pipeline and app_pipeline_run(), which calls the stages directly
+   in list order. A stage left out of the list costs no code, no
+   counters and no call.
+
+   A stage either passes the block on, pointing it at its own
+   fixed-size output buffer if it transforms the data, or returns false
+   to end the block there (it was consumed, or produced no frames).
+   `backlog` is NULL or a uint16_t (*)(void) sampled after every run:
+   work queued behind the stage, in the stage's own unit (pages, bytes).
+
+   Counters are updated and read from task context only.
+   ============================================ */
+typedef struct {
+    const uint16_t *data;               // Interleaved frames
+    uint16_t count;                     // Samples (frames * channels)
+    uint8_t channels;                   // Samples per frame
+    uint32_t sequence;                  // DMA block sequence number
+    uint64_t timestamp_us;              // Trigger time of the first input frame
+    uint32_t period_us;                 // Frame period of `data`
+} pipeline_block_t;
+
+typedef bool (*pipeline_stage_fn)(pipeline_block_t *block);
+typedef uint16_t (*pipeline_backlog_fn)(void);
+
+typedef struct {
+    uint32_t runs;                      // Blocks entering the stage
+    uint32_t passed;                    // Blocks handed to the next stage
+    uint32_t samples;                   // Samples entering the stage
+    uint32_t cycles_max;                // Longest run (CYCCNT cycles)
+    uint64_t cycles_total;              // Sum of all runs
+    uint16_t backlog;                   // Queued work after the last run
+    uint16_t backlog_max;               // Largest backlog seen
+} pipeline_stage_stats_t;
+
+typedef struct {
+    const char *const *names;           // Stage names in chain order
+    pipeline_stage_stats_t *stats;      // One entry per stage
+    uint8_t count;                      // Number of stages
+} pipeline_t;
+
+/* ============================================
+   Definition Macros
+   ============================================ */
+#define PIPELINE_STAGE_ID(id, name, run, backlog)      PIPELINE_STAGE_##id,
+#define PIPELINE_STAGE_NAME(id, name, run, backlog)    name,
+#define PIPELINE_STAGE_CALL(id, name, run, backlog) \
+    if (!pipeline_stage_run(&stats[PIPELINE_STAGE_##id], (run), (backlog), block)) { \
+        return false; \
+    }
+
+/**
+ * Define a pipeline from an X-macro stage list (one per translation unit)
+ *
+ * `pipe##_run(block)` returns true if the block went through every stage.
+ */
+#define PIPELINE_DEFINE(pipe, STAGES)                                           \
+    enum { STAGES(PIPELINE_STAGE_ID) PIPELINE_STAGE_COUNT };                    \
+    static const char *const pipe##_names[PIPELINE_STAGE_COUNT] = {             \
+        STAGES(PIPELINE_STAGE_NAME)                                             \
+    };                                                                          \
+    static pipeline_stage_stats_t pipe##_stats[PIPELINE_STAGE_COUNT];           \
+    static const pipeline_t pipe = {pipe##_names, pipe##_stats, PIPELINE_STAGE_COUNT}; \
+    static bool pipe##_run(pipeline_block_t *block) {                           \
+        pipeline_stage_stats_t *stats = pipe##_stats;                           \
+        STAGES(PIPELINE_STAGE_CALL)                                             \
+        return true;                                                            \
+    }
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Run one stage and update its counters
+ *
+ * Inlined into the generated run function, so `run` and `backlog` are
+ * direct calls (and a NULL backlog no call at all).
+ *
+ * @param stats Counters of the stage
+ * @param run Stage function
+ * @param backlog Backlog probe, or NULL
+ * @param block Block in flight
+ * @return Whatever the stage returned
+ */
+static inline bool pipeline_stage_run(pipeline_stage_stats_t *stats, pipeline_stage_fn run,
+                                      pipeline_backlog_fn backlog, pipeline_block_t *block) {
+    uint16_t samples = block->count;
+    uint32_t start = DWT->CYCCNT;
+    bool pass = run(block);
+    uint32_t cycles = DWT->CYCCNT - start;
+
+    stats->runs++;
+    stats->samples += samples;
+    stats->cycles_total += cycles;
+    if (cycles > stats->cycles_max) {
+        stats->cycles_max = cycles;
+    }
+    if (pass) {
+        stats->passed++;
+    }
+    if (backlog != NULL) {
+        stats->backlog = backlog();
+        if (stats->backlog > stats->backlog_max) {
+            stats->backlog_max = stats->backlog;
+        }
+    }
+    return pass;
+}
+
+/**
+ * @brief Start the cycle counter and clear all stage counters
+ * @param pipe Pipeline descriptor
+ */
+void pipeline_init(const pipeline_t *pipe);
+
+/**
+ * @brief Clear all stage counters
+ * @param pipe Pipeline descriptor
+ */
+void pipeline_reset(const pipeline_t *pipe);
+
+/**
+ * @brief Copy a stage's counters
+ * @param pipe Pipeline descriptor
+ * @param stage Stage index (chain order)
+ * @param out Destination
+ * @return false if stage is out of range
+ */
+bool pipeline_get_stats(const pipeline_t *pipe, uint8_t stage, pipeline_stage_stats_t *out);
+
+/**
+ * @brief Get a stage's name
+ * @param pipe Pipeline descriptor
+ * @param stage Stage index (chain order)
+ * @return Name, "?" if stage is out of range
+ */
+const char *pipeline_get_name(const pipeline_t *pipe, uint8_t stage);
+
+#endif // __PIPELINE_H__
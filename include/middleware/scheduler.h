@@ -0,0 +1,104 @@
+#ifndef __SCHEDULER_H__
+#define __SCHEDULER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   Cooperative Multi-Rate Scheduler
+   ============================================
+   Run-to-completion tasks dispatched from the main context in priority
+   order (0 = highest). After every task the scan restarts from the top,
+   so a ready high-priority task never waits behind more than one
+   lower-priority task. A task is released by:
+
+   - its period (period_ms > 0), counted in SysTick ticks, and/or
+   - scheduler_post_event() (ISR-safe), e.g. DMA block ready.
+
+   An overrun is a release that arrives while the previous one has not
+   run yet (the release is merged, not queued). With nothing ready the
+   core sleeps in WFI until the next interrupt.
+   ============================================ */
+#define SCHEDULER_INVALID_TASK 0xFF
+#define SCHEDULER_MS_TO_TICKS(ms) (((uint32_t)(ms) * SCHED_TICK_HZ + 999U) / 1000U)
+
+typedef void (*scheduler_task_fn)(void);
+
+typedef struct {
+    const char *name;                   // Display name
+    uint32_t period_ticks;              // 0 = event-only
+    uint8_t priority;                   // 0 = highest
+    uint32_t runs;                      // Completed runs
+    uint32_t overruns;                  // Releases merged into a pending one
+    uint32_t max_latency_ticks;         // Worst release-to-start delay
+} scheduler_task_info_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Clear the task table and start SysTick at SCHED_TICK_HZ
+ */
+void scheduler_init(void);
+
+/**
+ * @brief Register a task
+ *
+ * Call before scheduler_run(). The first periodic release is one
+ * period after registration.
+ *
+ * @param name Display name
+ * @param run Task function (must return; no blocking waits)
+ * @param period_ms Release period, 0 for event-only tasks
+ * @param priority 0 = highest; equal priorities run in registration order
+ * @return Task id, SCHEDULER_INVALID_TASK if the table is full
+ */
+uint8_t scheduler_add_task(const char *name, scheduler_task_fn run, uint32_t period_ms,
+                           uint8_t priority);
+
+/**
+ * @brief Release an event task (callable from any ISR)
+ * @param id Task id from scheduler_add_task()
+ */
+void scheduler_post_event(uint8_t id);
+
+/**
+ * @brief Run the highest-priority ready task, if any
+ * @return true if a task ran
+ */
+bool scheduler_run_once(void);
+
+/**
+ * @brief Dispatch forever, idling in power_idle() when no task is ready
+ */
+void scheduler_run(void);
+
+/**
+ * @brief Get the SysTick tick count since scheduler_init()
+ * @return Ticks (1 / SCHED_TICK_HZ s, wraps at 2^32)
+ */
+uint32_t scheduler_get_ticks(void);
+
+/**
+ * @brief Get the task whose run function is executing
+ * @return Task id, SCHEDULER_INVALID_TASK outside of a task (idle, startup, ISR-only)
+ */
+uint8_t scheduler_get_running_task(void);
+
+/**
+ * @brief Get the number of registered tasks
+ * @return Task count
+ */
+uint8_t scheduler_get_task_count(void);
+
+/**
+ * @brief Copy a task's configuration and counters
+ * @param id Task id
+ * @param info Pointer to scheduler_task_info_t
+ * @return true if id is valid
+ */
+bool scheduler_get_task_info(uint8_t id, scheduler_task_info_t *info);
+
+#endif // __SCHEDULER_H__
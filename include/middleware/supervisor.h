@@ -0,0 +1,112 @@
+#ifndef __SUPERVISOR_H__
+#define __SUPERVISOR_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+#include "core/watchdog.h"
+
+/* ============================================
+   Pipeline Supervisor
+   ============================================
+   Each pipeline stage checks in when it makes progress:
+
+     DMA      block interrupt (acquisition is running)
+     PROCESS  block task finished a block
+     TX       output ring drained bytes, or is empty
+
+   supervisor_service() feeds the IWDG only while every supervised
+   stage has checked in within its deadline (twice its expected
+   period plus WATCHDOG_STAGE_MARGIN_MS). The first stage found late
+   latches a stall: the snapshot below is written to retained RAM, the
+   watchdog is no longer fed and resets the MCU WATCHDOG_TIMEOUT_MS
+   later. A hang that stops supervisor_service() itself (fault handler,
+   interrupt storm, blocked task) starves the watchdog the same way,
+   just without a snapshot.
+
+   The retained block lives in .noinit, which the startup code does
+   not clear: it survives every reset except power loss, and is
+   checked by magic and checksum at boot.
+   ============================================ */
+#define SUPERVISOR_RETAINED_MAGIC 0x52505553UL     // "SUPR"
+
+typedef enum {
+    SUPERVISOR_STAGE_DMA = 0,
+    SUPERVISOR_STAGE_PROCESS,
+    SUPERVISOR_STAGE_TX,
+    SUPERVISOR_STAGE_COUNT
+} supervisor_stage_t;
+
+typedef struct {
+    uint32_t uptime_ms;                 // Time since boot when the stall was latched
+    uint32_t late_mask;                 // Bit per stage past its deadline
+    uint32_t age_ms[SUPERVISOR_STAGE_COUNT];    // Time since each stage's last check-in
+    uint32_t last_error;                // error_get_last() code at the time
+} supervisor_stall_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t boots;                     // Resets since power-on, this boot included
+    uint32_t watchdog_resets;           // IWDG resets among them
+    uint32_t reset_cause;               // reset_cause_t of this boot
+    uint32_t prior_uptime_s;            // Uptime of the earlier boots since power-on
+    uint32_t uptime_ms;                 // Uptime of this boot, as of the last service
+    uint32_t stall_valid;               // stall below was latched by the previous boot
+    supervisor_stall_t stall;
+    uint32_t checksum;
+} supervisor_retained_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Decode the reset cause, update the retained block and start
+ *        the IWDG (WATCHDOG_TIMEOUT_MS)
+ *
+ * Every stage starts unsupervised; supervisor_set_period() enables it.
+ */
+void supervisor_init(void);
+
+/**
+ * @brief Set the expected check-in period of a stage
+ * @param stage Stage
+ * @param period_us Longest normal gap between check-ins, 0 = unsupervised
+ */
+void supervisor_set_period(supervisor_stage_t stage, uint32_t period_us);
+
+/**
+ * @brief Record progress of a stage (any context, one store)
+ * @param stage Stage
+ */
+void supervisor_checkin(supervisor_stage_t stage);
+
+/**
+ * @brief Check the deadlines; feed the watchdog or latch a stall
+ *
+ * Call every WATCHDOG_SERVICE_MS from task context.
+ *
+ * @return false once a stall has been latched
+ */
+bool supervisor_service(void);
+
+/**
+ * @brief Get the retained boot record
+ * @return Retained block (stall is from the previous boot if stall_valid)
+ */
+const supervisor_retained_t *supervisor_get_retained(void);
+
+/**
+ * @brief Get total uptime since power-on across watchdog and other resets
+ * @return Seconds
+ */
+uint32_t supervisor_get_uptime_s(void);
+
+/**
+ * @brief Get a stage name
+ * @param stage Stage
+ * @return "dma", "process" or "tx"
+ */
+const char *supervisor_stage_name(supervisor_stage_t stage);
+
+#endif // __SUPERVISOR_H__
@@ -0,0 +1,185 @@
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   Binary Frame Layout (little-endian)
+   ============================================
+   Offset  Size  Field
+   0       2     Sync (0xA5, 0x5A)
+   2       1     Frame type
+   3       1     Channels per sample frame
+   4       2     Sequence counter
+   6       2     Sample count
+   8       4     Timestamp of first sample (us)
+   12      2     CRC-16/CCITT-FALSE over bytes 2..11 + payload
+   14      n     Payload (by frame type):
+                 0x01: 12-bit samples packed two per 3 bytes
+                 0x02: 1 byte effective bits, then 16-bit LE samples
+                 0x03: count 32-bit LE status words (channels = 0)
+                 0x04: count 32-bit LE capture header words; channels
+                       and timestamp describe the capture that follows
+   ============================================ */
+#define TELEMETRY_SYNC_0            0xA5
+#define TELEMETRY_SYNC_1            0x5A
+#define TELEMETRY_HEADER_SIZE       14
+#define TELEMETRY_PACKED_SIZE(n)    (((n) * 3U + 1U) / 2U)
+#define TELEMETRY_WIDE_SIZE(n)      (1U + (n) * 2U)
+#define TELEMETRY_STATUS_SIZE(n)    ((n) * 4U)
+#define TELEMETRY_STATUS_MAX_WORDS  16
+#define TELEMETRY_FRAME_MAX_SIZE    (TELEMETRY_HEADER_SIZE + TELEMETRY_WIDE_SIZE(TELEMETRY_MAX_SAMPLES))
+
+/* ============================================
+   Output Format / Frame Type Enumerations
+   ============================================ */
+typedef enum {
+    TELEMETRY_OUTPUT_ASCII = TELEMETRY_FORMAT_ASCII,
+    TELEMETRY_OUTPUT_BINARY = TELEMETRY_FORMAT_BINARY,
+    TELEMETRY_OUTPUT_SUMMARY = TELEMETRY_FORMAT_SUMMARY
+} telemetry_format_t;
+
+typedef enum {
+    TELEMETRY_FRAME_SAMPLES = 0x01,     // Packed 12-bit sample block
+    TELEMETRY_FRAME_SAMPLES16 = 0x02,   // 16-bit samples (oversampled, 13-16 bits)
+    TELEMETRY_FRAME_STATUS = 0x03,      // Counter words (loss accounting)
+    TELEMETRY_FRAME_CAPTURE = 0x04      // Triggered capture header words
+} telemetry_frame_type_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Initialize telemetry (format = TELEMETRY_FORMAT, sequence = 0)
+ */
+void telemetry_init(void);
+
+/**
+ * @brief Select output format at runtime
+ * @param format ASCII, binary or summary (statistics only)
+ */
+void telemetry_set_format(telemetry_format_t format);
+
+/**
+ * @brief Get current output format
+ * @return Output format
+ */
+telemetry_format_t telemetry_get_format(void);
+
+/**
+ * @brief Set the time between consecutive frames of samples
+ *
+ * Used to advance timestamps when a block is split over several
+ * frames. Defaults to 1 / ADC_SAMPLE_RATE_HZ; multiply by the
+ * decimation factor when sending filtered data.
+ *
+ * @param period_us Sample period in microseconds
+ */
+void telemetry_set_sample_period_us(uint32_t period_us);
+
+/**
+ * @brief Set the effective bit depth of sent samples
+ *
+ * 12 (default) selects packed 12-bit frames; 13-16 selects 16-bit
+ * frames that carry the bit depth in their payload.
+ *
+ * @param bits Effective resolution
+ */
+void telemetry_set_sample_bits(uint8_t bits);
+
+/**
+ * @brief Encode a sample block into a binary frame
+ *
+ * Frame type follows telemetry_set_sample_bits().
+ *
+ * @param out Destination (at least TELEMETRY_FRAME_MAX_SIZE bytes)
+ * @param sequence Frame sequence number
+ * @param timestamp_us Timestamp of first sample
+ * @param channels Channels interleaved in the samples
+ * @param samples Samples
+ * @param count Number of samples (<= TELEMETRY_MAX_SAMPLES)
+ * @return Frame length in bytes, 0 on invalid parameters
+ */
+uint16_t telemetry_encode_samples(uint8_t *out, uint16_t sequence, uint32_t timestamp_us,
+                                  uint8_t channels, const uint16_t *samples, uint16_t count);
+
+/**
+ * @brief Encode a sample block and queue it on the UART
+ *
+ * Blocks larger than TELEMETRY_MAX_SAMPLES are split over several
+ * frames. Every frame consumes one sequence number, including frames
+ * dropped because the TX ring was full, so the host sees the gap.
+ *
+ * @param samples Samples (interleaved frames when channels > 1)
+ * @param count Number of samples
+ * @param channels Channels per frame
+ * @param timestamp_us Timestamp of first sample
+ * @return true if every frame was queued
+ */
+bool telemetry_send_samples(const uint16_t *samples, uint16_t count, uint8_t channels,
+                            uint32_t timestamp_us);
+
+/**
+ * @brief Encode counter words into a status frame
+ * @param out Destination (at least TELEMETRY_FRAME_MAX_SIZE bytes)
+ * @param sequence Frame sequence number
+ * @param timestamp_us Time the counters were sampled
+ * @param values Counter words
+ * @param count Number of words (<= TELEMETRY_STATUS_MAX_WORDS)
+ * @return Frame length in bytes, 0 on invalid parameters
+ */
+uint16_t telemetry_encode_status(uint8_t *out, uint16_t sequence, uint32_t timestamp_us,
+                                 const uint32_t *values, uint8_t count);
+
+/**
+ * @brief Encode counter words and queue them on the UART
+ *
+ * Shares the sequence counter with sample frames.
+ *
+ * @param values Counter words
+ * @param count Number of words (<= TELEMETRY_STATUS_MAX_WORDS)
+ * @param timestamp_us Time the counters were sampled
+ * @return true if queued
+ */
+bool telemetry_send_status(const uint32_t *values, uint8_t count, uint32_t timestamp_us);
+
+/**
+ * @brief Queue a capture header frame ahead of a triggered capture
+ *
+ * The sample frames that follow use the normal sample frame types.
+ *
+ * @param values Header words (see middleware/trigger.h)
+ * @param count Number of words (<= TELEMETRY_STATUS_MAX_WORDS)
+ * @param channels Channels per scan frame in the capture
+ * @param timestamp_us Low 32 bits of the trigger time
+ * @return true if queued
+ */
+bool telemetry_send_capture(const uint32_t *values, uint8_t count, uint8_t channels,
+                            uint32_t timestamp_us);
+
+/**
+ * @brief Get the total length of an encoded frame from its header
+ * @param header First TELEMETRY_HEADER_SIZE bytes of a frame
+ * @return Frame length in bytes, 0 if the sync word or type is invalid
+ */
+uint16_t telemetry_frame_length(const uint8_t *header);
+
+/**
+ * @brief Get frames discarded because the UART TX ring was full
+ * @return Dropped frame count
+ */
+uint32_t telemetry_get_dropped_frames(void);
+
+/**
+ * @brief Compute CRC-16/CCITT-FALSE (poly 0x1021)
+ * @param crc Initial value (0xFFFF for a new CRC)
+ * @param data Pointer to bytes
+ * @param length Number of bytes
+ * @return Updated CRC
+ */
+uint16_t telemetry_crc16(uint16_t crc, const uint8_t *data, uint16_t length);
+
+#endif // __TELEMETRY_H__
@@ -0,0 +1,152 @@
+#ifndef __TRIGGER_H__
+#define __TRIGGER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   Triggered Capture
+   ============================================
+   Every output block is appended to a pre-trigger history ring
+   (ring_buffer_t, oldest frames dropped first) and, while armed,
+   scanned frame by frame on one channel. When the condition fires the
+   newest pre_frames of history are frozen into the capture buffer, the
+   next post_frames are appended from the following blocks, and the
+   window is then drained by trigger_ship() at whatever rate the UART TX
+   ring accepts. Acquisition never waits on the link.
+
+     ARMED --fire--> CAPTURING --post full--> READY --shipped--> ARMED/IDLE
+
+   Thresholds are in output counts (after filter/oversampling).
+
+   Binary capture header (TELEMETRY_FRAME_CAPTURE, timestamp = low 32
+   bits of the trigger time):
+     word 0  Capture number
+     word 1  Frames ahead of the trigger
+     word 2  Frames from the trigger on
+     word 3  Frame period (us)
+     word 4  Trigger time, upper 32 bits
+   ============================================ */
+#define TRIGGER_HEADER_WORDS 5
+
+typedef enum {
+    TRIGGER_LEVEL_ABOVE = 0,            // Sample >= level
+    TRIGGER_LEVEL_BELOW,                // Sample <= level
+    TRIGGER_EDGE_RISING,                // Crosses up through level (after level - hysteresis)
+    TRIGGER_EDGE_FALLING,               // Crosses down through level (after level + hysteresis)
+    TRIGGER_EDGE_BOTH,                  // Leaves the level +/- hysteresis band on either side
+    TRIGGER_WINDOW_OUTSIDE,             // Sample < low or > high
+    TRIGGER_WINDOW_INSIDE               // low <= sample <= high
+} trigger_type_t;
+
+typedef enum {
+    TRIGGER_IDLE = 0,                   // Disarmed; history still fills
+    TRIGGER_ARMED,                      // Evaluating every frame
+    TRIGGER_CAPTURING,                  // Fired, collecting post-trigger frames
+    TRIGGER_READY                       // Window frozen, shipping
+} trigger_state_t;
+
+typedef struct {
+    trigger_type_t type;
+    uint8_t channel;                    // Scan channel evaluated
+    uint16_t level;                     // Level / edge threshold
+    uint16_t hysteresis;                // Edge re-arm distance
+    uint16_t window_low;                // Window bounds (inclusive)
+    uint16_t window_high;
+    uint16_t pre_frames;                // <= TRIGGER_PRE_FRAMES
+    uint16_t post_frames;               // 1..TRIGGER_POST_FRAMES
+    bool auto_rearm;                    // Re-arm after shipping (else go idle)
+} trigger_config_t;
+
+typedef struct {
+    uint32_t captures;                  // Triggers fired
+    uint32_t shipped;                   // Captures fully sent
+    uint32_t ship_stalls;               // trigger_ship() calls that waited for TX space
+} trigger_stats_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Reset history and load the default configuration
+ *
+ * Default: rising edge through TRIGGER_LEVEL on channel 0, full
+ * TRIGGER_PRE_FRAMES / TRIGGER_POST_FRAMES window, auto re-arm, armed.
+ */
+void trigger_init(void);
+
+/**
+ * @brief Replace the trigger configuration and re-arm
+ *
+ * Drops a capture in progress; leaves the history intact.
+ *
+ * @param config New configuration
+ * @return false if a field is out of range (configuration unchanged)
+ */
+bool trigger_configure(const trigger_config_t *config);
+
+/**
+ * @brief Copy the current configuration
+ * @param config Destination
+ */
+void trigger_get_config(trigger_config_t *config);
+
+/**
+ * @brief Arm the trigger (no effect while capturing or shipping)
+ */
+void trigger_arm(void);
+
+/**
+ * @brief Disarm; a capture in progress is dropped
+ */
+void trigger_disarm(void);
+
+/**
+ * @brief Fire on the first frame of the next block, whatever its value
+ */
+void trigger_force(void);
+
+/**
+ * @brief Get the capture state
+ * @return Current state
+ */
+trigger_state_t trigger_get_state(void);
+
+/**
+ * @brief Feed one output block (task context)
+ *
+ * Appends the block to the history and, depending on state, evaluates
+ * it or appends it to the capture. A change in channel count clears
+ * the history and drops any capture in progress.
+ *
+ * @param samples Interleaved samples
+ * @param count Number of samples (whole frames)
+ * @param channels Channels per frame
+ * @param timestamp_us Time of the block's first frame
+ * @param period_us Time between frames
+ * @return true if the trigger fired in this block
+ */
+bool trigger_process_block(const uint16_t *samples, uint16_t count, uint8_t channels,
+                           uint64_t timestamp_us, uint32_t period_us);
+
+/**
+ * @brief Send the next part of a frozen capture
+ *
+ * Sends only what fits in the UART TX ring, so nothing is dropped; call
+ * periodically (TRIGGER_SHIP_INTERVAL_MS). Binary format sends a
+ * capture header frame and then sample frames; other formats send
+ * "Capture" header/end lines around one "Cap" line per frame.
+ *
+ * @return true if more of the capture remains to be sent
+ */
+bool trigger_ship(void);
+
+/**
+ * @brief Get capture counters
+ * @param stats Destination
+ */
+void trigger_get_stats(trigger_stats_t *stats);
+
+#endif // __TRIGGER_H__
@@ -0,0 +1,47 @@
+#ifndef __NATIVE_SHIM_H__
+#define __NATIVE_SHIM_H__
+
+#include <stdint.h>
+#include "utils/error.h"
+
+/* ============================================
+   Host UART Sink
+   ============================================
+   src/native/uart_shim.c implements core/uart.h on the host: queued
+   bytes are counted (and folded into a checksum) instead of being
+   sent, and the ring never fills.
+   ============================================ */
+
+/**
+ * @brief Get bytes accepted by uart_tx_write() since uart_init()
+ * @return Byte count
+ */
+uint64_t native_uart_get_bytes(void);
+
+/**
+ * @brief Get a running checksum of every accepted byte
+ * @return Checksum (FNV-1a)
+ */
+uint32_t native_uart_get_checksum(void);
+
+/* ============================================
+   Host Test Hooks
+   ============================================
+   Reach states a unit test cannot wait for: a later time without
+   sleeping, and a counter close to saturation without 2^32 reports.
+   ============================================ */
+
+/**
+ * @brief Move the host timebase forward (timebase_now_us() and friends)
+ * @param us Microseconds to add
+ */
+void native_timebase_advance_us(uint64_t us);
+
+/**
+ * @brief Preload the report counter of one code (utils/error.c)
+ * @param code Error code (codes sharing a counter share the value)
+ * @param count New counter value
+ */
+void native_error_set_code_count(error_code_t code, uint32_t count);
+
+#endif // __NATIVE_SHIM_H__
@@ -0,0 +1,48 @@
+#ifndef __NATIVE_STM32F4XX_H__
+#define __NATIVE_STM32F4XX_H__
+
+#include <stdint.h>
+
+/* ============================================
+   Host HAL Shim ([env:native])
+   ============================================
+   Stands in for the CMSIS device header when the hardware-free modules
+   (buffers, conversion, oversampling, statistics, filter, telemetry,
+   error) are built for the host. Only the core intrinsics those
+   modules use are provided; peripheral registers are deliberately
+   absent so a module that touches hardware fails to compile instead of
+   misbehaving.
+   ============================================ */
+#define NATIVE_BUILD 1
+
+#define __DMB()             __sync_synchronize()
+#define __DSB()             __sync_synchronize()
+#define __ISB()             __sync_synchronize()
+#define __NOP()             ((void)0)
+#define __WFI()             ((void)0)
+#define __disable_irq()     ((void)0)
+#define __enable_irq()      ((void)0)
+
+static inline uint32_t __get_PRIMASK(void) {
+    return 0;
+}
+
+static inline void __set_PRIMASK(uint32_t primask) {
+    (void)primask;
+}
+
+// Exclusive access: the host build is single-threaded, so a store-exclusive never fails
+static inline uint32_t __LDREXW(volatile uint32_t *addr) {
+    return *addr;
+}
+
+static inline uint32_t __STREXW(uint32_t value, volatile uint32_t *addr) {
+    *addr = value;
+    return 0;
+}
+
+#define __CLREX()           ((void)0)
+
+extern uint32_t SystemCoreClock;
+
+#endif // __NATIVE_STM32F4XX_H__
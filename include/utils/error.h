@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "config.h"
 
 /* ============================================
    Error Codes
@@ -17,19 +18,48 @@ typedef enum {
     ERROR_BUFFER_UNDERFLOW = 0x20,
     ERROR_INVALID_PARAM = 0x40,
     ERROR_TIMEOUT = 0x80,
+    ERROR_ADC_OVERRUN = 0x81,           // ADC OVR, conversions lost
+    ERROR_SAMPLES_DROPPED = 0x82,       // DMA block discarded or never processed
+    ERROR_TX_DROPPED = 0x83,            // UART TX ring full, output discarded
+    ERROR_FLASH_FAILED = 0x84,          // Flash erase/program error
+    ERROR_USB_FAILED = 0x85,            // USB OTG FS unavailable (no 48 MHz clock)
+    ERROR_STALL = 0x86,                 // Pipeline stage missed its watchdog deadline
+    ERROR_FAULT = 0x87,                 // Reset by the fault handler (utils/fault.h)
+    ERROR_NO_MEMORY = 0x88,             // Arena refused an allocation (utils/memory.h)
     ERROR_UNKNOWN = 0xFF
 } error_code_t;
 
 /* ============================================
-   Error Status Structure
+   Event Log
+   ============================================
+   error_report() is safe from any interrupt priority and from task
+   context at once, and costs a few dozen cycles:
+
+   - Every call bumps a saturating counter for its code and the total.
+   - An event is logged only if its code has not been logged within
+     ERROR_RATE_LIMIT_MS (critical events always are); the others are
+     counted as suppressed, so a flood of one code cannot push the rest
+     out of the log.
+   - A logged event reserves the next log sequence with LDREX/STREX and
+     fills slot (sequence % ERROR_LOG_SIZE). The slot's stamp is
+     written last, so error_read() never returns a half-written or
+     overwritten event.
    ============================================ */
 typedef struct {
     error_code_t code;                  // Error code
-    uint32_t timestamp_ms;              // When error occurred
     uint8_t severity;                   // 0=Info, 1=Warning, 2=Error, 3=Critical
+    uint32_t sequence;                  // Log position (0, 1, ...)
+    uint32_t count;                     // Reports of this code so far, this one included
+    uint64_t timestamp_us;              // When it was reported (timebase us)
     const char *message;                // Error message
 } error_t;
 
+typedef struct {
+    error_code_t code;
+    uint32_t count;                     // Reports (saturating)
+    uint32_t suppressed;                // Reports not logged because of the rate limit
+} error_code_stats_t;
+
 /* ============================================
    Public Function Declarations
    ============================================ */
@@ -40,21 +70,35 @@ typedef struct {
 void error_init(void);
 
 /**
- * @brief Report error
+ * @brief Report error (any context, including ISRs)
  * @param code Error code
  * @param severity Error severity (0-3)
- * @param message Error message
+ * @param message Error message (must stay valid: only the pointer is kept)
  */
 void error_report(error_code_t code, uint8_t severity, const char *message);
 
 /**
- * @brief Get last error
- * @return Last error structure
+ * @brief Get last logged error
+ * @return Last error structure (code ERROR_NONE if nothing is logged)
  */
 error_t error_get_last(void);
 
 /**
- * @brief Clear error history
+ * @brief Read one logged event
+ * @param sequence Log position, below error_get_sequence()
+ * @param entry Destination
+ * @return false if the slot has been overwritten or is being written
+ */
+bool error_read(uint32_t sequence, error_t *entry);
+
+/**
+ * @brief Get the sequence the next logged event will take
+ * @return Events logged since boot
+ */
+uint32_t error_get_sequence(void);
+
+/**
+ * @brief Clear counters, critical flag and log (task context)
  */
 void error_clear(void);
 
@@ -66,9 +110,24 @@ bool error_is_critical(void);
 
 /**
  * @brief Get error count
- * @return Number of errors recorded
+ * @return Number of errors reported, logged or not (saturating)
+ */
+uint32_t error_get_count(void);
+
+/**
+ * @brief Get the report count of one code
+ * @param code Error code
+ * @return Reports since boot or error_clear() (saturating)
+ */
+uint32_t error_get_code_count(error_code_t code);
+
+/**
+ * @brief Walk the per-code counters
+ * @param index Counter index, 0 up
+ * @param stats Destination
+ * @return false past the last counter
  */
-uint16_t error_get_count(void);
+bool error_get_code_stats(uint8_t index, error_code_stats_t *stats);
 
 /**
  * @brief Get error message string
@@ -0,0 +1,87 @@
+#ifndef __FAULT_H__
+#define __FAULT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Fault Capture
+   ============================================
+   HardFault, MemManage, BusFault and UsageFault share one handler. It
+   switches to a private stack (the faulting one may be exhausted),
+   copies the stacked exception frame if the stack pointer is inside
+   SRAM, the fault status and address registers, and the running task,
+   error and cycle-counter state into a record in .noinit RAM, then
+   resets the MCU. With a debugger attached it stops on a breakpoint
+   first.
+
+   The next boot finds the record (magic and checksum, which power loss
+   does not survive) and reports it until fault_clear_pending().
+   ============================================ */
+#define FAULT_RECORD_MAGIC 0x31544C46UL     // "FLT1"
+
+typedef struct {
+    uint32_t magic;
+    uint32_t faults;                    // Faults since power-on
+    uint32_t pending;                   // Not yet reported
+    uint32_t exception;                 // IPSR: 3 hard, 4 memmanage, 5 bus, 6 usage
+    uint32_t frame_valid;               // Stacked frame copied (stack pointer was in SRAM)
+    uint32_t r0, r1, r2, r3, r12;
+    uint32_t lr;                        // Return address of the faulting function
+    uint32_t pc;                        // Faulting instruction (precise faults)
+    uint32_t xpsr;
+    uint32_t sp;                        // Stack pointer before the exception
+    uint32_t exc_return;                // Handler LR: stack (MSP/PSP) and frame type
+    uint32_t cfsr;                      // MMFSR | BFSR | UFSR
+    uint32_t hfsr;
+    uint32_t mmfar;                     // Valid if CFSR.MMARVALID
+    uint32_t bfar;                      // Valid if CFSR.BFARVALID
+    uint32_t uptime_ms;                 // Timebase at the fault
+    uint32_t cycles;                    // DWT CYCCNT (0 unless ENABLE_PROFILING started it)
+    uint32_t task;                      // Running scheduler task id, SCHEDULER_INVALID_TASK if none
+    uint32_t last_error;                // error_get_last() code
+    uint32_t error_count;               // error_get_count()
+    uint32_t checksum;
+} fault_record_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Validate the retained record and enable the configurable faults
+ *
+ * MemManage, BusFault and UsageFault get their own exception instead
+ * of escalating, so the record tells them apart.
+ */
+void fault_init(void);
+
+/**
+ * @brief Get the record left by a fault before the last reset
+ * @return Record, or NULL if there is nothing to report
+ */
+const fault_record_t *fault_get_pending(void);
+
+/**
+ * @brief Mark the pending record as reported (fault count is kept)
+ */
+void fault_clear_pending(void);
+
+/**
+ * @brief Get a short name for a fault exception
+ * @param exception IPSR exception number
+ * @return "hard", "memmanage", "bus", "usage" or "?"
+ */
+const char *fault_get_name(uint32_t exception);
+
+/**
+ * @brief Describe the set CFSR and HFSR bits
+ * @param fault Fault record
+ * @param buffer Destination, space-separated bit names
+ * @param size Destination size
+ */
+void fault_describe(const fault_record_t *fault, char *buffer, uint16_t size);
+
+#endif // __FAULT_H__
@@ -0,0 +1,93 @@
+#ifndef __MEMORY_H__
+#define __MEMORY_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Memory Budget
+   ============================================
+   Static arena: one MEMORY_ARENA_SIZE block in .bss from which the
+   subsystems draw their DMA, ring and staging buffers during init.
+   Only enabled features draw anything, and the arena is sized from
+   the per-subsystem budgets in config.h, so a disabled feature costs
+   no RAM. Every allocation starts on a MEMORY_ALIGN boundary (DMA
+   FIFO bursts) and is zeroed. memory_seal() ends init; later
+   allocations fail.
+
+   The F411 has a single 128 KB SRAM that both DMA controllers reach,
+   so there is one region. On parts with more SRAM banks, one arena
+   per bank would go here.
+
+   Stack high-water: memory_paint_stack() fills the free RAM between
+   the end of the static data (`_end`) and the current stack pointer
+   with MEMORY_STACK_PAINT. The deepest overwritten word gives the
+   peak stack use, and everything still painted has never been
+   touched.
+   ============================================ */
+#define MEMORY_STACK_PAINT  0xC5C5C5C5UL
+
+typedef enum {
+    MEMORY_OWNER_ADC = 0,               // DMA ping-pong buffer (main.c)
+    MEMORY_OWNER_PIPELINE,              // Stage output blocks (main.c)
+    MEMORY_OWNER_UART,                  // TX and RX rings (core/uart.h)
+    MEMORY_OWNER_LOGGER,                // Flash log staging pages (middleware/logger.h)
+    MEMORY_OWNER_TRIGGER,               // History and capture window (middleware/trigger.h)
+    MEMORY_OWNER_COUNT
+} memory_owner_t;
+
+typedef struct {
+    uint32_t ram_size;                  // SRAM size
+    uint32_t static_bytes;              // .data + .bss + .noinit, arena included
+    uint32_t arena_size;                // MEMORY_ARENA_SIZE
+    uint32_t arena_used;                // Bytes drawn, alignment included
+    uint32_t owner_bytes[MEMORY_OWNER_COUNT];
+    uint32_t failures;                  // Allocations refused
+    uint32_t stack_size;                // From _end to the top of RAM (heap reserve included)
+    uint32_t stack_peak;                // Deepest stack use seen since boot
+} memory_report_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Paint the unused stack area
+ *
+ * Call first thing in main(), before interrupts are enabled.
+ */
+void memory_paint_stack(void);
+
+/**
+ * @brief Draw a zeroed, MEMORY_ALIGN-aligned buffer from the arena
+ *
+ * Init only. A refusal raises ERROR_NO_MEMORY (critical) with the
+ * owner's name.
+ *
+ * @param owner Subsystem charged for the buffer
+ * @param size Bytes
+ * @return Buffer, NULL if the arena is full or sealed
+ */
+void *memory_alloc(memory_owner_t owner, uint32_t size);
+
+/**
+ * @brief End of init: refuse any further allocation
+ */
+void memory_seal(void);
+
+/**
+ * @brief Fill in the current figures (scans the painted stack)
+ * @param report Destination
+ */
+void memory_get_report(memory_report_t *report);
+
+/**
+ * @brief Get a subsystem's display name
+ * @param owner Subsystem
+ * @return Name string
+ */
+const char *memory_owner_name(memory_owner_t owner);
+
+#endif // __MEMORY_H__
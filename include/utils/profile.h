@@ -0,0 +1,106 @@
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32f4xx.h"
+#include "config.h"
+
+/* ============================================
+   Profiling Probes
+   ============================================
+   Cycle-accurate timing from the DWT cycle counter (CYCCNT, one count
+   per HCLK cycle). Each probe keeps count, min, max, total and a log2
+   histogram of its durations.
+
+     PROFILE_BEGIN(PROFILE_PROBE_UART_SEND);
+     uart_send_string(buf);
+     PROFILE_END(PROFILE_PROBE_UART_SEND);
+
+   With ENABLE_PROFILING 0 both macros expand to nothing. A probe must
+   be recorded from a single context (one ISR or the main loop); probes
+   may nest and ISR probes may preempt main-loop probes.
+   ============================================ */
+typedef enum {
+    PROFILE_PROBE_ADC_BLOCK = 0,        // app_pipeline_run(), one DMA block
+    PROFILE_PROBE_ADC_SAMPLE,           // process_adc_sample()
+    PROFILE_PROBE_TELEMETRY_SEND,       // telemetry_send_samples()
+    PROFILE_PROBE_UART_SEND,            // uart_send_string()
+    PROFILE_PROBE_ADC_DMA_ISR,          // DMA2_Stream0_IRQHandler()
+    PROFILE_PROBE_UART_DMA_ISR,         // DMA2_Stream7_IRQHandler()
+    PROFILE_PROBE_COUNT
+} profile_probe_t;
+
+typedef struct {
+    uint32_t count;                     // Recorded intervals
+    uint32_t min;                       // Shortest interval (cycles)
+    uint32_t max;                       // Longest interval (cycles)
+    uint64_t total;                     // Sum of intervals (cycles)
+    uint32_t histogram[PROFILE_HISTOGRAM_BINS];
+} profile_stats_t;
+
+/* ============================================
+   Instrumentation Macros
+   ============================================ */
+#if ENABLE_PROFILING
+#define PROFILE_BEGIN(probe)    uint32_t profile_start_##probe = profile_now()
+#define PROFILE_END(probe)      profile_record((probe), profile_now() - profile_start_##probe)
+#else
+#define PROFILE_BEGIN(probe)    do { } while (0)
+#define PROFILE_END(probe)      do { } while (0)
+#endif
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Read the cycle counter
+ * @return CYCCNT (wraps every 2^32 cycles, ~43 s at 100 MHz)
+ */
+static inline uint32_t profile_now(void) {
+    return DWT->CYCCNT;
+}
+
+/**
+ * @brief Enable the DWT cycle counter and clear all probes
+ *
+ * Also measures the cost of an empty BEGIN/END pair, which is
+ * subtracted from every recorded interval.
+ */
+void profile_init(void);
+
+/**
+ * @brief Add one interval to a probe
+ * @param probe Probe identifier
+ * @param cycles Raw interval in cycles (overhead is subtracted)
+ */
+void profile_record(profile_probe_t probe, uint32_t cycles);
+
+/**
+ * @brief Copy a probe's statistics (consistent snapshot)
+ * @param probe Probe identifier
+ * @param out Pointer to profile_stats_t
+ * @return true if probe is valid
+ */
+bool profile_get(profile_probe_t probe, profile_stats_t *out);
+
+/**
+ * @brief Get a probe's display name
+ * @param probe Probe identifier
+ * @return Name string
+ */
+const char *profile_get_name(profile_probe_t probe);
+
+/**
+ * @brief Get the BEGIN/END overhead subtracted from each interval
+ * @return Overhead in cycles
+ */
+uint32_t profile_get_overhead(void);
+
+/**
+ * @brief Clear all probes
+ */
+void profile_reset(void);
+
+#endif // __PROFILE_H__
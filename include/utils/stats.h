@@ -0,0 +1,94 @@
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "config.h"
+
+/* ============================================
+   Streaming Statistics Structures
+   ============================================
+   O(1) per sample, integer only. Running (since reset) statistics use
+   Welford's update in fixed point (mean Q16, M2 Q8); the sliding window
+   keeps the last STATS_WINDOW_SIZE samples with a running sum / sum of
+   squares and monotonic min/max deques (amortised O(1)).
+   ============================================ */
+#define STATS_WINDOW_MASK (STATS_WINDOW_SIZE - 1U)
+
+typedef struct {
+    // Running statistics
+    uint32_t count;                     // Samples since reset
+    uint16_t min;                       // Minimum since reset
+    uint16_t max;                       // Maximum since reset
+    int64_t mean_q16;                   // Welford mean, Q16
+    uint64_t m2_q8;                     // Welford sum of squared deviations, Q8
+    uint64_t sum_sq;                    // Sum of x^2 (for RMS)
+
+    // Sliding window
+    uint16_t window[STATS_WINDOW_SIZE]; // Last N samples
+    uint32_t window_pos;                // Free-running write index
+    uint32_t window_sum;                // Sum of window samples
+    uint64_t window_sum_sq;             // Sum of squared window samples
+    uint32_t min_deque[STATS_WINDOW_SIZE];  // Indices, values increasing
+    uint32_t max_deque[STATS_WINDOW_SIZE];  // Indices, values decreasing
+    uint32_t min_head, min_tail;
+    uint32_t max_head, max_tail;
+} stats_t;
+
+typedef struct {
+    uint32_t count;                     // Samples covered
+    uint16_t min;                       // Minimum
+    uint16_t max;                       // Maximum
+    uint32_t mean_q8;                   // Mean, Q8 (counts x 256)
+    uint32_t variance_q8;               // Population variance, Q8
+    uint32_t stddev_q8;                 // Standard deviation, Q8
+    uint32_t rms_q8;                    // Root mean square, Q8
+} stats_summary_t;
+
+/* ============================================
+   Public Function Declarations
+   ============================================ */
+
+/**
+ * @brief Initialize / reset statistics (running and window)
+ * @param s Pointer to stats_t
+ */
+void stats_init(stats_t *s);
+
+/**
+ * @brief Reset running statistics only (window is kept)
+ * @param s Pointer to stats_t
+ */
+void stats_reset_running(stats_t *s);
+
+/**
+ * @brief Add one sample
+ * @param s Pointer to stats_t
+ * @param x Sample value
+ */
+void stats_update(stats_t *s, uint16_t x);
+
+/**
+ * @brief Add a block of samples
+ * @param s Pointer to stats_t
+ * @param in First sample
+ * @param count Number of samples
+ * @param stride Elements between consecutive samples (channel stride)
+ */
+void stats_update_block(stats_t *s, const uint16_t *in, uint16_t count, uint16_t stride);
+
+/**
+ * @brief Summarise running statistics since the last reset
+ * @param s Pointer to stats_t
+ * @param out Pointer to stats_summary_t
+ */
+void stats_get_summary(const stats_t *s, stats_summary_t *out);
+
+/**
+ * @brief Summarise the last STATS_WINDOW_SIZE samples
+ * @param s Pointer to stats_t
+ * @param out Pointer to stats_summary_t
+ */
+void stats_get_window_summary(const stats_t *s, stats_summary_t *out);
+
+#endif // __STATS_H__
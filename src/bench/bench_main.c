@@ -0,0 +1,387 @@
+/**
+ * =============================================================================
+ * STM32F4 Data Acquisition System - Benchmark Firmware
+ * =============================================================================
+ *
+ * Built by the blackpill_f411ce_bench environment instead of main.c:
+ *
+ *   pio run -e blackpill_f411ce_bench -t upload && pio device monitor
+ *
+ * Every hot path is run over a fixed input set with the DWT cycle
+ * counter read around the whole loop. Results are printed once as CSV
+ * so captures from different releases or boards can be diffed with
+ * tools/bench_compare.py:
+ *
+ *   BENCH_BEGIN,<format>,<sysclk_hz>,<clock_profile>,<flags>
+ *   BENCH,<name>,<unit>,<units>,<total_cycles>,<cycles_per_unit>
+ *   BENCH_END,<rows>
+ *
+ * cycles_per_unit has two decimals and includes loop overhead; the
+ * "baseline" row shows that overhead for a trivial loop body.
+ *
+ * =============================================================================
+ */
+
+#include "stm32f4xx.h"
+#include "config.h"
+#include "core/clock.h"
+#include "core/adc.h"
+#include "core/adc_convert.h"
+#include "core/adc_oversample.h"
+#include "core/uart.h"
+#include "drivers/buffer.h"
+#include "drivers/spsc_ring.h"
+#include "drivers/ring_template.h"
+#include "middleware/filter.h"
+#include "middleware/telemetry.h"
+#include "utils/stats.h"
+#include "utils/profile.h"
+#include <stdio.h>
+
+#define BENCH_FORMAT_VERSION 1
+#define BENCH_SAMPLES 256               // Input set size (power of two)
+#define BENCH_REPEAT 16                 // Passes over the input set per row
+#define BENCH_UART_BYTES 4096           // Bytes pushed for the wire throughput row
+
+#if defined(__ARM_FEATURE_DSP)
+#define BENCH_FLAG_DSP 1U
+#else
+#define BENCH_FLAG_DSP 0U
+#endif
+#define BENCH_FLAGS (BENCH_FLAG_DSP | (ENABLE_CALIBRATION ? 2U : 0U) | (ADC_CONVERT_SPLIT_LUT ? 4U : 0U))
+
+/* ============================================
+   Benchmark State
+   ============================================ */
+static uint16_t bench_input[BENCH_SAMPLES];
+static uint16_t bench_output[BENCH_SAMPLES];
+static uint16_t ring_storage[BENCH_SAMPLES];
+static uint8_t frame_buffer[TELEMETRY_FRAME_MAX_SIZE];
+static char format_buffer[64];
+static volatile uint32_t bench_sink;
+static uint16_t bench_rows = 0;
+
+RING_DECLARE(bench_template_ring, uint16_t, BENCH_SAMPLES, uint16_t)
+static bench_template_ring_t template_ring;
+static fir_decimator_t bench_filter;
+static adc_oversampler_t bench_oversampler;
+static stats_t bench_stats;
+
+/* ============================================
+   Reporting
+   ============================================ */
+
+static void bench_print(const char *line) {
+    uart_send_string(line);
+    uart_tx_flush();
+}
+
+static void bench_report(const char *name, const char *unit, uint32_t units, uint32_t cycles) {
+    char line[96];
+    uint32_t per_unit_x100 = (uint32_t)(((uint64_t)cycles * 100U) / (units ? units : 1U));
+
+    snprintf(line, sizeof(line), "BENCH,%s,%s,%lu,%lu,%lu.%02lu\r\n",
+             name, unit, units, cycles, per_unit_x100 / 100U, per_unit_x100 % 100U);
+    bench_print(line);
+    bench_rows++;
+}
+
+/* ============================================
+   Benchmarks
+   ============================================ */
+
+static void bench_baseline(void) {
+    uint32_t start = profile_now();
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            bench_sink = bench_input[i];
+        }
+    }
+    bench_report("baseline", "op", BENCH_REPEAT * BENCH_SAMPLES, profile_now() - start);
+}
+
+static void bench_ring_buffer(void) {
+    ring_buffer_t rb;
+    uint16_t value;
+    uint32_t write_cycles = 0;
+    uint32_t peek_cycles = 0;
+    uint32_t read_cycles = 0;
+
+    ring_buffer_init(&rb, ring_storage, BENCH_SAMPLES);
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        uint32_t start = profile_now();
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            ring_buffer_write(&rb, bench_input[i]);
+        }
+        write_cycles += profile_now() - start;
+
+        start = profile_now();
+        for (uint16_t i = 0; i < BENCH_SAMPLES; i++) {
+            ring_buffer_peek(&rb, i, &value);
+            bench_sink = value;
+        }
+        peek_cycles += profile_now() - start;
+
+        start = profile_now();
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            ring_buffer_read(&rb, &value);
+            bench_sink = value;
+        }
+        read_cycles += profile_now() - start;
+    }
+
+    bench_report("ring_buffer_write", "op", BENCH_REPEAT * BENCH_SAMPLES, write_cycles);
+    bench_report("ring_buffer_peek", "op", BENCH_REPEAT * BENCH_SAMPLES, peek_cycles);
+    bench_report("ring_buffer_read", "op", BENCH_REPEAT * BENCH_SAMPLES, read_cycles);
+}
+
+static void bench_ring_buffer_spans(void) {
+    ring_buffer_t rb;
+    ring_buffer_span_t spans[2];
+    uint32_t cycles = 0;
+
+    ring_buffer_init(&rb, ring_storage, BENCH_SAMPLES);
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        uint32_t start = profile_now();
+        ring_buffer_claim_write(&rb, spans);
+        ring_buffer_commit_write(&rb, BENCH_SAMPLES);
+        ring_buffer_peek_read(&rb, spans);
+        bench_sink = spans[0].data[0];
+        ring_buffer_release_read(&rb, BENCH_SAMPLES);
+        cycles += profile_now() - start;
+    }
+
+    bench_report("ring_buffer_span_cycle", "block", BENCH_REPEAT, cycles);
+}
+
+static void bench_spsc_ring(void) {
+    spsc_ring_t rb;
+    uint16_t value;
+    uint32_t write_cycles = 0;
+    uint32_t read_cycles = 0;
+    uint32_t block_cycles = 0;
+
+    spsc_ring_init(&rb, ring_storage, BENCH_SAMPLES);
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        uint32_t start = profile_now();
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            spsc_ring_write(&rb, bench_input[i]);
+        }
+        write_cycles += profile_now() - start;
+
+        start = profile_now();
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            spsc_ring_read(&rb, &value);
+            bench_sink = value;
+        }
+        read_cycles += profile_now() - start;
+
+        start = profile_now();
+        spsc_ring_write_n(&rb, bench_input, BENCH_SAMPLES);
+        spsc_ring_read_n(&rb, bench_output, BENCH_SAMPLES);
+        block_cycles += profile_now() - start;
+    }
+
+    bench_report("spsc_ring_write", "op", BENCH_REPEAT * BENCH_SAMPLES, write_cycles);
+    bench_report("spsc_ring_read", "op", BENCH_REPEAT * BENCH_SAMPLES, read_cycles);
+    bench_report("spsc_ring_write_read_n", "sample", BENCH_REPEAT * BENCH_SAMPLES, block_cycles);
+}
+
+static void bench_ring_template(void) {
+    uint16_t value;
+    uint32_t cycles = 0;
+
+    bench_template_ring_init(&template_ring);
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        uint32_t start = profile_now();
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            bench_template_ring_push(&template_ring, &bench_input[i]);
+        }
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            bench_template_ring_pop(&template_ring, &value);
+            bench_sink = value;
+        }
+        cycles += profile_now() - start;
+    }
+
+    bench_report("ring_template_push_pop", "op", BENCH_REPEAT * BENCH_SAMPLES, cycles);
+}
+
+static void bench_conversion(void) {
+    uint32_t cycles = 0;
+    uint32_t block_cycles = 0;
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        uint32_t start = profile_now();
+        for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+            bench_sink = adc_raw_to_voltage_mv(bench_input[i]);
+        }
+        cycles += profile_now() - start;
+
+        start = profile_now();
+        adc_convert_block_mv(bench_input, bench_output, BENCH_SAMPLES, ADC_RESOLUTION);
+        block_cycles += profile_now() - start;
+    }
+
+    bench_report("adc_raw_to_voltage_mv", "op", BENCH_REPEAT * BENCH_SAMPLES, cycles);
+    bench_report("adc_convert_block_mv", "sample", BENCH_REPEAT * BENCH_SAMPLES, block_cycles);
+
+    // 14-bit (oversampled) values take the interpolating path
+    uint32_t start = profile_now();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        bench_sink = adc_value_to_voltage_mv((uint32_t)bench_input[i] << 2, 14);
+    }
+    bench_report("adc_value_to_voltage_mv_14bit", "op", BENCH_SAMPLES, profile_now() - start);
+}
+
+static void bench_formatting(void) {
+    uint32_t cycles = 0;
+
+    // Same format and split as process_adc_sample()
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        uint32_t whole;
+        uint32_t decimal;
+        uint32_t start = profile_now();
+        adc_convert_raw_to_split(bench_input[i], &whole, &decimal);
+        int len = snprintf(format_buffer, sizeof(format_buffer),
+                           "Smp %05lu | ADC: %4u | V: %lu.%03lu V\r\n",
+                           i, bench_input[i], whole, decimal);
+        cycles += profile_now() - start;
+        bench_sink = (uint32_t)len;
+    }
+
+    bench_report("process_adc_sample_snprintf", "op", BENCH_SAMPLES, cycles);
+}
+
+static void bench_filter_stage(void) {
+    uint32_t cycles = 0;
+
+    fir_decimator_init(&bench_filter, filter_lowpass_d4, FILTER_LOWPASS_D4_TAPS, FILTER_DECIMATION);
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        uint32_t start = profile_now();
+        fir_decimator_process(&bench_filter, bench_input, BENCH_SAMPLES, 1, bench_output, 1);
+        cycles += profile_now() - start;
+    }
+
+    bench_report("fir_decimator_process_32tap_d4", "input", BENCH_REPEAT * BENCH_SAMPLES, cycles);
+
+    cycles = 0;
+    adc_oversampler_reset(&bench_oversampler);
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        uint32_t start = profile_now();
+        adc_oversample_block(&bench_oversampler, bench_input, BENCH_SAMPLES, 1, bench_output, 1);
+        cycles += profile_now() - start;
+    }
+
+    bench_report("adc_oversample_block", "input", BENCH_REPEAT * BENCH_SAMPLES, cycles);
+}
+
+static void bench_statistics(void) {
+    stats_init(&bench_stats);
+
+    uint32_t start = profile_now();
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        stats_update_block(&bench_stats, bench_input, BENCH_SAMPLES, 1);
+    }
+    bench_report("stats_update", "sample", BENCH_REPEAT * BENCH_SAMPLES, profile_now() - start);
+}
+
+static void bench_framing(void) {
+    uint32_t cycles = 0;
+    uint16_t length = 0;
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; r++) {
+        uint32_t start = profile_now();
+        length = telemetry_encode_samples(frame_buffer, (uint16_t)r, r * 1000U, 1,
+                                          bench_input, BENCH_SAMPLES);
+        cycles += profile_now() - start;
+    }
+    bench_report("telemetry_encode_256", "sample", BENCH_REPEAT * BENCH_SAMPLES, cycles);
+
+    uint32_t start = profile_now();
+    bench_sink = telemetry_crc16(0xFFFF, frame_buffer, length);
+    bench_report("telemetry_crc16", "byte", length, profile_now() - start);
+}
+
+static void bench_uart(void) {
+    static const char chunk[] = "0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDE\n";
+    const uint16_t chunk_len = sizeof(chunk) - 1;
+
+    // CPU cost of queueing (ring has room, DMA drains in the background)
+    uart_tx_flush();
+    uint32_t start = profile_now();
+    uint32_t queued = 0;
+    while (queued + chunk_len <= UART_TX_BUFFER_SIZE / 2) {
+        uart_tx_write((const uint8_t *)chunk, chunk_len);
+        queued += chunk_len;
+    }
+    bench_report("uart_tx_write", "byte", queued, profile_now() - start);
+    uart_tx_flush();
+
+    // Wire throughput: bytes over the cycles until the last stop bit
+    start = profile_now();
+    uint32_t sent = 0;
+    while (sent < BENCH_UART_BYTES) {
+        if (uart_tx_write((const uint8_t *)chunk, chunk_len)) {
+            sent += chunk_len;
+        }
+    }
+    uart_tx_flush();
+    uint32_t cycles = profile_now() - start;
+    bench_report("uart_tx_throughput", "byte", sent, cycles);
+
+    char line[64];
+    uint32_t bytes_per_s = (uint32_t)(((uint64_t)sent * SystemCoreClock) / cycles);
+    snprintf(line, sizeof(line), "BENCH,uart_tx_bytes_per_s,Bps,%lu,0,0.00\r\n", bytes_per_s);
+    bench_print(line);
+    bench_rows++;
+}
+
+/**
+ * @brief Benchmark firmware entry point
+ */
+int main(void) {
+    clock_init();
+    uart_init();
+    profile_init();
+    telemetry_init();
+
+    // Deterministic pseudo-random 12-bit input set
+    uint32_t lfsr = 0xACE1U;
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1U) & 0xB400U);
+        bench_input[i] = (uint16_t)(lfsr & ADC_MAX_VALUE);
+    }
+
+    __enable_irq();
+
+    char line[64];
+    // flags: bit0 = SMLAD filter path, bit1 = calibrated table, bit2 = split table
+    snprintf(line, sizeof(line), "\r\nBENCH_BEGIN,%u,%lu,%u,%u\r\n",
+             BENCH_FORMAT_VERSION, SystemCoreClock, CLOCK_PROFILE, BENCH_FLAGS);
+    bench_print(line);
+
+    bench_baseline();
+    bench_ring_buffer();
+    bench_ring_buffer_spans();
+    bench_spsc_ring();
+    bench_ring_template();
+    bench_conversion();
+    bench_formatting();
+    bench_filter_stage();
+    bench_statistics();
+    bench_framing();
+    bench_uart();
+
+    snprintf(line, sizeof(line), "BENCH_END,%u\r\n", bench_rows);
+    bench_print(line);
+
+    while (1) {
+        __WFI();
+    }
+}
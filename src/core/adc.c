@@ -1,11 +1,64 @@
 #include "../include/core/adc.h"
+#include "core/adc_convert.h"
+#include "core/dma.h"
 
 /* ============================================
    Static Variables
    ============================================ */
 static volatile uint16_t adc_raw_value = 0;
 static volatile adc_status_t adc_status = ADC_STATUS_NOT_READY;
+static uint8_t adc_raw_bits = ADC_RESOLUTION;
+static uint64_t adc_raw_timestamp_us = 0;
 static volatile bool adc_conversion_complete = false;
+static uint8_t adc_scan_length = 1;
+static volatile uint32_t adc_overrun_count = 0;
+static adc_trigger_t adc_trigger = ADC_TRIGGER_TIM2_TRGO;
+static adc_sample_time_t adc_sample_time = ADC_SAMPLE_TIME_LIST;
+
+// Programmed sequence: channel and scan-list sample time per slot
+static uint8_t adc_sequence[ADC_MAX_SCAN_CHANNELS] = {0};
+static uint8_t adc_sequence_smp[ADC_MAX_SCAN_CHANNELS] = {ADC_SAMPLE_3_CYCLES};
+
+// Sampling cycles per SMPR code
+static const uint16_t sample_cycles[8] = {3, 15, 28, 56, 84, 112, 144, 480};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+/**
+ * @brief Short wait for the ADC to settle after ADON (tSTAB)
+ */
+static void adc_power_up_delay(void) {
+    for (volatile int i = 0; i < 100; i++);
+}
+
+/**
+ * @brief Write SMPR1/SMPR2 for the programmed sequence
+ *
+ * SMPR2 holds channels 0..9, SMPR1 channels 10..18, 3 bits each.
+ */
+static void adc_write_sample_times(void) {
+    uint32_t smpr1 = ADC1->SMPR1;
+    uint32_t smpr2 = ADC1->SMPR2;
+
+    for (uint8_t i = 0; i < adc_scan_length; i++) {
+        uint8_t ch = adc_sequence[i];
+        uint32_t smp = (adc_sample_time == ADC_SAMPLE_TIME_LIST) ? adc_sequence_smp[i]
+                                                                 : ((uint32_t)adc_sample_time & 0x7U);
+
+        if (ch < 10) {
+            smpr2 &= ~(0x7U << (3 * ch));
+            smpr2 |= smp << (3 * ch);
+        } else {
+            smpr1 &= ~(0x7U << (3 * (ch - 10)));
+            smpr1 |= smp << (3 * (ch - 10));
+        }
+    }
+
+    ADC1->SMPR1 = smpr1;
+    ADC1->SMPR2 = smpr2;
+}
 
 /* ============================================
    ADC Initialization
@@ -21,7 +74,9 @@ static volatile bool adc_conversion_complete = false;
  * - DMA enabled for data transfer
  * - Single-channel conversion (Channel 0 only)
  * - 12-bit resolution (default)
- * - Sample time: 15 cycles (default)
+ * - ADCCLK = PCLK2 / ADC_PRESCALER_DIV
+ * - Sample time: 3 cycles (SMPR reset value, see adc_set_sample_time())
+ * - Overrun interrupt: DMA resynchronised on OVR
  * 
  * Trigger mapping:
  * - EXTSEL = 0110 (TIM2 TRGO)
@@ -33,9 +88,14 @@ adc_status_t adc_init(void) {
     // Enable ADC1 clock (APB2)
     RCC->APB2ENR |= RCC_APB2ENR_ADC1EN;
     
+    // ADCCLK = PCLK2 / ADC_PRESCALER_DIV (kept within ADC_MAX_CLOCK_HZ)
+    ADC1_COMMON->CCR &= ~ADC_CCR_ADCPRE;
+    ADC1_COMMON->CCR |= (ADC_CCR_ADCPRE_BITS << 16);
+    
     // Configure ADC control register 1
     ADC1->CR1 = 0;
     ADC1->CR1 &= ~ADC_CR1_SCAN;     // Single channel mode
+    ADC1->CR1 |= ADC_CR1_OVRIE;     // Overrun interrupt (lost conversion)
     
     // Configure ADC control register 2
     // Clear settings first
@@ -65,7 +125,12 @@ adc_status_t adc_init(void) {
     ADC1->CR2 |= ADC_CR2_ADON;
     
     // Small delay for ADC to power up
-    for (volatile int i = 0; i < 100; i++);
+    adc_power_up_delay();
+    
+    adc_overrun_count = 0;
+    adc_trigger = ADC_TRIGGER_TIM2_TRGO;
+    NVIC_SetPriority(ADC_IRQn, INTERRUPT_PRIORITY);
+    NVIC_EnableIRQ(ADC_IRQn);
     
     adc_status = ADC_STATUS_OK;
     return adc_status;
@@ -74,6 +139,12 @@ adc_status_t adc_init(void) {
 void adc_start(void) {
     ADC1->CR2 |= ADC_CR2_ADON;
     adc_conversion_complete = false;
+
+    // No trigger will come: start the first frame, CONT chains the rest
+    if (adc_trigger == ADC_TRIGGER_CONTINUOUS) {
+        adc_power_up_delay();
+        ADC1->CR2 |= ADC_CR2_SWSTART;
+    }
 }
 
 void adc_stop(void) {
@@ -90,19 +161,148 @@ adc_status_t adc_get_reading(adc_reading_t *reading) {
     }
 
     reading->raw_value = adc_raw_value;
-    reading->voltage_mv = adc_raw_to_voltage_mv(adc_raw_value);
-    reading->voltage_whole = reading->voltage_mv / 1000;
-    reading->voltage_decimal = reading->voltage_mv % 1000;
+    reading->resolution_bits = adc_raw_bits;
+    reading->voltage_mv = adc_convert_value_to_mv(adc_raw_value, adc_raw_bits);
+    reading->voltage_whole = reading->voltage_mv / 1000U;
+    reading->voltage_decimal = reading->voltage_mv % 1000U;
     reading->status = adc_status;
+    reading->timestamp_ms = adc_raw_timestamp_us / 1000U;
 
     adc_conversion_complete = false;
     return ADC_STATUS_OK;
 }
 
+void adc_publish_reading(uint16_t value, uint8_t bits, uint64_t timestamp_us) {
+    adc_raw_value = value;
+    adc_raw_bits = bits;
+    adc_raw_timestamp_us = timestamp_us;
+    adc_conversion_complete = true;
+}
+
 uint32_t adc_raw_to_voltage_mv(uint16_t raw_value) {
-    // Voltage(mV) = (ADC_Value × Reference) / Max_Count
-    // Using integer math: (ADC * 3300) / 4095
-    return (uint32_t)((raw_value * ADC_REFERENCE_MV) / ADC_MAX_VALUE);
+    // Voltage(mV) = (ADC_Value × Reference) / Max_Count, precomputed per count
+    return adc_convert_raw_to_mv(raw_value);
+}
+
+/**
+ * @brief Program SQRx / SMPRx from a channel list
+ *
+ * Sequence registers hold 5-bit channel numbers:
+ * - SQR3: SQ1..SQ6, SQR2: SQ7..SQ12, SQR1: SQ13..SQ16 + L[3:0]
+ * Sample times go through adc_write_sample_times().
+ */
+adc_status_t adc_configure_scan(const adc_scan_channel_t *channels, uint8_t count) {
+    if (channels == NULL || count == 0 || count > ADC_MAX_SCAN_CHANNELS) {
+        return ADC_STATUS_ERROR;
+    }
+
+    uint32_t sqr1 = (uint32_t)(count - 1) << 20;   // L = count - 1
+    uint32_t sqr2 = 0;
+    uint32_t sqr3 = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (channels[i].channel > 18) {
+            return ADC_STATUS_ERROR;
+        }
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t ch = channels[i].channel;
+
+        if (i < 6) {
+            sqr3 |= (uint32_t)ch << (5 * i);
+        } else if (i < 12) {
+            sqr2 |= (uint32_t)ch << (5 * (i - 6));
+        } else {
+            sqr1 |= (uint32_t)ch << (5 * (i - 12));
+        }
+
+        adc_sequence[i] = ch;
+        adc_sequence_smp[i] = (uint8_t)channels[i].sample_time & 0x7U;
+    }
+
+    adc_scan_length = count;
+    adc_write_sample_times();
+    ADC1->SQR1 = sqr1;
+    ADC1->SQR2 = sqr2;
+    ADC1->SQR3 = sqr3;
+
+    // Scan mode converts the whole sequence per trigger
+    if (count > 1) {
+        ADC1->CR1 |= ADC_CR1_SCAN;
+    } else {
+        ADC1->CR1 &= ~ADC_CR1_SCAN;
+    }
+
+    return ADC_STATUS_OK;
+}
+
+/**
+ * @brief Reprogram EXTSEL / EXTEN / CONT for a trigger source
+ *
+ * - EXTSEL = 0110 (TIM2 TRGO) or 1000 (TIM3 TRGO)
+ * - EXTEN = 01 (rising edge), 11 (both edges), 00 (continuous: SWSTART)
+ */
+void adc_set_trigger(adc_trigger_t trigger) {
+    uint32_t cr2 = ADC1->CR2 & ~(ADC_CR2_EXTEN | ADC_CR2_EXTSEL | ADC_CR2_CONT);
+
+    switch (trigger) {
+    case ADC_TRIGGER_TIM3_TRGO:
+        cr2 |= (1U << 28) | (8U << 24);
+        break;
+    case ADC_TRIGGER_TIM3_TRGO_BOTH:
+        cr2 |= (3U << 28) | (8U << 24);
+        break;
+    case ADC_TRIGGER_CONTINUOUS:
+        cr2 |= ADC_CR2_CONT;
+        break;
+    case ADC_TRIGGER_TIM2_TRGO:
+    default:
+        trigger = ADC_TRIGGER_TIM2_TRGO;
+        cr2 |= (1U << 28) | (6U << 24);
+        break;
+    }
+
+    ADC1->CR2 = cr2;
+    adc_trigger = trigger;
+}
+
+void adc_set_sample_time(adc_sample_time_t sample_time) {
+    adc_sample_time = sample_time;
+    adc_write_sample_times();
+}
+
+uint32_t adc_get_frame_cycles(adc_sample_time_t sample_time) {
+    uint32_t cycles = 0;
+
+    for (uint8_t i = 0; i < adc_scan_length; i++) {
+        uint8_t smp = (sample_time == ADC_SAMPLE_TIME_LIST) ? adc_sequence_smp[i]
+                                                            : ((uint8_t)sample_time & 0x7U);
+        cycles += sample_cycles[smp] + ADC_RESOLUTION;
+    }
+
+    return cycles;
+}
+
+uint8_t adc_get_scan_length(void) {
+    return adc_scan_length;
+}
+
+bool adc_get_channel_view(const volatile uint16_t *block, uint16_t length,
+                          uint8_t index, adc_channel_view_t *view) {
+    if (block == NULL || view == NULL || index >= adc_scan_length) {
+        return false;
+    }
+
+    view->base = block + index;
+    view->stride = adc_scan_length;
+    view->count = length / adc_scan_length;
+
+    return true;
+}
+
+uint32_t adc_value_to_voltage_mv(uint32_t value, uint8_t bits) {
+    return adc_convert_value_to_mv(value, bits);
 }
 
 bool adc_is_ready(void) {
@@ -112,3 +312,33 @@ bool adc_is_ready(void) {
 adc_status_t adc_get_status(void) {
     return adc_status;
 }
+
+uint32_t adc_get_overrun_count(void) {
+    return adc_overrun_count;
+}
+
+/* ============================================
+   Interrupt Handler
+   ============================================ */
+
+/**
+ * @brief ADC interrupt: overrun (a conversion finished before DMA read DR)
+ *
+ * On OVR the ADC stops issuing DMA requests and aborts the regular
+ * sequence. Recovery per RM0383 11.8.2: re-arm the DMA stream at the
+ * start of the buffer, then clear OVR; the next trigger starts a fresh
+ * sequence at SQ1, so scan frames stay aligned.
+ */
+void ADC_IRQHandler(void) {
+    if (ADC1->SR & ADC_SR_OVR) {
+        dma_restart();
+        // OVR is rc_w0: writing the other bits as 1 leaves them untouched
+        ADC1->SR = ~ADC_SR_OVR;
+        adc_overrun_count++;
+
+        // A free-running sequence stops at OVR as well
+        if (adc_trigger == ADC_TRIGGER_CONTINUOUS) {
+            ADC1->CR2 |= ADC_CR2_SWSTART;
+        }
+    }
+}
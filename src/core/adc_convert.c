@@ -0,0 +1,148 @@
+#include "core/adc_convert.h"
+#include <stddef.h>
+
+#if ADC_RESOLUTION != 12
+#error "adc_convert tables are generated for 12-bit conversions"
+#endif
+
+/* ============================================
+   Compile-Time Table Generation
+   ============================================
+   ADC_CONVERT_MV(i) is a constant expression; the ADC_CONVERT_Rn macros
+   expand it for every index so the compiler emits the finished table.
+   ============================================ */
+#define ADC_CONVERT_COUNTS(i) \
+    ((uint64_t)(((i) > ADC_CAL_OFFSET_COUNTS) ? ((i) - ADC_CAL_OFFSET_COUNTS) : 0))
+
+#define ADC_CONVERT_MV_RAW(i) \
+    ((ADC_CONVERT_COUNTS(i) * ADC_REFERENCE_MV * ADC_CAL_GAIN_Q16 + \
+      ((uint64_t)ADC_MAX_VALUE << 15)) / ((uint64_t)ADC_MAX_VALUE << 16))
+
+// Clamp so a gain above 1.0 cannot exceed the 16-bit entry
+#define ADC_CONVERT_MV(i) \
+    ((uint16_t)((ADC_CONVERT_MV_RAW(i) > 0xFFFFU) ? 0xFFFFU : ADC_CONVERT_MV_RAW(i)))
+
+#define ADC_CONVERT_SPLIT(i) \
+    ((uint16_t)(((ADC_CONVERT_MV(i) / 1000U) << 10) | (ADC_CONVERT_MV(i) % 1000U)))
+
+#define ADC_CONVERT_R4(f, i)    f(i), f((i) + 1), f((i) + 2), f((i) + 3)
+#define ADC_CONVERT_R16(f, i)   ADC_CONVERT_R4(f, i), ADC_CONVERT_R4(f, (i) + 4), \
+                                ADC_CONVERT_R4(f, (i) + 8), ADC_CONVERT_R4(f, (i) + 12)
+#define ADC_CONVERT_R64(f, i)   ADC_CONVERT_R16(f, i), ADC_CONVERT_R16(f, (i) + 16), \
+                                ADC_CONVERT_R16(f, (i) + 32), ADC_CONVERT_R16(f, (i) + 48)
+#define ADC_CONVERT_R256(f, i)  ADC_CONVERT_R64(f, i), ADC_CONVERT_R64(f, (i) + 64), \
+                                ADC_CONVERT_R64(f, (i) + 128), ADC_CONVERT_R64(f, (i) + 192)
+#define ADC_CONVERT_R1024(f, i) ADC_CONVERT_R256(f, i), ADC_CONVERT_R256(f, (i) + 256), \
+                                ADC_CONVERT_R256(f, (i) + 512), ADC_CONVERT_R256(f, (i) + 768)
+#define ADC_CONVERT_R4096(f)    ADC_CONVERT_R1024(f, 0), ADC_CONVERT_R1024(f, 1024), \
+                                ADC_CONVERT_R1024(f, 2048), ADC_CONVERT_R1024(f, 3072)
+
+/* ============================================
+   Tables (flash)
+   ============================================ */
+
+const uint16_t adc_mv_table[ADC_CONVERT_TABLE_SIZE] = {
+    ADC_CONVERT_R4096(ADC_CONVERT_MV)
+};
+
+#if ADC_CONVERT_SPLIT_LUT
+const uint16_t adc_mv_split_table[ADC_CONVERT_TABLE_SIZE] = {
+    ADC_CONVERT_R4096(ADC_CONVERT_SPLIT)
+};
+#endif
+
+#if ENABLE_CALIBRATION
+static uint16_t adc_mv_ram_table[ADC_CONVERT_TABLE_SIZE];
+const uint16_t *adc_mv_lut = adc_mv_table;
+
+#if ADC_CONVERT_SPLIT_LUT
+static uint16_t adc_mv_split_ram_table[ADC_CONVERT_TABLE_SIZE];
+const uint16_t *adc_mv_split_lut = adc_mv_split_table;
+#endif
+#endif
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+uint32_t adc_convert_value_to_mv(uint32_t value, uint8_t bits) {
+    if (bits <= ADC_RESOLUTION) {
+        return ADC_CONVERT_LUT[value & ADC_MAX_VALUE];
+    }
+
+    // Top 12 bits select the segment, the rest interpolate within it
+    uint8_t shift = bits - ADC_RESOLUTION;
+    uint32_t index = value >> shift;
+    if (index >= ADC_MAX_VALUE) {
+        return ADC_CONVERT_LUT[ADC_MAX_VALUE];
+    }
+
+    uint32_t frac = value & ((1UL << shift) - 1U);
+    uint32_t lo = ADC_CONVERT_LUT[index];
+    uint32_t hi = ADC_CONVERT_LUT[index + 1];
+    return lo + (((hi - lo) * frac + (1UL << (shift - 1))) >> shift);
+}
+
+void adc_convert_block_mv(const uint16_t *in, uint16_t *out, uint16_t count, uint8_t bits) {
+    if (in == NULL || out == NULL) {
+        return;
+    }
+
+    if (bits > ADC_RESOLUTION) {
+        for (uint16_t i = 0; i < count; i++) {
+            out[i] = (uint16_t)adc_convert_value_to_mv(in[i], bits);
+        }
+        return;
+    }
+
+    // Hoist the table pointer so the loop is loads and stores only
+    const uint16_t *lut = ADC_CONVERT_LUT;
+    uint16_t i = 0;
+    for (; (uint32_t)i + 4U <= count; i += 4) {
+        uint16_t a = in[i];
+        uint16_t b = in[i + 1];
+        uint16_t c = in[i + 2];
+        uint16_t d = in[i + 3];
+        out[i] = lut[a & ADC_MAX_VALUE];
+        out[i + 1] = lut[b & ADC_MAX_VALUE];
+        out[i + 2] = lut[c & ADC_MAX_VALUE];
+        out[i + 3] = lut[d & ADC_MAX_VALUE];
+    }
+    for (; i < count; i++) {
+        out[i] = lut[in[i] & ADC_MAX_VALUE];
+    }
+}
+
+#if ENABLE_CALIBRATION
+void adc_convert_rebuild(uint32_t gain_q16, uint16_t offset_counts) {
+    // mV per count in Q32; one 64-bit divide, then the table is a running sum
+    uint64_t step_q32 = (((uint64_t)ADC_REFERENCE_MV * gain_q16 << 16) + (ADC_MAX_VALUE / 2U))
+                        / ADC_MAX_VALUE;
+    uint64_t acc_q32 = 0;
+
+    for (uint32_t raw = 0; raw < ADC_CONVERT_TABLE_SIZE; raw++) {
+        if (raw > offset_counts) {
+            acc_q32 += step_q32;
+        }
+
+        uint64_t mv64 = (acc_q32 + 0x80000000ULL) >> 32;
+        uint32_t mv = (mv64 > 0xFFFFU) ? 0xFFFFU : (uint32_t)mv64;
+        adc_mv_ram_table[raw] = (uint16_t)mv;
+#if ADC_CONVERT_SPLIT_LUT
+        adc_mv_split_ram_table[raw] = (uint16_t)(((mv / 1000U) << 10) | (mv % 1000U));
+#endif
+    }
+
+    adc_mv_lut = adc_mv_ram_table;
+#if ADC_CONVERT_SPLIT_LUT
+    adc_mv_split_lut = adc_mv_split_ram_table;
+#endif
+}
+
+void adc_convert_use_default(void) {
+    adc_mv_lut = adc_mv_table;
+#if ADC_CONVERT_SPLIT_LUT
+    adc_mv_split_lut = adc_mv_split_table;
+#endif
+}
+#endif
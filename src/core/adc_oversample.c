@@ -0,0 +1,80 @@
+#include "core/adc_oversample.h"
+#include <stddef.h>
+
+#if (ADC_OVERSAMPLE_SHIFT < 0) || (ADC_OVERSAMPLE_SHIFT > 4)
+#error "ADC_OVERSAMPLE_SHIFT must be 0-4 (12-16 effective bits)"
+#endif
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void adc_oversampler_reset(adc_oversampler_t *os) {
+    if (os != NULL) {
+        os->sum = 0;
+        os->pending = 0;
+    }
+}
+
+uint16_t adc_oversample_block(adc_oversampler_t *os, const uint16_t *in, uint16_t count,
+                              uint16_t in_stride, uint16_t *out, uint16_t out_stride) {
+    if (os == NULL || in == NULL || out == NULL) {
+        return 0;
+    }
+
+#if ADC_OVERSAMPLE_SHIFT == 0
+    for (uint16_t o = 0; o < count; o++) {
+        out[(uint32_t)o * out_stride] = in[(uint32_t)o * in_stride];
+    }
+    return count;
+#else
+    const uint32_t s = in_stride;
+    uint16_t outputs = 0;
+
+    // Complete the group the previous block left open
+    if (os->pending != 0) {
+        while (count > 0 && os->pending < ADC_OVERSAMPLE_RATIO) {
+            os->sum += in[0];
+            in += s;
+            count--;
+            os->pending++;
+        }
+        if (os->pending < ADC_OVERSAMPLE_RATIO) {
+            return 0;
+        }
+        out[0] = (uint16_t)(os->sum >> ADC_OVERSAMPLE_SHIFT);
+        out += out_stride;
+        outputs = 1;
+        os->sum = 0;
+        os->pending = 0;
+    }
+
+    uint16_t groups = count / ADC_OVERSAMPLE_RATIO;
+
+    for (uint16_t o = 0; o < groups; o++) {
+        // Four independent accumulators keep the adds from serialising;
+        // ADC_OVERSAMPLE_RATIO is a compile-time multiple of four
+        uint32_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+
+        for (uint32_t i = 0; i < ADC_OVERSAMPLE_RATIO; i += 4) {
+            acc0 += in[0];
+            acc1 += in[s];
+            acc2 += in[2 * s];
+            acc3 += in[3 * s];
+            in += 4 * s;
+        }
+
+        out[(uint32_t)o * out_stride] = (uint16_t)((acc0 + acc1 + acc2 + acc3) >> ADC_OVERSAMPLE_SHIFT);
+    }
+
+    // Carry the trailing partial group into the next block
+    uint16_t tail = count - groups * ADC_OVERSAMPLE_RATIO;
+    for (uint16_t i = 0; i < tail; i++) {
+        os->sum += in[0];
+        in += s;
+    }
+    os->pending = tail;
+
+    return outputs + groups;
+#endif
+}
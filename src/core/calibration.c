@@ -0,0 +1,124 @@
+#include "core/calibration.h"
+#include "core/adc.h"
+#include "core/adc_convert.h"
+
+#if ENABLE_CALIBRATION
+
+#define CAL_CONVERSION_TIMEOUT 10000U   // Poll iterations per injected conversion
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static calibration_t calibration = {
+    .offset_counts = ADC_CAL_OFFSET_COUNTS,
+    .gain_q16 = ADC_CAL_GAIN_Q16,
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+/**
+ * @brief Run one software-started injected conversion of JSQ4
+ * @param value Receives the 12-bit result
+ * @return true if the conversion finished
+ */
+static bool calibration_convert_injected(uint16_t *value) {
+    // JEOC is rc_w0: writing the other bits as 1 leaves them untouched
+    ADC1->SR = ~ADC_SR_JEOC;
+    ADC1->CR2 |= ADC_CR2_JSWSTART;
+
+    uint32_t timeout = CAL_CONVERSION_TIMEOUT;
+    while (!(ADC1->SR & ADC_SR_JEOC)) {
+        if (--timeout == 0) {
+            return false;
+        }
+    }
+
+    *value = (uint16_t)ADC1->JDR1;
+    return true;
+}
+
+static uint32_t calibration_abs_diff(uint32_t a, uint32_t b) {
+    return (a > b) ? (a - b) : (b - a);
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+calibration_status_t calibration_init(void) {
+    // VREFINT (and temperature sensor) on
+    ADC1_COMMON->CCR |= ADC_CCR_TSVREFE;
+
+    // Channel 17: 480-cycle sample time (SMPR1 holds channels 10..18)
+    ADC1->SMPR1 &= ~(0x7U << (3 * (CAL_VREFINT_CHANNEL - 10)));
+    ADC1->SMPR1 |= ((uint32_t)ADC_SAMPLE_480_CYCLES << (3 * (CAL_VREFINT_CHANNEL - 10)));
+
+    // Injected sequence: JL = 0 (one conversion) uses JSQ4, software start
+    ADC1->JSQR = (uint32_t)CAL_VREFINT_CHANNEL << 15;
+    ADC1->CR2 &= ~ADC_CR2_JEXTEN;
+
+    calibration.vrefint_cal = CAL_VREFINT_CAL;
+    calibration.valid = false;
+
+    // VREFINT start-up time (10 us max) before the first sample
+    for (volatile int i = 0; i < 1000; i++);
+
+    return calibration_update();
+}
+
+calibration_status_t calibration_update(void) {
+    uint32_t sum = 0;
+
+    for (uint32_t i = 0; i < CAL_VREFINT_SAMPLES; i++) {
+        uint16_t value;
+        if (!calibration_convert_injected(&value)) {
+            return CAL_STATUS_TIMEOUT;
+        }
+        sum += value;
+    }
+
+    calibration.updates++;
+    calibration.vrefint_raw = (uint16_t)((sum + CAL_VREFINT_SAMPLES / 2U) / CAL_VREFINT_SAMPLES);
+
+    if (sum == 0) {
+        calibration.rejected++;
+        return CAL_STATUS_OUT_OF_RANGE;
+    }
+
+    // VDDA = 3300 * CAL / measured, kept at full averaged precision
+    uint64_t cal_term = (uint64_t)CAL_VREFINT_CAL_MV * calibration.vrefint_cal * CAL_VREFINT_SAMPLES;
+    uint32_t vdda_mv = (uint32_t)((cal_term + sum / 2U) / sum);
+
+    if (vdda_mv < CAL_VDDA_MIN_MV || vdda_mv > CAL_VDDA_MAX_MV) {
+        calibration.rejected++;
+        return CAL_STATUS_OUT_OF_RANGE;
+    }
+    calibration.vdda_mv = (uint16_t)vdda_mv;
+
+    // gain = (VDDA / ADC_REFERENCE_MV) * static trim, in Q16
+    uint32_t gain_q16 = (uint32_t)((cal_term * ADC_CAL_GAIN_Q16 + ((uint64_t)sum * ADC_REFERENCE_MV) / 2U)
+                                   / ((uint64_t)sum * ADC_REFERENCE_MV));
+
+    if (!calibration.valid ||
+        calibration_abs_diff(gain_q16, calibration.gain_q16) > CAL_GAIN_HYSTERESIS_Q16) {
+        calibration.gain_q16 = gain_q16;
+        adc_convert_rebuild(calibration.gain_q16, calibration.offset_counts);
+        calibration.rebuilds++;
+        calibration.valid = true;
+    }
+
+    return CAL_STATUS_OK;
+}
+
+void calibration_set_offset(uint16_t offset_counts) {
+    calibration.offset_counts = offset_counts;
+    calibration.valid = false;          // Force a rebuild on the next update
+}
+
+const calibration_t *calibration_get(void) {
+    return &calibration;
+}
+
+#endif // ENABLE_CALIBRATION
@@ -0,0 +1,149 @@
+#include "core/clock.h"
+
+/* ============================================
+   Profile Sanity Checks
+   ============================================ */
+#if defined(CLOCK_SOURCE_HSE_PLL)
+#if (HSE_CRYSTAL_HZ / CLOCK_PLL_M) < 1000000UL || (HSE_CRYSTAL_HZ / CLOCK_PLL_M) > 2000000UL
+#error "PLL input (HSE / PLLM) must be 1-2 MHz"
+#endif
+#if ((HSE_CRYSTAL_HZ / CLOCK_PLL_M) * CLOCK_PLL_N) < 100000000UL || ((HSE_CRYSTAL_HZ / CLOCK_PLL_M) * CLOCK_PLL_N) > 432000000UL
+#error "PLL VCO must be 100-432 MHz"
+#endif
+#if CLOCK_PLL_P != 2 && CLOCK_PLL_P != 4 && CLOCK_PLL_P != 6 && CLOCK_PLL_P != 8
+#error "PLLP must be 2, 4, 6 or 8"
+#endif
+#endif
+
+#if SYSCLK_FREQ > 100000000UL
+#error "STM32F411 SYSCLK limit is 100 MHz"
+#endif
+#if PCLK1_FREQ > 50000000UL
+#error "APB1 limit is 50 MHz"
+#endif
+
+#define CLOCK_STARTUP_TIMEOUT 100000U
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static uint32_t sysclk_hz = 16000000UL;
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static uint32_t apb_div_bits(uint32_t div) {
+    // PPREx encoding: 0xx = /1, 100 = /2, 101 = /4, 110 = /8, 111 = /16
+    switch (div) {
+        case 2:  return 4U;
+        case 4:  return 5U;
+        case 8:  return 6U;
+        case 16: return 7U;
+        default: return 0U;
+    }
+}
+
+static bool wait_flag(volatile uint32_t *reg, uint32_t mask) {
+    for (uint32_t i = 0; i < CLOCK_STARTUP_TIMEOUT; i++) {
+        if (*reg & mask) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Undo a partial profile: HSI, PLL and HSE off, buses /1
+ *
+ * Leaves the tree as it comes out of reset (flash wait states stay
+ * raised, which is valid at any lower frequency), so sysclk_hz and
+ * SystemCoreClock describe the bus clocks again.
+ */
+static void clock_revert_hsi(void) {
+    RCC->CR |= RCC_CR_HSION;
+    while (!(RCC->CR & RCC_CR_HSIRDY));
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW) | RCC_CFGR_SW_HSI;
+    while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_HSI);
+
+    RCC->CR &= ~(RCC_CR_PLLON | RCC_CR_HSEON);
+    RCC->CFGR &= ~(RCC_CFGR_HPRE | RCC_CFGR_PPRE1 | RCC_CFGR_PPRE2);
+
+    sysclk_hz = 16000000UL;
+    SystemCoreClock = 16000000UL;
+}
+
+/* ============================================
+   Clock Initialization
+   ============================================ */
+
+/**
+ * @brief Apply CLOCK_PROFILE
+ *
+ * Sequence (RM0383 6.3):
+ * 1. Voltage scale 1 (required above 84 MHz)
+ * 2. Flash latency raised before the frequency goes up
+ * 3. Prefetch, instruction and data caches on
+ * 4. AHB /1, APB1/APB2 dividers
+ * 5. HSE on, PLL configured and locked
+ * 6. SYSCLK switched to PLL
+ * On failure the tree is reverted to plain HSI (clock_revert_hsi()).
+ */
+clock_status_t clock_init(void) {
+    // Voltage scale 1
+    RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+    PWR->CR |= PWR_CR_VOS;
+
+    // Wait states first, then ART accelerator
+    FLASH->ACR = (FLASH_WAIT_STATES << FLASH_ACR_LATENCY_Pos)
+               | FLASH_ACR_PRFTEN | FLASH_ACR_ICEN | FLASH_ACR_DCEN;
+
+    // Bus dividers (AHB /1)
+    RCC->CFGR &= ~(RCC_CFGR_HPRE | RCC_CFGR_PPRE1 | RCC_CFGR_PPRE2);
+    RCC->CFGR |= (apb_div_bits(CLOCK_APB1_DIV) << RCC_CFGR_PPRE1_Pos)
+               | (apb_div_bits(CLOCK_APB2_DIV) << RCC_CFGR_PPRE2_Pos);
+
+#if defined(CLOCK_SOURCE_HSE_PLL)
+    // External crystal
+    RCC->CR |= RCC_CR_HSEON;
+    if (!wait_flag(&RCC->CR, RCC_CR_HSERDY)) {
+        clock_revert_hsi();
+        return CLOCK_STATUS_HSE_FAILED;
+    }
+
+    // PLL: VCO = HSE / M * N, SYSCLK = VCO / P, USB = VCO / Q
+    RCC->CR &= ~RCC_CR_PLLON;
+    while (RCC->CR & RCC_CR_PLLRDY);
+
+    RCC->PLLCFGR = (CLOCK_PLL_M << RCC_PLLCFGR_PLLM_Pos)
+                 | (CLOCK_PLL_N << RCC_PLLCFGR_PLLN_Pos)
+                 | (((CLOCK_PLL_P / 2U) - 1U) << RCC_PLLCFGR_PLLP_Pos)
+                 | RCC_PLLCFGR_PLLSRC_HSE
+                 | (CLOCK_PLL_Q << RCC_PLLCFGR_PLLQ_Pos);
+
+    RCC->CR |= RCC_CR_PLLON;
+    if (!wait_flag(&RCC->CR, RCC_CR_PLLRDY)) {
+        clock_revert_hsi();
+        return CLOCK_STATUS_PLL_FAILED;
+    }
+
+    // Switch SYSCLK to PLL
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW) | RCC_CFGR_SW_PLL;
+    while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL);
+#else
+    // HSI is the reset source; make sure it is selected
+    RCC->CR |= RCC_CR_HSION;
+    while (!(RCC->CR & RCC_CR_HSIRDY));
+    RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW) | RCC_CFGR_SW_HSI;
+    while ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_HSI);
+#endif
+
+    sysclk_hz = SYSCLK_FREQ;
+    SystemCoreClock = SYSCLK_FREQ;
+
+    return CLOCK_STATUS_OK;
+}
+
+uint32_t clock_get_sysclk_hz(void) {
+    return sysclk_hz;
+}
@@ -0,0 +1,289 @@
+#include "core/dma.h"
+#include "core/timebase.h"
+#include "utils/profile.h"
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static volatile uint16_t *block_buffer = NULL;
+static volatile uint16_t block_size = 0;
+static volatile uint8_t ready_half = 0;
+static volatile bool block_ready = false;
+static volatile uint32_t block_sequence = 0;
+static volatile uint32_t block_trigger_us = 0;  // Last frame's trigger (TIM5 CCR1)
+static uint16_t block_frames = 0;
+static uint32_t frame_period_us = 1000000UL / ADC_SAMPLE_RATE_HZ;
+static volatile uint32_t overrun_count = 0;
+static volatile uint32_t restart_count = 0;
+static volatile uint32_t lost_samples = 0;
+static void (*volatile block_callback)(void) = NULL;
+static dma_stamp_t stamp_source = DMA_STAMP_TRIGGER;
+static volatile bool stamp_valid = false;        // stamp_prev_us belongs to the running stream
+static volatile uint32_t stamp_prev_us = 0;
+static volatile uint32_t jitter_intervals = 0;
+static volatile uint32_t jitter_min_us = 0xFFFFFFFFUL;
+static volatile uint32_t jitter_max_us = 0;
+
+/* ============================================
+   DMA Initialization
+   ============================================ */
+
+/**
+ * @brief Initialize DMA2 Stream0 for ADC1 block transfers
+ *
+ * Configuration:
+ * - Channel 0 (ADC1)
+ * - Direction: Peripheral to memory
+ * - Data size: 16-bit peripheral and memory
+ * - Circular mode, memory increment
+ * - Half-transfer + transfer-complete interrupts (ping-pong)
+ *
+ * The memory address and transfer count are set separately by
+ * dma_set_block_buffer() before the stream is enabled.
+ */
+void dma_init(void) {
+    // Enable DMA2 clock (AHB1)
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+
+    // Stream must be disabled before configuration
+    DMA2_Stream0->CR &= ~DMA_SxCR_EN;
+    while (DMA2_Stream0->CR & DMA_SxCR_EN);
+
+    // Clear any stale stream 0 flags
+    DMA2->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0
+                | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0;
+
+    DMA2_Stream0->CR = 0;
+    DMA2_Stream0->CR |= (0U << 25);         // CHSEL = 000 (Channel 0 = ADC1)
+    DMA2_Stream0->CR |= DMA_SxCR_PL_1;      // Priority high
+    DMA2_Stream0->CR |= DMA_SxCR_MSIZE_0;   // Memory size 16-bit
+    DMA2_Stream0->CR |= DMA_SxCR_PSIZE_0;   // Peripheral size 16-bit
+    DMA2_Stream0->CR |= DMA_SxCR_MINC;      // Memory increment
+    DMA2_Stream0->CR |= DMA_SxCR_CIRC;      // Circular mode
+    DMA2_Stream0->CR |= DMA_SxCR_HTIE;      // Half-transfer interrupt
+    DMA2_Stream0->CR |= DMA_SxCR_TCIE;      // Transfer-complete interrupt
+    DMA2_Stream0->CR |= DMA_SxCR_TEIE;      // Transfer-error interrupt
+
+    // Peripheral address: ADC1 data register
+    DMA2_Stream0->PAR = (uint32_t)&(ADC1->DR);
+
+    // Direct mode (FIFO disabled)
+    DMA2_Stream0->FCR = 0;
+
+    NVIC_SetPriority(DMA2_Stream0_IRQn, INTERRUPT_PRIORITY);
+    NVIC_EnableIRQ(DMA2_Stream0_IRQn);
+}
+
+bool dma_set_block_buffer(volatile uint16_t *buffer, uint16_t block_size_samples) {
+    if (buffer == NULL || block_size_samples == 0 || block_size_samples > 0x7FFF) {
+        return false;
+    }
+
+    block_buffer = buffer;
+    block_size = block_size_samples;
+    block_ready = false;
+    block_sequence = 0;
+    stamp_valid = false;
+    block_frames = block_size_samples;
+    frame_period_us = 1000000UL / ADC_SAMPLE_RATE_HZ;
+
+    // Both halves form one circular transfer; HT marks the middle
+    DMA2_Stream0->M0AR = (uint32_t)buffer;
+    DMA2_Stream0->NDTR = 2U * block_size_samples;
+
+    return true;
+}
+
+void dma_set_block_timing(uint16_t frames, uint32_t period_us) {
+    block_frames = frames;
+    frame_period_us = period_us;
+}
+
+void dma_set_stamp_source(dma_stamp_t source) {
+    stamp_source = source;
+}
+
+void dma_get_jitter(dma_jitter_t *out) {
+    if (out == NULL) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    out->intervals = jitter_intervals;
+    out->interval_min_us = jitter_min_us;
+    out->interval_max_us = jitter_max_us;
+    __set_PRIMASK(primask);
+}
+
+void dma_reset_jitter(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    stamp_valid = false;
+    jitter_intervals = 0;
+    jitter_min_us = 0xFFFFFFFFUL;
+    jitter_max_us = 0;
+    __set_PRIMASK(primask);
+}
+
+void dma_enable(void) {
+    DMA2_Stream0->CR |= DMA_SxCR_EN;
+}
+
+void dma_disable(void) {
+    DMA2_Stream0->CR &= ~DMA_SxCR_EN;
+    while (DMA2_Stream0->CR & DMA_SxCR_EN);
+}
+
+void dma_restart(void) {
+    if (block_buffer == NULL) {
+        return;
+    }
+
+    dma_disable();
+
+    // Samples already in the unfinished half never become a block
+    uint32_t done = (2U * block_size - DMA2_Stream0->NDTR) % block_size;
+    lost_samples += done;
+    restart_count++;
+    stamp_valid = false;            // The gap is not an interval
+
+    DMA2->LIFCR = DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0
+                | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0;
+    DMA2_Stream0->M0AR = (uint32_t)block_buffer;
+    DMA2_Stream0->NDTR = 2U * block_size;
+    dma_enable();
+}
+
+/* ============================================
+   Block Access
+   ============================================ */
+
+bool dma_get_ready_block(dma_block_t *block) {
+    if (block == NULL || !block_ready) {
+        return false;
+    }
+
+    // ISR may fire between the reads below; take a consistent snapshot
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint8_t half = ready_half;
+    uint32_t sequence = block_sequence;
+    uint32_t trigger_us = block_trigger_us;
+    block_ready = false;
+    __set_PRIMASK(primask);
+
+    // Back from the last frame's trigger to the first frame's
+    uint32_t first_us = trigger_us - (uint32_t)(block_frames - 1U) * frame_period_us;
+
+    block->data = &block_buffer[half * block_size];
+    block->length = block_size;
+    block->half = half;
+    block->sequence = sequence;
+    block->timestamp_us = timebase_extend_us(first_us);
+
+    return true;
+}
+
+bool dma_is_transfer_complete(void) {
+    return block_ready;
+}
+
+void dma_clear_transfer_complete_flag(void) {
+    block_ready = false;
+}
+
+uint32_t dma_get_overrun_count(void) {
+    return overrun_count;
+}
+
+uint32_t dma_get_restart_count(void) {
+    return restart_count;
+}
+
+uint32_t dma_get_lost_samples(void) {
+    return lost_samples;
+}
+
+void dma_set_block_callback(void (*callback)(void)) {
+    block_callback = callback;
+}
+
+/* ============================================
+   Interrupt Handler
+   ============================================ */
+
+/**
+ * @brief Publish a finished half and measure its stamp interval
+ */
+static inline void block_finished(uint8_t half, uint32_t trigger_us) {
+    if (block_ready) {
+        overrun_count++;
+    }
+
+    if (stamp_valid) {
+        uint32_t interval = trigger_us - stamp_prev_us;
+        jitter_intervals++;
+        if (interval < jitter_min_us) {
+            jitter_min_us = interval;
+        }
+        if (interval > jitter_max_us) {
+            jitter_max_us = interval;
+        }
+    }
+    stamp_prev_us = trigger_us;
+    stamp_valid = true;
+
+    ready_half = half;
+    block_trigger_us = trigger_us;
+    block_sequence++;
+    block_ready = true;
+}
+
+/**
+ * @brief DMA2 Stream0 interrupt: one event per finished half
+ *
+ * HT means the first half is stable (DMA now fills the second),
+ * TC means the second half is stable (DMA wrapped to the first).
+ * A block still pending when the next one finishes is counted as
+ * an overrun - the consumer missed a full block period.
+ *
+ * The block is stamped with one register read: the TIM5 capture of the
+ * trigger that started its last frame (two reads for the paired and
+ * ISR stamp sources).
+ */
+void DMA2_Stream0_IRQHandler(void) {
+    PROFILE_BEGIN(PROFILE_PROBE_ADC_DMA_ISR);
+    uint32_t lisr = DMA2->LISR;
+    uint32_t trigger_us = timebase_last_trigger_us32();
+
+    if (stamp_source != DMA_STAMP_TRIGGER) {
+        uint32_t now_us = timebase_now_us32();
+        if (stamp_source == DMA_STAMP_ISR) {
+            trigger_us = now_us;
+        } else if (now_us - trigger_us >= frame_period_us) {
+            // Last frame came from the uncaptured (falling) edge
+            trigger_us += frame_period_us;
+        }
+    }
+
+    if (lisr & DMA_LISR_HTIF0) {
+        DMA2->LIFCR = DMA_LIFCR_CHTIF0;
+        block_finished(0, trigger_us);
+    }
+
+    if (lisr & DMA_LISR_TCIF0) {
+        DMA2->LIFCR = DMA_LIFCR_CTCIF0;
+        block_finished(1, trigger_us);
+    }
+
+    if (lisr & DMA_LISR_TEIF0) {
+        DMA2->LIFCR = DMA_LIFCR_CTEIF0;
+    }
+
+    if ((lisr & (DMA_LISR_HTIF0 | DMA_LISR_TCIF0)) && block_callback != NULL) {
+        block_callback();
+    }
+
+    PROFILE_END(PROFILE_PROBE_ADC_DMA_ISR);
+}
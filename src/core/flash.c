@@ -0,0 +1,140 @@
+#include "core/flash.h"
+#include <stddef.h>
+
+#define FLASH_KEY1 0x45670123UL
+#define FLASH_KEY2 0xCDEF89ABUL
+#define FLASH_PSIZE_X32 (2U << FLASH_CR_PSIZE_Pos)
+#define FLASH_SR_ERRORS (FLASH_SR_SOP | FLASH_SR_WRPERR | FLASH_SR_PGAERR \
+                         | FLASH_SR_PGPERR | FLASH_SR_PGSERR)
+
+// Linker script symbols: .data load image follows .text in flash
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static const uint32_t sector_address[FLASH_SECTOR_COUNT] = {
+    0x08000000UL, 0x08004000UL, 0x08008000UL, 0x0800C000UL,
+    0x08010000UL, 0x08020000UL, 0x08040000UL, 0x08060000UL,
+};
+
+static const uint32_t sector_size[FLASH_SECTOR_COUNT] = {
+    0x4000UL, 0x4000UL, 0x4000UL, 0x4000UL,
+    0x10000UL, 0x20000UL, 0x20000UL, 0x20000UL,
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static void flash_unlock(void) {
+    if (FLASH->CR & FLASH_CR_LOCK) {
+        FLASH->KEYR = FLASH_KEY1;
+        FLASH->KEYR = FLASH_KEY2;
+    }
+}
+
+static void flash_lock(void) {
+    FLASH->CR |= FLASH_CR_LOCK;
+}
+
+/**
+ * @brief Wait for the current operation and collect its error flags
+ */
+static flash_status_t flash_wait(void) {
+    while (FLASH->SR & FLASH_SR_BSY);
+
+    uint32_t errors = FLASH->SR & FLASH_SR_ERRORS;
+    FLASH->SR = errors | FLASH_SR_EOP;      // rc_w1
+    return errors ? FLASH_STATUS_ERROR : FLASH_STATUS_OK;
+}
+
+/**
+ * @brief Drop ART data-cache lines that may hold pre-erase contents
+ */
+static void flash_reset_data_cache(void) {
+    if (FLASH->ACR & FLASH_ACR_DCEN) {
+        FLASH->ACR &= ~FLASH_ACR_DCEN;
+        FLASH->ACR |= FLASH_ACR_DCRST;
+        FLASH->ACR &= ~FLASH_ACR_DCRST;
+        FLASH->ACR |= FLASH_ACR_DCEN;
+    }
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+uint32_t flash_sector_address(uint8_t sector) {
+    return (sector < FLASH_SECTOR_COUNT) ? sector_address[sector] : 0;
+}
+
+uint32_t flash_sector_size(uint8_t sector) {
+    return (sector < FLASH_SECTOR_COUNT) ? sector_size[sector] : 0;
+}
+
+flash_status_t flash_erase_sector(uint8_t sector) {
+    if (sector >= FLASH_SECTOR_COUNT) {
+        return FLASH_STATUS_INVALID;
+    }
+    if (FLASH->SR & FLASH_SR_BSY) {
+        return FLASH_STATUS_BUSY;
+    }
+
+    flash_unlock();
+    FLASH->SR = FLASH_SR_ERRORS | FLASH_SR_EOP;
+
+    FLASH->CR = FLASH_PSIZE_X32 | FLASH_CR_SER | ((uint32_t)sector << FLASH_CR_SNB_Pos);
+    FLASH->CR |= FLASH_CR_STRT;
+    flash_status_t status = flash_wait();
+
+    FLASH->CR &= ~(FLASH_CR_SER | FLASH_CR_SNB);
+    flash_lock();
+    flash_reset_data_cache();
+
+    return status;
+}
+
+flash_status_t flash_program(uint32_t address, const uint32_t *data, uint16_t words) {
+    if (data == NULL || (address & 3U) != 0 ||
+        address < sector_address[0] ||
+        address + 4U * words > sector_address[FLASH_SECTOR_COUNT - 1] + sector_size[FLASH_SECTOR_COUNT - 1]) {
+        return FLASH_STATUS_INVALID;
+    }
+    if (FLASH->SR & FLASH_SR_BSY) {
+        return FLASH_STATUS_BUSY;
+    }
+
+    flash_unlock();
+    FLASH->SR = FLASH_SR_ERRORS | FLASH_SR_EOP;
+    FLASH->CR = FLASH_PSIZE_X32 | FLASH_CR_PG;
+
+    flash_status_t status = FLASH_STATUS_OK;
+    volatile uint32_t *dst = (volatile uint32_t *)address;
+    for (uint16_t i = 0; i < words && status == FLASH_STATUS_OK; i++) {
+        dst[i] = data[i];
+        status = flash_wait();
+    }
+
+    FLASH->CR &= ~FLASH_CR_PG;
+    flash_lock();
+
+    return status;
+}
+
+bool flash_is_erased(uint32_t address, uint32_t length) {
+    const volatile uint32_t *p = (const volatile uint32_t *)address;
+
+    for (uint32_t i = 0; i < length / 4U; i++) {
+        if (p[i] != 0xFFFFFFFFUL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t flash_image_end(void) {
+    return (uint32_t)&_sidata + (uint32_t)((uint8_t *)&_edata - (uint8_t *)&_sdata);
+}
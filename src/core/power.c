@@ -0,0 +1,320 @@
+#include "core/power.h"
+#include "core/clock.h"
+#include "core/uart.h"
+#include "core/timebase.h"
+#include <string.h>
+
+/* ============================================
+   Stop Mode Wakeup Timer
+   ============================================
+   RTC clocked from LSI (~32 kHz), wakeup counter on RTCCLK / 16
+   (WUCKSEL = 000) = ~2 kHz, so the longest Stop is ~32 s. LSI is only
+   accurate to tens of percent; the scheduler time base is advanced by
+   the programmed interval, not a measured one.
+   ============================================ */
+#define POWER_LSI_HZ            32000UL
+#define POWER_RTC_WAKEUP_HZ     (POWER_LSI_HZ / 16UL)
+#define POWER_STOP_MARGIN_MS    2U          // Wake early to cover the HSE/PLL restart
+#define POWER_EXTI_RTC_WAKEUP   (1UL << 22)
+#define POWER_EXTI_UART_RX      (1UL << 10) // PA10 falling edge (start bit)
+#define POWER_LSI_TIMEOUT       100000U
+
+#if POWER_POLICY != POWER_POLICY_RUN && POWER_POLICY != POWER_POLICY_SLEEP && POWER_POLICY != POWER_POLICY_STOP
+#error "POWER_POLICY must be POWER_POLICY_RUN, _SLEEP or _STOP"
+#endif
+
+#if POWER_STOP_MIN_MS <= POWER_STOP_MARGIN_MS
+#error "POWER_STOP_MIN_MS must exceed the restart margin"
+#endif
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static power_policy_t policy = POWER_SLEEP;
+static bool stop_allowed = false;
+static bool rtc_ready = false;
+static uint64_t rx_holdoff_until_ms = 0;
+static power_stats_t stats;
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+/**
+ * @brief Start LSI, clock the RTC from it and arm the wakeup interrupt
+ *
+ * The backup domain is reset only if the RTC was running from another
+ * source.
+ */
+static bool power_rtc_init(void) {
+    RCC->CSR |= RCC_CSR_LSION;
+    uint32_t timeout = POWER_LSI_TIMEOUT;
+    while (!(RCC->CSR & RCC_CSR_LSIRDY)) {
+        if (--timeout == 0) {
+            return false;
+        }
+    }
+
+    PWR->CR |= PWR_CR_DBP;
+    if ((RCC->BDCR & RCC_BDCR_RTCSEL) != RCC_BDCR_RTCSEL_1) {
+        RCC->BDCR |= RCC_BDCR_BDRST;
+        RCC->BDCR &= ~RCC_BDCR_BDRST;
+        RCC->BDCR |= RCC_BDCR_RTCSEL_1;     // 10 = LSI
+    }
+    RCC->BDCR |= RCC_BDCR_RTCEN;
+
+    // Unlock, stop the wakeup timer and select RTCCLK / 16
+    RTC->WPR = 0xCA;
+    RTC->WPR = 0x53;
+    RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUCKSEL);
+    while (!(RTC->ISR & RTC_ISR_WUTWF));
+    RTC->CR |= RTC_CR_WUTIE;
+    RTC->WPR = 0xFF;
+
+    // Wakeup event reaches the NVIC through EXTI line 22 (rising edge)
+    EXTI->IMR |= POWER_EXTI_RTC_WAKEUP;
+    EXTI->RTSR |= POWER_EXTI_RTC_WAKEUP;
+    NVIC_SetPriority(RTC_WKUP_IRQn, INTERRUPT_PRIORITY + 2);
+    NVIC_EnableIRQ(RTC_WKUP_IRQn);
+
+    // USART1 is frozen in Stop: the RX start bit on PA10 wakes the core
+    // instead. The line is unmasked only around the Stop entry.
+    RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+    SYSCFG->EXTICR[2] &= ~SYSCFG_EXTICR3_EXTI10;    // Port A
+    EXTI->IMR &= ~POWER_EXTI_UART_RX;
+    EXTI->FTSR |= POWER_EXTI_UART_RX;
+    NVIC_SetPriority(EXTI15_10_IRQn, INTERRUPT_PRIORITY + 2);
+    NVIC_EnableIRQ(EXTI15_10_IRQn);
+
+    return true;
+}
+
+/**
+ * @brief Program and start the wakeup timer
+ * @param counts RTC wakeup clock periods (1..65536)
+ */
+static void power_rtc_arm(uint32_t counts) {
+    RTC->WPR = 0xCA;
+    RTC->WPR = 0x53;
+    RTC->CR &= ~RTC_CR_WUTE;
+    while (!(RTC->ISR & RTC_ISR_WUTWF));
+    RTC->WUTR = counts - 1U;
+    RTC->ISR &= ~RTC_ISR_WUTF;
+    RTC->CR |= RTC_CR_WUTE;
+    RTC->WPR = 0xFF;
+    EXTI->PR = POWER_EXTI_RTC_WAKEUP;
+}
+
+static void power_rtc_disarm(void) {
+    RTC->WPR = 0xCA;
+    RTC->WPR = 0x53;
+    RTC->CR &= ~RTC_CR_WUTE;
+    RTC->WPR = 0xFF;
+}
+
+/**
+ * @brief WFI in Sleep mode, timed against SysTick
+ *
+ * SysTick keeps counting HCLK while the core is halted. Every sleep
+ * ends on or before the next tick (the tick interrupt is a wake
+ * source), so at most one reload happens in between.
+ */
+static void power_sleep(void) {
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        return;                             // WFI would return at once
+    }
+
+    uint32_t reload = SysTick->LOAD;
+    uint32_t entry = SysTick->VAL;
+    __DSB();
+    __WFI();
+    uint32_t exit = SysTick->VAL;
+
+    uint32_t slept;
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) {
+        // Counted entry -> 0, reloaded, then reload -> exit
+        uint32_t since_tick = reload - exit + 1U;
+        slept = entry + since_tick;
+
+        stats.wake_samples++;
+        stats.wake_latency_total += since_tick;
+        if (since_tick < stats.wake_latency_min || stats.wake_samples == 1U) {
+            stats.wake_latency_min = since_tick;
+        }
+        if (since_tick > stats.wake_latency_max) {
+            stats.wake_latency_max = since_tick;
+        }
+    } else {
+        slept = entry - exit;
+    }
+
+    stats.sleeps++;
+    stats.sleep_cycles += slept;
+}
+
+/**
+ * @brief Stop mode until the RTC wakeup (or any EXTI/interrupt)
+ * @param idle_ticks Scheduler ticks until the next release
+ * @return Scheduler ticks credited to the time base
+ */
+static uint32_t power_stop(uint32_t idle_ticks) {
+    uint32_t stop_ticks = idle_ticks - (POWER_STOP_MARGIN_MS * SCHED_TICK_HZ) / 1000U;
+    uint32_t counts = (uint32_t)(((uint64_t)stop_ticks * POWER_RTC_WAKEUP_HZ) / SCHED_TICK_HZ);
+    if (counts > 65536UL) {
+        counts = 65536UL;
+        stop_ticks = (uint32_t)((65536ULL * SCHED_TICK_HZ) / POWER_RTC_WAKEUP_HZ);
+    }
+    if (counts == 0) {
+        power_sleep();
+        return 0;
+    }
+
+    power_rtc_arm(counts);
+    EXTI->PR = POWER_EXTI_UART_RX;
+    EXTI->IMR |= POWER_EXTI_UART_RX;
+
+    // Stop with the regulator in low-power mode (PDDS = 0: not Standby)
+    PWR->CR &= ~PWR_CR_PDDS;
+    PWR->CR |= PWR_CR_LPDS | PWR_CR_CWUF;
+    SCB->SCR |= SCB_SCR_SLEEPDEEP_Msk;
+    __DSB();
+    __WFI();
+    SCB->SCR &= ~SCB_SCR_SLEEPDEEP_Msk;
+
+    EXTI->IMR &= ~POWER_EXTI_UART_RX;
+    bool rx_wake = (EXTI->PR & POWER_EXTI_UART_RX) != 0;
+
+    // Woken on HSI: bring HSE/PLL back before anything uses the bus clocks
+    uint32_t start = DWT->CYCCNT;
+    if (clock_init() != CLOCK_STATUS_OK) {
+        // Nothing timed from SYSCLK_FREQ is valid on HSI; restart and
+        // let the boot path retry the crystal (and halt if it is dead)
+        NVIC_SystemReset();
+    }
+    uint32_t restore = DWT->CYCCNT - start;
+    if (restore > stats.restore_cycles_max) {
+        stats.restore_cycles_max = restore;
+    }
+
+    bool timer_wake = (RTC->ISR & RTC_ISR_WUTF) != 0;
+    power_rtc_disarm();
+
+    stats.stops++;
+    if (rx_wake) {
+        // The waking byte is lost; keep USART1 clocked for the rest of the line
+        stats.rx_wakes++;
+        rx_holdoff_until_ms = timebase_now_ms() + POWER_RX_HOLDOFF_MS;
+    }
+    if (!timer_wake) {
+        // Unknown elapsed time: credit nothing rather than run tasks early
+        stats.early_wakes++;
+        return 0;
+    }
+
+    stats.stop_ticks += stop_ticks;
+    return stop_ticks;
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void power_init(void) {
+    RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+
+    // Cycle counter for the restore measurement (shared with profile.c)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    power_reset_stats();
+    stop_allowed = false;
+    power_set_policy((power_policy_t)POWER_POLICY);
+}
+
+bool power_set_policy(power_policy_t new_policy) {
+    if (new_policy == POWER_STOP && !rtc_ready) {
+        rtc_ready = power_rtc_init();
+        if (!rtc_ready) {
+            policy = POWER_SLEEP;
+            return false;
+        }
+    }
+
+    policy = new_policy;
+    return true;
+}
+
+power_policy_t power_get_policy(void) {
+    return policy;
+}
+
+void power_set_stop_allowed(bool allowed) {
+    stop_allowed = allowed;
+}
+
+uint32_t power_idle(uint32_t idle_ticks) {
+    switch (policy) {
+        case POWER_RUN:
+            return 0;
+
+        case POWER_STOP:
+            // Stop also freezes USART1 and USB: only enter once the last
+            // byte is out, and not while a command line may be arriving
+            if (stop_allowed && idle_ticks >= (POWER_STOP_MIN_MS * SCHED_TICK_HZ) / 1000U &&
+                uart_tx_get_route() == UART_TX_ROUTE_USART &&
+                uart_tx_is_idle() && (USART1->SR & USART_SR_TC) &&
+                timebase_now_ms() >= rx_holdoff_until_ms) {
+                return power_stop(idle_ticks);
+            }
+            power_sleep();
+            return 0;
+
+        case POWER_SLEEP:
+        default:
+            power_sleep();
+            return 0;
+    }
+}
+
+void power_get_stats(power_stats_t *out) {
+    if (out == NULL) {
+        return;
+    }
+
+    // Counters are written with interrupts masked; copy the same way
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats;
+    __set_PRIMASK(primask);
+}
+
+void power_reset_stats(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(&stats, 0, sizeof(stats));
+    __set_PRIMASK(primask);
+}
+
+/* ============================================
+   Interrupt Handler
+   ============================================ */
+
+/**
+ * @brief RTC wakeup interrupt: the Stop interval elapsed
+ *
+ * WUTF is left for power_stop() to read back; the handler only clears
+ * the EXTI line so the interrupt does not re-enter.
+ */
+void RTC_WKUP_IRQHandler(void) {
+    EXTI->PR = POWER_EXTI_RTC_WAKEUP;
+}
+
+/**
+ * @brief UART RX start bit during Stop (EXTI line 10)
+ *
+ * power_stop() has already read and masked the line; this only clears
+ * the pending bit.
+ */
+void EXTI15_10_IRQHandler(void) {
+    EXTI->PR = POWER_EXTI_UART_RX;
+}
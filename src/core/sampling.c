@@ -0,0 +1,161 @@
+#include "core/sampling.h"
+#include "core/timer.h"
+#include "core/timebase.h"
+
+/* ============================================
+   Mode Table
+   ============================================ */
+typedef struct {
+    const char *name;
+    timer_source_t timer;
+    adc_trigger_t trigger;
+    dma_stamp_t stamp;
+    uint8_t capture_itr;                // TIM5 ITR carrying the trigger timer's TRGO
+    adc_sample_time_t sample_time;
+    uint32_t step_hz;
+    uint32_t min_rate_hz;
+    uint32_t timer_max_hz;              // An update every 2 ticks (ARR = 1), or every tick paired
+} sampling_mode_desc_t;
+
+static const sampling_mode_desc_t modes[SAMPLING_MODE_COUNT] = {
+    [SAMPLING_TIM2] = {"tim2", TIMER_SOURCE_TIM2, ADC_TRIGGER_TIM2_TRGO, DMA_STAMP_TRIGGER,
+                       TIMEBASE_ITR_TIM2, ADC_SAMPLE_TIME_LIST,
+                       TIM2_TICK_HZ, 1U, TIM2_TICK_HZ / 2U},
+    [SAMPLING_TIM3] = {"tim3", TIMER_SOURCE_TIM3, ADC_TRIGGER_TIM3_TRGO, DMA_STAMP_TRIGGER,
+                       TIMEBASE_ITR_TIM3, SAMPLING_TIM3_SAMPLE_TIME,
+                       TIM3_TICK_HZ, (TIM3_TICK_HZ + 0xFFFFUL) / 0x10000UL, TIM3_TICK_HZ / 2U},
+    [SAMPLING_INTERLEAVED] = {"ilv", TIMER_SOURCE_TIM3_PAIRED, ADC_TRIGGER_TIM3_TRGO_BOTH,
+                       DMA_STAMP_TRIGGER_PAIRED, TIMEBASE_ITR_TIM3, SAMPLING_INTERLEAVED_SAMPLE_TIME,
+                       TIM3_TICK_HZ, (2U * TIM3_TICK_HZ + 0xFFFFUL) / 0x10000UL, TIM3_TICK_HZ},
+    [SAMPLING_CONTINUOUS] = {"cont", TIMER_SOURCE_NONE, ADC_TRIGGER_CONTINUOUS, DMA_STAMP_ISR,
+                       TIMEBASE_ITR_TIM2, SAMPLING_CONTINUOUS_SAMPLE_TIME,
+                       0U, 0U, 0U},
+};
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static sampling_mode_t active_mode = SAMPLING_TIM2;
+static uint32_t timer_rate_hz = ADC_SAMPLE_RATE_HZ;     // Kept across cont mode
+static dma_jitter_t mode_jitter[SAMPLING_MODE_COUNT];
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+/**
+ * @brief Program timer, ADC trigger, sample time and stamp source
+ * @return false if timer_rate_hz is not reachable (timer left selected)
+ */
+static bool apply_mode(sampling_mode_t mode) {
+    const sampling_mode_desc_t *desc = &modes[mode];
+
+    timer_select(desc->timer);
+    if (desc->timer != TIMER_SOURCE_NONE && !timer_set_rate(timer_rate_hz)) {
+        return false;
+    }
+
+    adc_set_trigger(desc->trigger);
+    adc_set_sample_time(desc->sample_time);
+    timebase_set_trigger_source(desc->capture_itr);
+    dma_set_stamp_source(desc->stamp);
+    dma_reset_jitter();
+
+    active_mode = mode;
+    return true;
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+bool sampling_init(sampling_mode_t mode) {
+    for (uint8_t m = 0; m < SAMPLING_MODE_COUNT; m++) {
+        mode_jitter[m] = (dma_jitter_t){0, 0xFFFFFFFFUL, 0};
+    }
+
+    timer_rate_hz = ADC_SAMPLE_RATE_HZ;
+    if (mode < SAMPLING_MODE_COUNT && apply_mode(mode)) {
+        return true;
+    }
+
+    apply_mode(SAMPLING_TIM2);
+    return false;
+}
+
+bool sampling_set_mode(sampling_mode_t mode) {
+    if (mode >= SAMPLING_MODE_COUNT) {
+        return false;
+    }
+
+    sampling_mode_t previous = active_mode;
+    dma_get_jitter(&mode_jitter[previous]);
+
+    if (!apply_mode(mode)) {
+        apply_mode(previous);
+        return false;
+    }
+    return true;
+}
+
+sampling_mode_t sampling_get_mode(void) {
+    return active_mode;
+}
+
+void sampling_start(void) {
+    adc_start();
+    timer_start();
+}
+
+void sampling_stop(void) {
+    timer_stop();
+    adc_stop();
+}
+
+bool sampling_set_rate(uint32_t rate_hz) {
+    if (modes[active_mode].timer == TIMER_SOURCE_NONE || !timer_set_rate(rate_hz)) {
+        return false;
+    }
+
+    timer_rate_hz = rate_hz;
+    dma_reset_jitter();
+    return true;
+}
+
+uint32_t sampling_get_rate(void) {
+    if (modes[active_mode].timer == TIMER_SOURCE_NONE) {
+        return ADC_CLOCK_FREQ / adc_get_frame_cycles(modes[active_mode].sample_time);
+    }
+    return timer_get_rate();
+}
+
+uint32_t sampling_get_period_us(void) {
+    uint32_t rate = sampling_get_rate();
+    uint32_t period = (rate != 0) ? (1000000UL + rate / 2U) / rate : 0;
+    return (period != 0) ? period : 1U;
+}
+
+bool sampling_get_info(sampling_mode_t mode, sampling_info_t *info) {
+    if (mode >= SAMPLING_MODE_COUNT || info == NULL) {
+        return false;
+    }
+
+    const sampling_mode_desc_t *desc = &modes[mode];
+    uint32_t cycles = adc_get_frame_cycles(desc->sample_time);
+    uint32_t adc_max_hz = ADC_CLOCK_FREQ / cycles;
+
+    info->name = desc->name;
+    info->step_hz = desc->step_hz;
+    info->min_rate_hz = desc->min_rate_hz;
+    info->max_rate_hz = (desc->timer == TIMER_SOURCE_NONE || adc_max_hz < desc->timer_max_hz)
+                      ? adc_max_hz : desc->timer_max_hz;
+    info->frame_cycles = cycles;
+    info->sample_time = desc->sample_time;
+    if (mode == active_mode) {
+        dma_get_jitter(&info->jitter);
+    } else {
+        info->jitter = mode_jitter[mode];
+    }
+
+    return true;
+}
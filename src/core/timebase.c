@@ -0,0 +1,100 @@
+#include "core/timebase.h"
+
+#if (TIM_APB1_CLK_FREQ % TIMEBASE_TICK_HZ) != 0
+#error "TIM5 clock must be a whole multiple of TIMEBASE_TICK_HZ"
+#endif
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static volatile uint32_t wrap_count = 0;    // Upper 32 bits, ISR-owned
+
+/* ============================================
+   Timebase Initialization
+   ============================================ */
+
+/**
+ * @brief Initialize TIM5 as a free-running 32-bit microsecond counter
+ *
+ * Configuration:
+ * - PSC = TIM_APB1_CLK_FREQ / 1 MHz - 1, ARR = 0xFFFFFFFF
+ * - Slave mode disabled, TS = 000 (ITR0 = TIM2 TRGO) until changed
+ * - CC1S = 11: IC1 on TRC, rising edge, no interrupt
+ * - Update interrupt counts wraps
+ */
+void timebase_init(void) {
+    RCC->APB1ENR |= RCC_APB1ENR_TIM5EN;
+
+    TIM5->CR1 = 0;
+    TIM5->PSC = TIMEBASE_PRESCALER;
+    TIM5->ARR = 0xFFFFFFFFUL;
+
+    // Capture every sampling trigger into CCR1
+    TIM5->SMCR = 0;
+    TIM5->CCMR1 = (3U << TIM_CCMR1_CC1S_Pos);
+    TIM5->CCER = TIM_CCER_CC1E;
+
+    // Load PSC now, then drop the resulting update flag
+    TIM5->EGR = TIM_EGR_UG;
+    TIM5->SR = 0;
+    wrap_count = 0;
+
+    TIM5->DIER = TIM_DIER_UIE;
+    NVIC_SetPriority(TIM5_IRQn, INTERRUPT_PRIORITY);
+    NVIC_EnableIRQ(TIM5_IRQn);
+
+    TIM5->CR1 = TIM_CR1_CEN;
+}
+
+void timebase_set_trigger_source(uint8_t itr) {
+    // Slave mode stays disabled; TS only picks what TRC (and CC1) sees
+    TIM5->SMCR = ((uint32_t)itr << TIM_SMCR_TS_Pos) & TIM_SMCR_TS;
+}
+
+/* ============================================
+   Time Access
+   ============================================ */
+
+uint64_t timebase_now_us(void) {
+    uint32_t high;
+    uint32_t low;
+    bool wrap_pending;
+
+    // Retry if the wrap interrupt ran between the reads
+    do {
+        high = wrap_count;
+        low = TIM5->CNT;
+        wrap_pending = (TIM5->SR & TIM_SR_UIF) != 0;
+    } while (high != wrap_count);
+
+    // A pending wrap belongs to this read only if CNT was read after it
+    if (wrap_pending && low < 0x80000000UL) {
+        high++;
+    }
+
+    return ((uint64_t)high << 32) | low;
+}
+
+uint64_t timebase_now_ms(void) {
+    return timebase_now_us() / 1000U;
+}
+
+uint64_t timebase_extend_us(uint32_t stamp_us) {
+    uint64_t now = timebase_now_us();
+    uint32_t age = (uint32_t)now - stamp_us;    // Wrap-safe
+    return now - age;
+}
+
+/* ============================================
+   Interrupt Handler
+   ============================================ */
+
+/**
+ * @brief TIM5 interrupt: the 32-bit counter wrapped
+ */
+void TIM5_IRQHandler(void) {
+    if (TIM5->SR & TIM_SR_UIF) {
+        TIM5->SR = ~TIM_SR_UIF;
+        wrap_count++;
+    }
+}
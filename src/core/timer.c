@@ -0,0 +1,128 @@
+#include "core/timer.h"
+
+#if (TIM_APB1_CLK_FREQ % TIM3_TICK_HZ) != 0
+#error "TIM3 clock must be a whole multiple of TIM3_TICK_HZ"
+#endif
+
+#define TIM_OC1M_FORCED_LOW 4U          // OC1REF held inactive
+#define TIM_OC1M_PWM1 6U                // OC1REF high while CNT < CCR1
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static timer_source_t source = TIMER_SOURCE_TIM2;
+static TIM_TypeDef *trigger_timer = NULL;
+
+/* ============================================
+   Timer Initialization
+   ============================================ */
+
+/**
+ * @brief Initialize TIM2 for the sampling trigger, TIM3 as the fast one
+ *
+ * Frequency:
+ * f = TIM_APB1_CLK_FREQ / ((PSC + 1) × (ARR + 1))
+ *   = 100MHz / (10000 × 100) = 100 Hz   (100 MHz profile)
+ *   = 16MHz / (1600 × 100)   = 100 Hz   (HSI profile)
+ */
+void timer_init(void) {
+    // Enable TIM2 and TIM3 clocks (APB1)
+    RCC->APB1ENR |= RCC_APB1ENR_TIM2EN | RCC_APB1ENR_TIM3EN;
+
+    TIM2->CR1 = 0;
+    TIM2->PSC = TIM2_PRESCALER;
+    TIM2->ARR = TIM2_PERIOD;
+
+    // MMS = 010: update event drives TRGO
+    TIM2->CR2 &= ~TIM_CR2_MMS;
+    TIM2->CR2 |= (2U << 4);
+
+    // Load PSC/ARR now, then drop the resulting update flag
+    TIM2->EGR = TIM_EGR_UG;
+    TIM2->SR = 0;
+
+    // TIM3 idles until selected; its TRGO mode is set by timer_select()
+    TIM3->CR1 = 0;
+    TIM3->PSC = TIM3_PRESCALER;
+    TIM3->CCMR1 = (TIM_OC1M_FORCED_LOW << TIM_CCMR1_OC1M_Pos);
+    TIM3->EGR = TIM_EGR_UG;
+    TIM3->SR = 0;
+
+    source = TIMER_SOURCE_TIM2;
+    trigger_timer = TIM2;
+}
+
+void timer_select(timer_source_t new_source) {
+    TIM2->CR1 &= ~TIM_CR1_CEN;
+    TIM3->CR1 &= ~TIM_CR1_CEN;
+    TIM3->CCMR1 = (TIM_OC1M_FORCED_LOW << TIM_CCMR1_OC1M_Pos);
+
+    // MMS = 010: update event, MMS = 100: OC1REF drives TRGO
+    TIM3->CR2 &= ~TIM_CR2_MMS;
+    TIM3->CR2 |= ((new_source == TIMER_SOURCE_TIM3_PAIRED) ? 4U : 2U) << 4;
+
+    source = new_source;
+    trigger_timer = (source == TIMER_SOURCE_TIM2) ? TIM2
+                  : (source == TIMER_SOURCE_NONE) ? NULL : TIM3;
+}
+
+void timer_start(void) {
+    if (trigger_timer == NULL) {
+        return;
+    }
+
+    // OC1REF was held low while stopped, so the first edge is a rising one
+    if (source == TIMER_SOURCE_TIM3_PAIRED) {
+        TIM3->CCMR1 = (TIM_OC1M_PWM1 << TIM_CCMR1_OC1M_Pos);
+    }
+    trigger_timer->CNT = 0;
+    trigger_timer->CR1 |= TIM_CR1_CEN;
+}
+
+void timer_stop(void) {
+    if (trigger_timer == NULL) {
+        return;
+    }
+
+    trigger_timer->CR1 &= ~TIM_CR1_CEN;
+    if (source == TIMER_SOURCE_TIM3_PAIRED) {
+        TIM3->CCMR1 = (TIM_OC1M_FORCED_LOW << TIM_CCMR1_OC1M_Pos);
+    }
+}
+
+bool timer_set_rate(uint32_t rate_hz) {
+    uint32_t tick_hz = (source == TIMER_SOURCE_TIM2) ? TIM2_TICK_HZ : TIM3_TICK_HZ;
+    uint32_t edges = (source == TIMER_SOURCE_TIM3_PAIRED) ? 2U : 1U;
+
+    if (trigger_timer == NULL || rate_hz == 0 || rate_hz > tick_hz || (tick_hz % rate_hz) != 0) {
+        return false;
+    }
+
+    // Counts per timer period; a counter with ARR = 0 never runs
+    uint32_t period = edges * (tick_hz / rate_hz);
+    if (period < 2U || (source != TIMER_SOURCE_TIM2 && period > 0x10000UL)) {
+        return false;
+    }
+
+    // ARR is not preloaded: stop first so CNT can never be left above it
+    bool running = (trigger_timer->CR1 & TIM_CR1_CEN) != 0;
+    trigger_timer->CR1 &= ~TIM_CR1_CEN;
+    trigger_timer->ARR = period - 1U;
+    trigger_timer->CCR1 = period / 2U;          // Falling edge mid-period (paired)
+    trigger_timer->CNT = 0;
+    if (running) {
+        trigger_timer->CR1 |= TIM_CR1_CEN;
+    }
+
+    return true;
+}
+
+uint32_t timer_get_rate(void) {
+    if (trigger_timer == NULL) {
+        return 0;
+    }
+
+    uint32_t tick_hz = (source == TIMER_SOURCE_TIM2) ? TIM2_TICK_HZ : TIM3_TICK_HZ;
+    uint32_t edges = (source == TIMER_SOURCE_TIM3_PAIRED) ? 2U : 1U;
+    return (edges * tick_hz) / (trigger_timer->ARR + 1U);
+}
@@ -0,0 +1,475 @@
+#include "core/uart.h"
+#include "utils/profile.h"
+#include "utils/memory.h"
+#include <string.h>
+
+#if (UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1)) != 0
+#error "UART_TX_BUFFER_SIZE must be a power of two"
+#endif
+
+#if UART_RX_BUFFER_SIZE < 4 || (UART_RX_BUFFER_SIZE & 1) != 0
+#error "UART_RX_BUFFER_SIZE must be even (HT marks the middle)"
+#endif
+
+#define UART_TX_MASK (UART_TX_BUFFER_SIZE - 1U)
+
+/* ============================================
+   Static Variables
+   ============================================ */
+
+// TX byte ring. head is owned by the producer (main loop), tail by the
+// DMA completion ISR. Indices run free and are masked on access.
+// Both rings are drawn from the arena by uart_init().
+static uint8_t *tx_ring = NULL;
+static volatile uint16_t tx_head = 0;
+static volatile uint16_t tx_tail = 0;
+static volatile uint16_t tx_dma_length = 0;    // Bytes in flight, 0 = idle
+static volatile uint32_t tx_dropped = 0;
+static uint16_t tx_high_water = 0;             // Peak queued bytes (producer-owned)
+static void (*volatile tx_idle_callback)(void) = NULL;
+static volatile uart_tx_route_t tx_route = UART_TX_ROUTE_USART;
+static void (*volatile tx_kick)(void) = NULL;  // External drain (UART_TX_ROUTE_EXTERNAL)
+
+// RX byte ring, filled by DMA2 Stream5 in circular mode. rx_received
+// counts every byte the ISRs have seen land; rx_read is the consumer's
+// position. Both run free; the ring index is the count modulo the size.
+static volatile uint8_t *rx_ring = NULL;
+static volatile uint32_t rx_received = 0;      // ISR-owned
+static uint32_t rx_read = 0;                   // Consumer-owned
+static uint16_t rx_dma_pos = 0;                // Last DMA write index seen (ISR-owned)
+static uint32_t rx_dropped = 0;                // Bytes overwritten before being read
+static volatile uint32_t rx_errors = 0;        // Overrun / framing / noise events
+static void (*volatile rx_callback)(void) = NULL;
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+/**
+ * @brief Hand the next contiguous span of the ring to DMA
+ *
+ * Must be called with the DMA stream idle and interrupts masked
+ * (or from the stream's own ISR).
+ */
+static void uart_tx_start_dma(void) {
+    uint16_t pending = (uint16_t)(tx_head - tx_tail);
+    if (pending == 0) {
+        tx_dma_length = 0;
+        return;
+    }
+
+    // Stop at the end of the ring; the wrapped part goes in the next transfer
+    uint16_t offset = tx_tail & UART_TX_MASK;
+    uint16_t span = UART_TX_BUFFER_SIZE - offset;
+    if (span > pending) {
+        span = pending;
+    }
+
+    tx_dma_length = span;
+
+    DMA2->HIFCR = DMA_HIFCR_CTCIF7 | DMA_HIFCR_CHTIF7 | DMA_HIFCR_CTEIF7
+                | DMA_HIFCR_CDMEIF7 | DMA_HIFCR_CFEIF7;
+    DMA2_Stream7->M0AR = (uint32_t)&tx_ring[offset];
+    DMA2_Stream7->NDTR = span;
+    DMA2_Stream7->CR |= DMA_SxCR_EN;
+}
+
+/**
+ * @brief Account for bytes DMA has written since the previous call
+ *
+ * Called from the RX ISRs (IDLE, HT, TC), which fire at least twice
+ * per lap of the ring, so the position never advances by a full lap
+ * unseen.
+ */
+static void uart_rx_update(void) {
+    uint16_t pos = (uint16_t)(UART_RX_BUFFER_SIZE - DMA2_Stream5->NDTR);
+    if (pos == UART_RX_BUFFER_SIZE) {
+        pos = 0;
+    }
+
+    uint16_t delta = (uint16_t)((pos + UART_RX_BUFFER_SIZE - rx_dma_pos) % UART_RX_BUFFER_SIZE);
+    rx_dma_pos = pos;
+
+    if (delta > 0) {
+        rx_received += delta;
+        if (rx_callback != NULL) {
+            rx_callback();
+        }
+    }
+}
+
+/* ============================================
+   UART Initialization
+   ============================================ */
+
+/**
+ * @brief Initialize USART1 for 8N1 at UART_BAUDRATE
+ *
+ * Configuration:
+ * - PA9: USART1_TX (AF7), PA10: USART1_RX (AF7, pull-up)
+ * - Oversampling by 16
+ * - TX via DMA2 Stream7, Channel 4, memory-to-peripheral, 8-bit
+ * - RX via DMA2 Stream5, Channel 4, circular into the RX ring; the
+ *   USART IDLE interrupt marks the end of each burst
+ */
+void uart_init(void) {
+    // Rings come from the arena once; without them the port stays off
+    if (tx_ring == NULL) {
+        tx_ring = memory_alloc(MEMORY_OWNER_UART, UART_TX_BUFFER_SIZE);
+        rx_ring = memory_alloc(MEMORY_OWNER_UART, UART_RX_BUFFER_SIZE);
+    }
+    if (tx_ring == NULL || rx_ring == NULL) {
+        tx_ring = NULL;
+        return;
+    }
+    
+    // Enable clocks
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
+    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+    RCC->APB2ENR |= RCC_APB2ENR_USART1EN;
+
+    // PA9 alternate function AF7 (USART1_TX)
+    GPIOA->MODER &= ~(3U << (9 * 2));
+    GPIOA->MODER |= (2U << (9 * 2));
+    GPIOA->AFR[1] &= ~(0xFU << ((9 - 8) * 4));
+    GPIOA->AFR[1] |= (7U << ((9 - 8) * 4));
+
+    // PA10 alternate function AF7 (USART1_RX), idle-high with pull-up
+    GPIOA->MODER &= ~(3U << (10 * 2));
+    GPIOA->MODER |= (2U << (10 * 2));
+    GPIOA->PUPDR &= ~(3U << (10 * 2));
+    GPIOA->PUPDR |= (1U << (10 * 2));
+    GPIOA->AFR[1] &= ~(0xFU << ((10 - 8) * 4));
+    GPIOA->AFR[1] |= (7U << ((10 - 8) * 4));
+
+    // Baud rate: USARTDIV = PCLK2 / (16 * baud), BRR = USARTDIV * 16
+    USART1->BRR = UART_BRR_VALUE;
+
+    // Enable TX and RX DMA requests; EIE flags overrun/framing/noise
+    USART1->CR3 |= USART_CR3_DMAT | USART_CR3_DMAR | USART_CR3_EIE;
+
+    // Enable TX, RX and UART
+    USART1->CR1 |= USART_CR1_UE | USART_CR1_TE | USART_CR1_RE;
+
+    // DMA2 Stream7: Channel 4 (USART1_TX), memory to peripheral
+    DMA2_Stream7->CR &= ~DMA_SxCR_EN;
+    while (DMA2_Stream7->CR & DMA_SxCR_EN);
+
+    DMA2_Stream7->CR = 0;
+    DMA2_Stream7->CR |= (4U << 25);         // CHSEL = 100 (Channel 4)
+    DMA2_Stream7->CR |= DMA_SxCR_PL_0;      // Priority medium (below ADC)
+    DMA2_Stream7->CR |= DMA_SxCR_DIR_0;     // Memory to peripheral
+    DMA2_Stream7->CR |= DMA_SxCR_MINC;      // Memory increment, 8-bit sizes
+    DMA2_Stream7->CR |= DMA_SxCR_TCIE;      // Transfer-complete interrupt
+    DMA2_Stream7->PAR = (uint32_t)&(USART1->DR);
+    DMA2_Stream7->FCR = 0;
+
+    tx_head = 0;
+    tx_tail = 0;
+    tx_dma_length = 0;
+    tx_dropped = 0;
+    tx_high_water = 0;
+
+    // DMA2 Stream5: Channel 4 (USART1_RX), peripheral to memory, circular
+    DMA2_Stream5->CR &= ~DMA_SxCR_EN;
+    while (DMA2_Stream5->CR & DMA_SxCR_EN);
+
+    DMA2->HIFCR = DMA_HIFCR_CTCIF5 | DMA_HIFCR_CHTIF5 | DMA_HIFCR_CTEIF5
+                | DMA_HIFCR_CDMEIF5 | DMA_HIFCR_CFEIF5;
+    DMA2_Stream5->CR = 0;
+    DMA2_Stream5->CR |= (4U << 25);         // CHSEL = 100 (Channel 4)
+    DMA2_Stream5->CR |= DMA_SxCR_PL_0;      // Priority medium (below ADC)
+    DMA2_Stream5->CR |= DMA_SxCR_MINC;      // Memory increment, 8-bit sizes
+    DMA2_Stream5->CR |= DMA_SxCR_CIRC;      // Circular mode
+    DMA2_Stream5->CR |= DMA_SxCR_HTIE | DMA_SxCR_TCIE;
+    DMA2_Stream5->PAR = (uint32_t)&(USART1->DR);
+    DMA2_Stream5->M0AR = (uint32_t)rx_ring;
+    DMA2_Stream5->NDTR = UART_RX_BUFFER_SIZE;
+    DMA2_Stream5->FCR = 0;
+
+    rx_received = 0;
+    rx_read = 0;
+    rx_dma_pos = 0;
+    rx_dropped = 0;
+    rx_errors = 0;
+
+    DMA2_Stream5->CR |= DMA_SxCR_EN;
+    USART1->CR1 |= USART_CR1_IDLEIE;
+
+    NVIC_SetPriority(DMA2_Stream7_IRQn, INTERRUPT_PRIORITY + 1);
+    NVIC_EnableIRQ(DMA2_Stream7_IRQn);
+    NVIC_SetPriority(DMA2_Stream5_IRQn, INTERRUPT_PRIORITY + 1);
+    NVIC_EnableIRQ(DMA2_Stream5_IRQn);
+    NVIC_SetPriority(USART1_IRQn, INTERRUPT_PRIORITY + 1);
+    NVIC_EnableIRQ(USART1_IRQn);
+}
+
+/* ============================================
+   Non-Blocking Transmit
+   ============================================ */
+
+bool uart_tx_write(const uint8_t *data, uint16_t length) {
+    if (data == NULL || tx_ring == NULL) {
+        return false;
+    }
+
+    if (length == 0) {
+        return true;
+    }
+
+    if (length > uart_tx_free()) {
+        tx_dropped += length;
+        return false;
+    }
+
+    // Copy in at most two spans (before and after the wrap point)
+    uint16_t offset = tx_head & UART_TX_MASK;
+    uint16_t first = UART_TX_BUFFER_SIZE - offset;
+    if (first > length) {
+        first = length;
+    }
+    memcpy(&tx_ring[offset], data, first);
+    memcpy(&tx_ring[0], data + first, length - first);
+
+    // Publish bytes before the ISR can see the new head
+    __DMB();
+    tx_head = (uint16_t)(tx_head + length);
+
+    uint16_t queued = (uint16_t)(tx_head - tx_tail);
+    if (queued > tx_high_water) {
+        tx_high_water = queued;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (tx_route == UART_TX_ROUTE_EXTERNAL) {
+        tx_kick();
+    } else if (tx_dma_length == 0) {
+        uart_tx_start_dma();
+    }
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+bool uart_send_string(const char *str) {
+    if (str == NULL) {
+        return false;
+    }
+
+    PROFILE_BEGIN(PROFILE_PROBE_UART_SEND);
+    bool queued = uart_tx_write((const uint8_t *)str, (uint16_t)strlen(str));
+    PROFILE_END(PROFILE_PROBE_UART_SEND);
+
+    return queued;
+}
+
+uint16_t uart_tx_free(void) {
+    return (uint16_t)(UART_TX_BUFFER_SIZE - (uint16_t)(tx_head - tx_tail));
+}
+
+uint16_t uart_tx_pending(void) {
+    return (uint16_t)(tx_head - tx_tail);
+}
+
+bool uart_tx_is_idle(void) {
+    return tx_dma_length == 0 && tx_head == tx_tail;
+}
+
+void uart_tx_flush(void) {
+    // Relies on the DMA ISR to chain the remaining spans
+    while (!uart_tx_is_idle());
+
+    // Wait for the last byte to leave the shift register
+    while (!(USART1->SR & USART_SR_TC));
+}
+
+uint32_t uart_tx_get_dropped(void) {
+    return tx_dropped;
+}
+
+uint16_t uart_tx_get_high_water(void) {
+    return tx_high_water;
+}
+
+uint16_t uart_tx_get_drained(void) {
+    return tx_tail;
+}
+
+void uart_set_tx_idle_callback(void (*callback)(void)) {
+    tx_idle_callback = callback;
+}
+
+bool uart_tx_set_route(uart_tx_route_t route, void (*kick)(void)) {
+    if (route == UART_TX_ROUTE_EXTERNAL && kick == NULL) {
+        return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    tx_route = route;
+    tx_kick = kick;
+    if (route == UART_TX_ROUTE_USART && tx_dma_length == 0) {
+        uart_tx_start_dma();
+    }
+    __set_PRIMASK(primask);
+
+    if (route == UART_TX_ROUTE_EXTERNAL) {
+        // The DMA ISR stops chaining; let the span in flight finish so
+        // the external drain starts exactly at tx_tail
+        while (tx_dma_length != 0);
+        __disable_irq();
+        kick();
+        __set_PRIMASK(primask);
+    }
+    return true;
+}
+
+uart_tx_route_t uart_tx_get_route(void) {
+    return tx_route;
+}
+
+uint16_t uart_tx_peek(const uint8_t **data) {
+    uint16_t pending = (uint16_t)(tx_head - tx_tail);
+    uint16_t offset = tx_tail & UART_TX_MASK;
+    uint16_t span = UART_TX_BUFFER_SIZE - offset;
+
+    *data = &tx_ring[offset];
+    return (span < pending) ? span : pending;
+}
+
+void uart_tx_consume(uint16_t length) {
+    tx_tail = (uint16_t)(tx_tail + length);
+
+    if (tx_head == tx_tail && tx_idle_callback != NULL) {
+        tx_idle_callback();
+    }
+}
+
+/* ============================================
+   Receive
+   ============================================ */
+
+uint16_t uart_rx_available(void) {
+    uint32_t pending = rx_received - rx_read;
+    return (pending > UART_RX_BUFFER_SIZE) ? UART_RX_BUFFER_SIZE : (uint16_t)pending;
+}
+
+uint16_t uart_rx_read(uint8_t *data, uint16_t max_length) {
+    if (data == NULL) {
+        return 0;
+    }
+
+    uint32_t received = rx_received;
+
+    // DMA lapped the reader: the oldest bytes are gone, resume at the
+    // oldest byte that is still intact
+    if (received - rx_read > UART_RX_BUFFER_SIZE) {
+        rx_dropped += (received - rx_read) - UART_RX_BUFFER_SIZE;
+        rx_read = received - UART_RX_BUFFER_SIZE;
+    }
+
+    uint16_t length = 0;
+    while (length < max_length && rx_read != received) {
+        data[length++] = rx_ring[rx_read % UART_RX_BUFFER_SIZE];
+        rx_read++;
+    }
+
+    return length;
+}
+
+uint32_t uart_rx_get_dropped(void) {
+    return rx_dropped;
+}
+
+uint32_t uart_rx_get_errors(void) {
+    return rx_errors;
+}
+
+void uart_set_rx_callback(void (*callback)(void)) {
+    rx_callback = callback;
+}
+
+/* ============================================
+   Blocking Transmit
+   ============================================ */
+
+void uart_send_char_blocking(char c) {
+    if ((__get_PRIMASK() & 1U) == 0) {
+        uart_tx_flush();
+    }
+
+    while (!(USART1->SR & USART_SR_TXE));
+    USART1->DR = (uint8_t)c;
+}
+
+void uart_send_string_blocking(const char *str) {
+    if (str == NULL) {
+        return;
+    }
+
+    while (*str) {
+        uart_send_char_blocking(*str++);
+    }
+}
+
+/* ============================================
+   Interrupt Handler
+   ============================================ */
+
+/**
+ * @brief DMA2 Stream7 interrupt: one span of the TX ring has been sent
+ *
+ * Releases the span and immediately chains the next one, so the ring
+ * drains without any main-loop involvement.
+ */
+void DMA2_Stream7_IRQHandler(void) {
+    PROFILE_BEGIN(PROFILE_PROBE_UART_DMA_ISR);
+
+    if (DMA2->HISR & DMA_HISR_TCIF7) {
+        DMA2->HIFCR = DMA_HIFCR_CTCIF7;
+        tx_tail = (uint16_t)(tx_tail + tx_dma_length);
+        if (tx_route == UART_TX_ROUTE_USART) {
+            uart_tx_start_dma();
+        } else {
+            tx_dma_length = 0;
+        }
+
+        if (tx_head == tx_tail && tx_idle_callback != NULL) {
+            tx_idle_callback();
+        }
+    }
+
+    PROFILE_END(PROFILE_PROBE_UART_DMA_ISR);
+}
+
+/**
+ * @brief DMA2 Stream5 interrupt: RX ring half or fully written
+ */
+void DMA2_Stream5_IRQHandler(void) {
+    uint32_t flags = DMA2->HISR & (DMA_HISR_HTIF5 | DMA_HISR_TCIF5);
+    if (flags) {
+        DMA2->HIFCR = (flags & DMA_HISR_HTIF5 ? DMA_HIFCR_CHTIF5 : 0U)
+                    | (flags & DMA_HISR_TCIF5 ? DMA_HIFCR_CTCIF5 : 0U);
+        uart_rx_update();
+    }
+}
+
+/**
+ * @brief USART1 interrupt: RX line went idle, or a receive error
+ *
+ * IDLE (and the error flags) clear on a read of SR followed by DR;
+ * DMA owns DR, so reading it here only discards the byte the error
+ * flags refer to.
+ */
+void USART1_IRQHandler(void) {
+    uint32_t sr = USART1->SR;
+
+    if (sr & (USART_SR_IDLE | USART_SR_ORE | USART_SR_FE | USART_SR_NE)) {
+        (void)USART1->DR;
+        if (sr & (USART_SR_ORE | USART_SR_FE | USART_SR_NE)) {
+            rx_errors++;
+        }
+        uart_rx_update();
+    }
+}
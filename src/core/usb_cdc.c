@@ -0,0 +1,709 @@
+#include "core/usb_cdc.h"
+#include "core/uart.h"
+#include "core/timebase.h"
+#include <stddef.h>
+#include <string.h>
+
+#if ENABLE_USB_CDC && CLOCK_PROFILE != CLOCK_PROFILE_HSE_PLL_96MHZ
+#error "ENABLE_USB_CDC needs the 48 MHz PLLQ clock of CLOCK_PROFILE_HSE_PLL_96MHZ"
+#endif
+#if ENABLE_USB_CDC && POWER_POLICY == POWER_POLICY_STOP
+#error "Stop mode halts the USB core; use POWER_POLICY_SLEEP with ENABLE_USB_CDC"
+#endif
+
+// FIFO RAM is 320 words: shared RX FIFO, then one TX FIFO per IN endpoint
+#define RX_FIFO_WORDS       128U
+#define EP0_TX_FIFO_WORDS   32U                 // Whole control reply (<= 127 bytes)
+#define EP1_TX_FIFO_WORDS   ((USB_CDC_TX_PACKETS * USB_CDC_PACKET_SIZE) / 4U)
+#define EP2_TX_FIFO_WORDS   16U
+
+#if (RX_FIFO_WORDS + EP0_TX_FIFO_WORDS + EP1_TX_FIFO_WORDS + EP2_TX_FIFO_WORDS) > 320U
+#error "USB_CDC_TX_PACKETS exceeds the OTG FS FIFO RAM"
+#endif
+
+#define TX_TRANSFER_MAX     (USB_CDC_TX_PACKETS * USB_CDC_PACKET_SIZE)
+#define ENDPOINT_COUNT      4U
+
+#define USB_GLOBAL          USB_OTG_FS
+#define USB_DEVICE          ((USB_OTG_DeviceTypeDef *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_DEVICE_BASE))
+#define USB_IN(ep)          ((USB_OTG_INEndpointTypeDef *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_IN_ENDPOINT_BASE + (ep) * USB_OTG_EP_REG_SIZE))
+#define USB_OUT(ep)         ((USB_OTG_OUTEndpointTypeDef *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_OUT_ENDPOINT_BASE + (ep) * USB_OTG_EP_REG_SIZE))
+#define USB_FIFO(ep)        (*(volatile uint32_t *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_FIFO_BASE + (ep) * USB_OTG_FIFO_SIZE))
+#define USB_PCGCCTL         (*(volatile uint32_t *)(USB_OTG_FS_PERIPH_BASE + USB_OTG_PCGCCTL_BASE))
+
+// GRXSTSP packet status
+#define PKTSTS_OUT_DATA     2U
+#define PKTSTS_SETUP_DATA   6U
+
+// Standard and CDC class requests
+#define REQUEST_TYPE_MASK       0x60U
+#define REQUEST_TYPE_STANDARD   0x00U
+#define REQUEST_TYPE_CLASS      0x20U
+#define REQ_GET_STATUS          0x00U
+#define REQ_CLEAR_FEATURE       0x01U
+#define REQ_SET_FEATURE         0x03U
+#define REQ_SET_ADDRESS         0x05U
+#define REQ_GET_DESCRIPTOR      0x06U
+#define REQ_GET_CONFIGURATION   0x08U
+#define REQ_SET_CONFIGURATION   0x09U
+#define REQ_GET_INTERFACE       0x0AU
+#define REQ_SET_INTERFACE       0x0BU
+#define CDC_SET_LINE_CODING     0x20U
+#define CDC_GET_LINE_CODING     0x21U
+#define CDC_SET_CONTROL_LINE    0x22U
+#define CDC_SEND_BREAK          0x23U
+
+#define USB_STRING_MANUFACTURER "STM32F4 DAQ"
+#define USB_STRING_PRODUCT      "STM32F411 Data Acquisition"
+#define USB_STRING_MAX_CHARS    32U
+
+typedef union {
+    struct {
+        uint8_t bmRequestType;
+        uint8_t bRequest;
+        uint16_t wValue;
+        uint16_t wIndex;
+        uint16_t wLength;
+    } request;
+    uint8_t bytes[8];
+} usb_setup_t;
+
+/* ============================================
+   Descriptors
+   ============================================ */
+static const uint8_t device_descriptor[18] = {
+    18, 0x01,                           // bLength, DEVICE
+    0x00, 0x02,                         // USB 2.0
+    0x02, 0x00, 0x00,                   // CDC class (interfaces refine it)
+    USB_CDC_PACKET_SIZE,                // EP0 max packet
+    (USB_CDC_VID & 0xFF), (USB_CDC_VID >> 8),
+    (USB_CDC_PID & 0xFF), (USB_CDC_PID >> 8),
+    0x00, 0x02,                         // bcdDevice 2.00
+    1, 2, 3,                            // Manufacturer, product, serial strings
+    1,                                  // One configuration
+};
+
+static const uint8_t config_descriptor[67] = {
+    // Configuration: 2 interfaces, bus powered, 100 mA
+    9, 0x02, 67, 0, 2, 1, 0, 0x80, 50,
+
+    // Interface 0: CDC communication class, ACM, one notification endpoint
+    9, 0x04, 0, 0, 1, 0x02, 0x02, 0x01, 0,
+    5, 0x24, 0x00, 0x10, 0x01,          // Header functional, CDC 1.10
+    5, 0x24, 0x01, 0x00, 0x01,          // Call management: data on interface 1
+    4, 0x24, 0x02, 0x02,                // ACM: line coding + control line state
+    5, 0x24, 0x06, 0, 1,                // Union: master 0, slave 1
+    7, 0x05, 0x82, 0x03, 8, 0, 16,      // EP2 IN, interrupt, 8 bytes, 16 ms
+
+    // Interface 1: CDC data, bulk OUT + IN
+    9, 0x04, 1, 0, 2, 0x0A, 0x00, 0x00, 0,
+    7, 0x05, 0x01, 0x02, USB_CDC_PACKET_SIZE, 0, 0,     // EP1 OUT
+    7, 0x05, 0x81, 0x02, USB_CDC_PACKET_SIZE, 0, 0,     // EP1 IN
+};
+
+static const uint8_t language_descriptor[4] = { 4, 0x03, 0x09, 0x04 };  // en-US
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static usb_setup_t setup;
+static uint8_t ep0_out[USB_CDC_PACKET_SIZE];
+static uint16_t ep0_out_length = 0;
+static uint8_t pending_request = 0;             // Class request awaiting its OUT data stage
+static uint8_t config_value = 0;
+static uint8_t string_descriptor[2 + 2 * USB_STRING_MAX_CHARS];
+static char serial_number[25];                  // 96-bit unique ID in hex
+
+// 115200 8N1 by default; stored and reported back, never applied
+static uint8_t line_coding[7] = { 0x00, 0xC2, 0x01, 0x00, 0, 0, 8 };
+
+static volatile bool configured = false;
+static volatile bool suspended = false;
+static volatile bool dtr = false;
+static bool tx_busy = false;                    // EP1 IN transfer in progress
+static bool tx_zlp_due = false;                 // Last transfer ended on a full packet
+
+static usb_cdc_stats_t stats;
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static void delay_us(uint32_t us) {
+    uint32_t start = timebase_now_us32();
+    while ((timebase_now_us32() - start) < us);
+}
+
+static void flush_tx_fifo(uint32_t fifo) {
+    USB_GLOBAL->GRSTCTL = USB_OTG_GRSTCTL_TXFFLSH | (fifo << USB_OTG_GRSTCTL_TXFNUM_Pos);
+    while (USB_GLOBAL->GRSTCTL & USB_OTG_GRSTCTL_TXFFLSH);
+}
+
+static void flush_rx_fifo(void) {
+    USB_GLOBAL->GRSTCTL = USB_OTG_GRSTCTL_RXFFLSH;
+    while (USB_GLOBAL->GRSTCTL & USB_OTG_GRSTCTL_RXFFLSH);
+}
+
+/**
+ * @brief Push bytes into an IN endpoint's TX FIFO (whole words, zero padded)
+ */
+static void fifo_write(uint8_t ep, const uint8_t *data, uint16_t length) {
+    volatile uint32_t *fifo = &USB_FIFO(ep);
+
+    for (uint16_t i = 0; i < length; i += 4U) {
+        uint32_t word = 0;
+        uint16_t n = (uint16_t)(length - i);
+        if (n > 4U) {
+            n = 4U;
+        }
+        memcpy(&word, &data[i], n);
+        *fifo = word;
+    }
+}
+
+/**
+ * @brief Pop a received packet from the shared RX FIFO
+ * @param data Destination, NULL to discard
+ * @param length Packet bytes (all are popped)
+ * @param max Destination size
+ */
+static void fifo_read(uint8_t *data, uint16_t length, uint16_t max) {
+    volatile uint32_t *fifo = &USB_FIFO(0);
+
+    for (uint16_t i = 0; i < length; i += 4U) {
+        uint32_t word = *fifo;
+        for (uint16_t b = 0; b < 4U && (i + b) < length && (i + b) < max && data != NULL; b++) {
+            data[i + b] = (uint8_t)(word >> (8U * b));
+        }
+    }
+}
+
+static void ep0_arm_out(void) {
+    USB_OUT(0)->DOEPTSIZ = (3U << USB_OTG_DOEPTSIZ_STUPCNT_Pos)
+                         | (1U << USB_OTG_DOEPTSIZ_PKTCNT_Pos)
+                         | USB_CDC_PACKET_SIZE;
+    USB_OUT(0)->DOEPCTL |= USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+}
+
+static void ep0_send(const uint8_t *data, uint16_t length) {
+    uint32_t packets = (length == 0) ? 1U : (length + USB_CDC_PACKET_SIZE - 1U) / USB_CDC_PACKET_SIZE;
+
+    USB_IN(0)->DIEPTSIZ = (packets << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | length;
+    USB_IN(0)->DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+    fifo_write(0, data, length);
+}
+
+static void ep0_stall(void) {
+    // The core clears EP0 STALL by itself on the next SETUP
+    USB_IN(0)->DIEPCTL |= USB_OTG_DIEPCTL_STALL;
+    USB_OUT(0)->DOEPCTL |= USB_OTG_DOEPCTL_STALL;
+    stats.stalls++;
+}
+
+static void ep1_arm_out(void) {
+    USB_OUT(1)->DOEPTSIZ = (1U << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | USB_CDC_PACKET_SIZE;
+    USB_OUT(1)->DOEPCTL |= USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+}
+
+/**
+ * @brief Stop a pending EP1 IN transfer the host is no longer polling for
+ */
+static void tx_abort(void) {
+    if (USB_IN(1)->DIEPCTL & USB_OTG_DIEPCTL_EPENA) {
+        USB_IN(1)->DIEPCTL |= USB_OTG_DIEPCTL_SNAK;
+        while (!(USB_IN(1)->DIEPINT & USB_OTG_DIEPINT_INEPNE));
+        USB_IN(1)->DIEPCTL |= USB_OTG_DIEPCTL_EPDIS;
+        while (!(USB_IN(1)->DIEPINT & USB_OTG_DIEPINT_EPDISD));
+        USB_IN(1)->DIEPINT = USB_OTG_DIEPINT_INEPNE | USB_OTG_DIEPINT_EPDISD;
+    }
+    flush_tx_fifo(1);
+    tx_busy = false;
+    tx_zlp_due = false;
+}
+
+/**
+ * @brief Move the next span of the TX ring into the EP1 FIFO
+ *
+ * Runs from the OTG ISR or as the uart_tx_set_route() kick (interrupts
+ * masked). With nobody listening the ring is drained and discarded,
+ * like an unconnected UART line, so producers never back up.
+ */
+static void tx_start(void) {
+    const uint8_t *data;
+    uint16_t length;
+
+    if (uart_tx_get_route() != UART_TX_ROUTE_EXTERNAL) {
+        return;
+    }
+
+    if (!configured || suspended || !dtr) {
+        while ((length = uart_tx_peek(&data)) > 0) {
+            uart_tx_consume(length);
+            stats.discarded += length;
+        }
+        return;
+    }
+
+    if (tx_busy) {
+        return;
+    }
+
+    length = uart_tx_peek(&data);
+    if (length == 0) {
+        if (tx_zlp_due) {
+            // Close a transfer that ended on a full packet
+            tx_zlp_due = false;
+            tx_busy = true;
+            USB_IN(1)->DIEPTSIZ = (1U << USB_OTG_DIEPTSIZ_PKTCNT_Pos);
+            USB_IN(1)->DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+        }
+        return;
+    }
+
+    if (length > TX_TRANSFER_MAX) {
+        length = TX_TRANSFER_MAX;
+    }
+    uint32_t packets = (length + USB_CDC_PACKET_SIZE - 1U) / USB_CDC_PACKET_SIZE;
+
+    USB_IN(1)->DIEPTSIZ = (packets << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | length;
+    USB_IN(1)->DIEPCTL |= USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK;
+    fifo_write(1, data, length);
+    uart_tx_consume(length);
+
+    tx_busy = true;
+    tx_zlp_due = (length % USB_CDC_PACKET_SIZE) == 0;
+    stats.tx_bytes += length;
+}
+
+static void set_dtr(bool asserted) {
+    if (!asserted && tx_busy) {
+        tx_abort();
+    }
+    dtr = asserted;
+    tx_start();
+}
+
+/**
+ * @brief Activate the bulk and interrupt endpoints (SET_CONFIGURATION 1)
+ */
+static void configure_endpoints(void) {
+    USB_OUT(1)->DOEPCTL = USB_OTG_DOEPCTL_USBAEP | (2U << USB_OTG_DOEPCTL_EPTYP_Pos)
+                        | USB_OTG_DOEPCTL_SD0PID_SEVNFRM | USB_CDC_PACKET_SIZE;
+    ep1_arm_out();
+
+    USB_IN(1)->DIEPCTL = USB_OTG_DIEPCTL_USBAEP | (2U << USB_OTG_DIEPCTL_EPTYP_Pos)
+                       | (1U << USB_OTG_DIEPCTL_TXFNUM_Pos)
+                       | USB_OTG_DIEPCTL_SD0PID_SEVNFRM | USB_CDC_PACKET_SIZE;
+    USB_IN(2)->DIEPCTL = USB_OTG_DIEPCTL_USBAEP | (3U << USB_OTG_DIEPCTL_EPTYP_Pos)
+                       | (2U << USB_OTG_DIEPCTL_TXFNUM_Pos)
+                       | USB_OTG_DIEPCTL_SD0PID_SEVNFRM | 8U;
+
+    USB_DEVICE->DAINTMSK |= (1U << 1) | (1U << 17);     // EP1 IN, EP1 OUT
+    tx_busy = false;
+    tx_zlp_due = false;
+    configured = true;
+}
+
+static void deconfigure_endpoints(void) {
+    configured = false;
+    dtr = false;
+    for (uint8_t ep = 1; ep < ENDPOINT_COUNT; ep++) {
+        USB_IN(ep)->DIEPCTL &= ~USB_OTG_DIEPCTL_USBAEP;
+        USB_OUT(ep)->DOEPCTL &= ~USB_OTG_DOEPCTL_USBAEP;
+    }
+    USB_DEVICE->DAINTMSK &= ~((1U << 1) | (1U << 17));
+    flush_tx_fifo(0x10);
+    tx_busy = false;
+    tx_zlp_due = false;
+}
+
+static const uint8_t *build_string(const char *text, uint16_t *length) {
+    uint16_t n = 0;
+
+    while (text[n] != '\0' && n < USB_STRING_MAX_CHARS) {
+        string_descriptor[2 + 2 * n] = (uint8_t)text[n];
+        string_descriptor[3 + 2 * n] = 0;
+        n++;
+    }
+    string_descriptor[0] = (uint8_t)(2 + 2 * n);
+    string_descriptor[1] = 0x03;
+    *length = string_descriptor[0];
+    return string_descriptor;
+}
+
+static const uint8_t *get_descriptor(uint16_t value, uint16_t *length) {
+    switch (value >> 8) {
+        case 0x01:
+            *length = sizeof(device_descriptor);
+            return device_descriptor;
+        case 0x02:
+            *length = sizeof(config_descriptor);
+            return config_descriptor;
+        case 0x03:
+            switch (value & 0xFF) {
+                case 0:
+                    *length = sizeof(language_descriptor);
+                    return language_descriptor;
+                case 1:
+                    return build_string(USB_STRING_MANUFACTURER, length);
+                case 2:
+                    return build_string(USB_STRING_PRODUCT, length);
+                case 3:
+                    return build_string(serial_number, length);
+                default:
+                    return NULL;
+            }
+        default:
+            // Includes DEVICE_QUALIFIER: a full-speed-only device stalls it
+            return NULL;
+    }
+}
+
+/**
+ * @brief Answer one SETUP packet (data stage IN, status ZLP, or stall)
+ */
+static void handle_setup(void) {
+    static const uint8_t zero[2] = { 0, 0 };
+    const uint8_t *reply = NULL;
+    uint16_t length = 0;
+    bool ok = true;
+
+    pending_request = 0;
+    ep0_out_length = 0;
+
+    if ((setup.request.bmRequestType & REQUEST_TYPE_MASK) == REQUEST_TYPE_STANDARD) {
+        switch (setup.request.bRequest) {
+            case REQ_GET_STATUS:
+                reply = zero;
+                length = 2;
+                break;
+            case REQ_CLEAR_FEATURE:
+            case REQ_SET_FEATURE:
+            case REQ_SET_INTERFACE:
+                break;
+            case REQ_SET_ADDRESS:
+                // OTG core: program DAD now, status stage goes out at address 0
+                USB_DEVICE->DCFG = (USB_DEVICE->DCFG & ~USB_OTG_DCFG_DAD)
+                                 | ((uint32_t)(setup.request.wValue & 0x7FU) << USB_OTG_DCFG_DAD_Pos);
+                break;
+            case REQ_GET_DESCRIPTOR:
+                reply = get_descriptor(setup.request.wValue, &length);
+                ok = (reply != NULL);
+                break;
+            case REQ_GET_CONFIGURATION:
+                reply = &config_value;
+                length = 1;
+                break;
+            case REQ_SET_CONFIGURATION:
+                if (setup.request.wValue == 1) {
+                    config_value = 1;
+                    configure_endpoints();
+                } else if (setup.request.wValue == 0) {
+                    config_value = 0;
+                    deconfigure_endpoints();
+                } else {
+                    ok = false;
+                }
+                break;
+            case REQ_GET_INTERFACE:
+                reply = zero;
+                length = 1;
+                break;
+            default:
+                ok = false;
+                break;
+        }
+    } else if ((setup.request.bmRequestType & REQUEST_TYPE_MASK) == REQUEST_TYPE_CLASS) {
+        switch (setup.request.bRequest) {
+            case CDC_SET_LINE_CODING:
+                if (setup.request.wLength > 0) {
+                    pending_request = CDC_SET_LINE_CODING;
+                    return;                     // Status after the OUT data stage
+                }
+                break;
+            case CDC_GET_LINE_CODING:
+                reply = line_coding;
+                length = sizeof(line_coding);
+                break;
+            case CDC_SET_CONTROL_LINE:
+                set_dtr((setup.request.wValue & 0x01U) != 0);
+                break;
+            case CDC_SEND_BREAK:
+                break;
+            default:
+                ok = false;
+                break;
+        }
+    } else {
+        ok = false;
+    }
+
+    if (!ok) {
+        ep0_stall();
+        return;
+    }
+    if (length > setup.request.wLength) {
+        length = setup.request.wLength;
+    }
+    ep0_send(reply, length);
+}
+
+/**
+ * @brief EP0 OUT transfer done: data stage of a class request, or a status ZLP
+ */
+static void ep0_out_done(void) {
+    if (pending_request == CDC_SET_LINE_CODING && ep0_out_length >= sizeof(line_coding)) {
+        memcpy(line_coding, ep0_out, sizeof(line_coding));
+        pending_request = 0;
+        ep0_send(NULL, 0);
+    }
+}
+
+static void bus_reset(void) {
+    stats.resets++;
+    suspended = false;
+    config_value = 0;
+    deconfigure_endpoints();
+
+    USB_DEVICE->DCTL &= ~USB_OTG_DCTL_RWUSIG;
+    for (uint8_t ep = 0; ep < ENDPOINT_COUNT; ep++) {
+        USB_IN(ep)->DIEPINT = 0xFFU;
+        USB_OUT(ep)->DOEPINT = 0xFFU;
+        USB_OUT(ep)->DOEPCTL |= USB_OTG_DOEPCTL_SNAK;
+    }
+    USB_DEVICE->DAINTMSK = (1U << 0) | (1U << 16);      // EP0 IN, EP0 OUT
+    USB_DEVICE->DCFG &= ~USB_OTG_DCFG_DAD;
+    ep0_arm_out();
+}
+
+/**
+ * @brief Pop one entry of the shared RX FIFO
+ */
+static void rx_level(void) {
+    uint32_t status = USB_GLOBAL->GRXSTSP;
+    uint8_t ep = (uint8_t)(status & USB_OTG_GRXSTSP_EPNUM);
+    uint16_t count = (uint16_t)((status & USB_OTG_GRXSTSP_BCNT) >> USB_OTG_GRXSTSP_BCNT_Pos);
+    uint32_t type = (status & USB_OTG_GRXSTSP_PKTSTS) >> USB_OTG_GRXSTSP_PKTSTS_Pos;
+
+    if (type == PKTSTS_SETUP_DATA) {
+        fifo_read(setup.bytes, count, sizeof(setup.bytes));
+    } else if (type == PKTSTS_OUT_DATA && ep == 0) {
+        fifo_read(ep0_out, count, sizeof(ep0_out));
+        ep0_out_length = (count < sizeof(ep0_out)) ? count : sizeof(ep0_out);
+    } else if (type == PKTSTS_OUT_DATA) {
+        fifo_read(NULL, count, 0);
+        stats.rx_bytes += count;
+    }
+    // Transfer/setup-complete entries carry no data; OEPINT handles them
+}
+
+static void out_endpoints(void) {
+    uint32_t daint = USB_DEVICE->DAINT & USB_DEVICE->DAINTMSK;
+
+    if (daint & (1U << 16)) {
+        uint32_t flags = USB_OUT(0)->DOEPINT;
+        USB_OUT(0)->DOEPINT = flags;
+
+        if (flags & USB_OTG_DOEPINT_XFRC) {
+            ep0_out_done();
+        }
+        if (flags & USB_OTG_DOEPINT_STUP) {
+            handle_setup();
+        }
+        ep0_arm_out();
+    }
+
+    if (daint & (1U << 17)) {
+        uint32_t flags = USB_OUT(1)->DOEPINT;
+        USB_OUT(1)->DOEPINT = flags;
+
+        if (flags & USB_OTG_DOEPINT_XFRC) {
+            ep1_arm_out();
+        }
+    }
+}
+
+static void in_endpoints(void) {
+    uint32_t daint = USB_DEVICE->DAINT & USB_DEVICE->DAINTMSK;
+
+    if (daint & (1U << 0)) {
+        USB_IN(0)->DIEPINT = USB_IN(0)->DIEPINT;
+    }
+
+    if (daint & (1U << 1)) {
+        uint32_t flags = USB_IN(1)->DIEPINT;
+        USB_IN(1)->DIEPINT = flags;
+
+        if (flags & USB_OTG_DIEPINT_XFRC) {
+            tx_busy = false;
+            stats.transfers++;
+            tx_start();
+        }
+    }
+}
+
+static void make_serial_number(void) {
+    static const char hex[] = "0123456789ABCDEF";
+    const volatile uint32_t *uid = (const volatile uint32_t *)UID_BASE;
+
+    for (uint8_t w = 0; w < 3; w++) {
+        uint32_t word = uid[w];
+        for (uint8_t d = 0; d < 8; d++) {
+            serial_number[w * 8 + d] = hex[(word >> (28U - 4U * d)) & 0xFU];
+        }
+    }
+    serial_number[24] = '\0';
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+/**
+ * @brief Bring up OTG FS as a full-speed device
+ *
+ * Configuration:
+ * - PA11 (DM), PA12 (DP): AF10, very high speed
+ * - Internal FS PHY, forced device mode, no VBUS sensing
+ * - FIFOs: RX 128 words, EP0 TX 32, EP1 TX USB_CDC_TX_PACKETS packets, EP2 TX 16
+ * - Interrupts: reset, enumeration done, RX FIFO level, IN/OUT endpoints,
+ *   suspend and wakeup
+ */
+bool usb_cdc_init(void) {
+    if ((RCC->CFGR & RCC_CFGR_SWS) != RCC_CFGR_SWS_PLL) {
+        return false;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    make_serial_number();
+
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;
+    for (uint32_t pin = 11; pin <= 12; pin++) {
+        GPIOA->MODER &= ~(3U << (pin * 2));
+        GPIOA->MODER |= (2U << (pin * 2));
+        GPIOA->OSPEEDR |= (3U << (pin * 2));
+        GPIOA->AFR[1] &= ~(0xFU << ((pin - 8) * 4));
+        GPIOA->AFR[1] |= (10U << ((pin - 8) * 4));
+    }
+    RCC->AHB2ENR |= RCC_AHB2ENR_OTGFSEN;
+
+    // Core soft reset once the AHB master is idle
+    while (!(USB_GLOBAL->GRSTCTL & USB_OTG_GRSTCTL_AHBIDL));
+    USB_GLOBAL->GRSTCTL |= USB_OTG_GRSTCTL_CSRST;
+    while (USB_GLOBAL->GRSTCTL & USB_OTG_GRSTCTL_CSRST);
+
+    // Power up the PHY; PA9 is USART1 TX, so VBUS is not sensed
+    USB_GLOBAL->GCCFG = USB_OTG_GCCFG_PWRDWN | USB_OTG_GCCFG_NOVBUSSENS;
+
+    // Forced device mode (takes effect after 25 ms); TRDT 6 for HCLK >= 32 MHz
+    USB_GLOBAL->GUSBCFG = (USB_GLOBAL->GUSBCFG & ~(USB_OTG_GUSBCFG_FHMOD | USB_OTG_GUSBCFG_TRDT))
+                        | USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_PHYSEL
+                        | (6U << USB_OTG_GUSBCFG_TRDT_Pos);
+    delay_us(25000);
+
+    USB_PCGCCTL = 0;
+    USB_DEVICE->DCFG |= USB_OTG_DCFG_DSPD;              // 11 = full speed, internal PHY
+    USB_DEVICE->DCTL |= USB_OTG_DCTL_SDIS;              // Stay off the bus until ready
+
+    USB_GLOBAL->GRXFSIZ = RX_FIFO_WORDS;
+    USB_GLOBAL->DIEPTXF0_HNPTXFSIZ = (EP0_TX_FIFO_WORDS << 16) | RX_FIFO_WORDS;
+    USB_GLOBAL->DIEPTXF[0] = (EP1_TX_FIFO_WORDS << 16) | (RX_FIFO_WORDS + EP0_TX_FIFO_WORDS);
+    USB_GLOBAL->DIEPTXF[1] = (EP2_TX_FIFO_WORDS << 16)
+                           | (RX_FIFO_WORDS + EP0_TX_FIFO_WORDS + EP1_TX_FIFO_WORDS);
+    flush_tx_fifo(0x10);
+    flush_rx_fifo();
+
+    USB_DEVICE->DIEPMSK = USB_OTG_DIEPMSK_XFRCM;
+    USB_DEVICE->DOEPMSK = USB_OTG_DOEPMSK_STUPM | USB_OTG_DOEPMSK_XFRCM;
+    USB_DEVICE->DAINTMSK = 0;
+
+    USB_GLOBAL->GINTSTS = 0xBFFFFFFFUL;
+    USB_GLOBAL->GINTMSK = USB_OTG_GINTMSK_USBRST | USB_OTG_GINTMSK_ENUMDNEM
+                        | USB_OTG_GINTMSK_RXFLVLM | USB_OTG_GINTMSK_IEPINT
+                        | USB_OTG_GINTMSK_OEPINT | USB_OTG_GINTMSK_USBSUSPM
+                        | USB_OTG_GINTMSK_WUIM;
+    USB_GLOBAL->GAHBCFG |= USB_OTG_GAHBCFG_GINT;
+
+    NVIC_SetPriority(OTG_FS_IRQn, INTERRUPT_PRIORITY + 1);
+    NVIC_EnableIRQ(OTG_FS_IRQn);
+
+    // Connect: the host sees DP pulled up and starts enumeration
+    USB_DEVICE->DCTL &= ~USB_OTG_DCTL_SDIS;
+    return true;
+}
+
+void usb_cdc_set_output(bool enable) {
+    if (enable) {
+        uart_tx_set_route(UART_TX_ROUTE_EXTERNAL, tx_start);
+    } else {
+        uart_tx_set_route(UART_TX_ROUTE_USART, NULL);
+    }
+}
+
+bool usb_cdc_is_configured(void) {
+    return configured && !suspended;
+}
+
+bool usb_cdc_is_open(void) {
+    return configured && !suspended && dtr;
+}
+
+void usb_cdc_get_stats(usb_cdc_stats_t *out) {
+    if (out == NULL) {
+        return;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = stats;
+    __set_PRIMASK(primask);
+}
+
+/* ============================================
+   Interrupt Handler
+   ============================================ */
+
+/**
+ * @brief OTG FS interrupt: bus events, control transfers, bulk IN refill
+ */
+void OTG_FS_IRQHandler(void) {
+    uint32_t status = USB_GLOBAL->GINTSTS & USB_GLOBAL->GINTMSK;
+
+    if (status & USB_OTG_GINTSTS_USBRST) {
+        USB_GLOBAL->GINTSTS = USB_OTG_GINTSTS_USBRST;
+        bus_reset();
+    }
+
+    if (status & USB_OTG_GINTSTS_ENUMDNE) {
+        USB_GLOBAL->GINTSTS = USB_OTG_GINTSTS_ENUMDNE;
+        USB_IN(0)->DIEPCTL &= ~USB_OTG_DIEPCTL_MPSIZ;   // 00 = 64 bytes
+        USB_DEVICE->DCTL |= USB_OTG_DCTL_CGINAK;
+    }
+
+    // Mask RXFLVL while popping so it cannot re-enter mid-packet
+    while (USB_GLOBAL->GINTSTS & USB_OTG_GINTSTS_RXFLVL) {
+        USB_GLOBAL->GINTMSK &= ~USB_OTG_GINTMSK_RXFLVLM;
+        rx_level();
+        USB_GLOBAL->GINTMSK |= USB_OTG_GINTMSK_RXFLVLM;
+    }
+
+    if (status & USB_OTG_GINTSTS_OEPINT) {
+        out_endpoints();
+    }
+
+    if (status & USB_OTG_GINTSTS_IEPINT) {
+        in_endpoints();
+    }
+
+    if (status & USB_OTG_GINTSTS_USBSUSP) {
+        // Also how a cable pull looks without VBUS sensing
+        USB_GLOBAL->GINTSTS = USB_OTG_GINTSTS_USBSUSP;
+        suspended = true;
+        tx_start();
+    }
+
+    if (status & USB_OTG_GINTSTS_WKUINT) {
+        USB_GLOBAL->GINTSTS = USB_OTG_GINTSTS_WKUINT;
+        suspended = false;
+    }
+}
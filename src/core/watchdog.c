@@ -0,0 +1,102 @@
+#include "core/watchdog.h"
+
+#define WATCHDOG_LSI_HZ         32000UL
+#define WATCHDOG_RELOAD_MAX     0x0FFFUL
+#define WATCHDOG_PRESCALERS     7U          // PR = 0..6: LSI / 4 .. LSI / 256
+
+#define IWDG_KEY_RELOAD         0xAAAAU
+#define IWDG_KEY_UNLOCK         0x5555U
+#define IWDG_KEY_START          0xCCCCU
+
+/* ============================================
+   Reset Cause
+   ============================================ */
+
+reset_cause_t watchdog_read_reset_cause(void) {
+    uint32_t flags = RCC->CSR;
+    reset_cause_t cause;
+
+    // A power-on reset also sets PINRSTF and BORRSTF, so test it first
+    if (flags & RCC_CSR_LPWRRSTF) {
+        cause = RESET_CAUSE_LOW_POWER;
+    } else if (flags & RCC_CSR_WWDGRSTF) {
+        cause = RESET_CAUSE_WWDG;
+    } else if (flags & RCC_CSR_IWDGRSTF) {
+        cause = RESET_CAUSE_IWDG;
+    } else if (flags & RCC_CSR_SFTRSTF) {
+        cause = RESET_CAUSE_SOFTWARE;
+    } else if (flags & RCC_CSR_PORRSTF) {
+        cause = RESET_CAUSE_POWER_ON;
+    } else if (flags & RCC_CSR_BORRSTF) {
+        cause = RESET_CAUSE_BROWN_OUT;
+    } else if (flags & RCC_CSR_PINRSTF) {
+        cause = RESET_CAUSE_PIN;
+    } else {
+        cause = RESET_CAUSE_UNKNOWN;
+    }
+
+    RCC->CSR |= RCC_CSR_RMVF;
+    return cause;
+}
+
+const char *watchdog_reset_cause_name(reset_cause_t cause) {
+    static const char *const names[] = {
+        [RESET_CAUSE_UNKNOWN] = "?",
+        [RESET_CAUSE_POWER_ON] = "por",
+        [RESET_CAUSE_BROWN_OUT] = "bor",
+        [RESET_CAUSE_PIN] = "pin",
+        [RESET_CAUSE_SOFTWARE] = "soft",
+        [RESET_CAUSE_IWDG] = "iwdg",
+        [RESET_CAUSE_WWDG] = "wwdg",
+        [RESET_CAUSE_LOW_POWER] = "lpwr",
+    };
+
+    if ((uint32_t)cause >= sizeof(names) / sizeof(names[0])) {
+        return "?";
+    }
+    return names[cause];
+}
+
+/* ============================================
+   Watchdog
+   ============================================ */
+
+/**
+ * @brief Start the IWDG with the finest prescaler that reaches the timeout
+ *
+ * Configuration:
+ * - PR: smallest of LSI / 4 .. / 256 with RLR <= 4095
+ * - RLR: timeout_ms * (LSI / prescaler) / 1000
+ * - Counter stopped while the core is halted by a debugger
+ */
+bool watchdog_init(uint32_t timeout_ms) {
+    uint32_t prescaler;
+    uint32_t reload = 0;
+
+    for (prescaler = 0; prescaler < WATCHDOG_PRESCALERS; prescaler++) {
+        uint32_t tick_hz = WATCHDOG_LSI_HZ / (4UL << prescaler);
+        reload = (timeout_ms * tick_hz) / 1000U;
+        if (reload <= WATCHDOG_RELOAD_MAX) {
+            break;
+        }
+    }
+    if (prescaler == WATCHDOG_PRESCALERS || reload == 0) {
+        return false;
+    }
+
+    DBGMCU->APB1FZ |= DBGMCU_APB1_FZ_DBG_IWDG_STOP;
+
+    // Starting first also starts LSI; PR/RLR writes need the unlock key
+    IWDG->KR = IWDG_KEY_START;
+    IWDG->KR = IWDG_KEY_UNLOCK;
+    IWDG->PR = prescaler;
+    IWDG->RLR = reload - 1U;
+    while (IWDG->SR & (IWDG_SR_PVU | IWDG_SR_RVU));
+    IWDG->KR = IWDG_KEY_RELOAD;
+
+    return true;
+}
+
+void watchdog_feed(void) {
+    IWDG->KR = IWDG_KEY_RELOAD;
+}
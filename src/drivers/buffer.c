@@ -16,6 +16,7 @@ bool ring_buffer_init(ring_buffer_t *rb, uint16_t *buffer, uint16_t size) {
     rb->tail = 0;
     rb->count = 0;
     rb->full = false;
+    rb->overwritten = 0;
 
     return true;
 }
@@ -25,16 +26,18 @@ bool ring_buffer_write(ring_buffer_t *rb, uint16_t data) {
         return false;
     }
 
-    rb->buffer[rb->head] = data;
-    rb->head = (rb->head + 1) % rb->size;
-    rb->count++;
-
-    if (rb->head == rb->tail) {
-        rb->full = true;
+    if (rb->full) {
+        // Overwrite the oldest element and account for it
         rb->tail = (rb->tail + 1) % rb->size;
-        rb->count = rb->size;
+        rb->overwritten++;
+    } else {
+        rb->count++;
     }
 
+    rb->buffer[rb->head] = data;
+    rb->head = (rb->head + 1) % rb->size;
+    rb->full = (rb->count == rb->size);
+
     return true;
 }
 
@@ -91,6 +94,89 @@ uint16_t ring_buffer_count(ring_buffer_t *rb) {
     return rb->count;
 }
 
+uint32_t ring_buffer_get_overwritten(ring_buffer_t *rb) {
+    if (rb == NULL) {
+        return 0;
+    }
+    return rb->overwritten;
+}
+
+/* ============================================
+   Span (Zero-Copy) Access
+   ============================================ */
+
+static inline uint16_t ring_buffer_advance(const ring_buffer_t *rb, uint16_t index, uint16_t count) {
+    // index < size and count <= size, so one conditional subtract replaces %
+    uint32_t next = (uint32_t)index + count;
+    if (next >= rb->size) {
+        next -= rb->size;
+    }
+    return (uint16_t)next;
+}
+
+uint16_t ring_buffer_claim_write(ring_buffer_t *rb, ring_buffer_span_t spans[2]) {
+    if (rb == NULL || spans == NULL) {
+        return 0;
+    }
+
+    uint16_t free_space = rb->size - rb->count;
+    uint16_t first = rb->size - rb->head;
+    if (first > free_space) {
+        first = free_space;
+    }
+
+    spans[0].data = &rb->buffer[rb->head];
+    spans[0].length = first;
+    spans[1].data = &rb->buffer[0];
+    spans[1].length = free_space - first;
+
+    return free_space;
+}
+
+bool ring_buffer_commit_write(ring_buffer_t *rb, uint16_t count) {
+    if (rb == NULL || count > (rb->size - rb->count)) {
+        return false;
+    }
+
+    rb->head = ring_buffer_advance(rb, rb->head, count);
+    rb->count += count;
+    rb->full = (rb->count == rb->size);
+
+    return true;
+}
+
+uint16_t ring_buffer_peek_read(ring_buffer_t *rb, ring_buffer_span_t spans[2]) {
+    if (rb == NULL || spans == NULL) {
+        return 0;
+    }
+
+    uint16_t first = rb->size - rb->tail;
+    if (first > rb->count) {
+        first = rb->count;
+    }
+
+    spans[0].data = &rb->buffer[rb->tail];
+    spans[0].length = first;
+    spans[1].data = &rb->buffer[0];
+    spans[1].length = rb->count - first;
+
+    return rb->count;
+}
+
+bool ring_buffer_release_read(ring_buffer_t *rb, uint16_t count) {
+    if (rb == NULL || count > rb->count) {
+        return false;
+    }
+
+    rb->tail = ring_buffer_advance(rb, rb->tail, count);
+    rb->count -= count;
+    if (count > 0) {
+        rb->full = false;
+    }
+
+    return true;
+}
+
 void ring_buffer_clear(ring_buffer_t *rb) {
     if (rb == NULL) {
         return;
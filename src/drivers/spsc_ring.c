@@ -0,0 +1,124 @@
+#include "drivers/spsc_ring.h"
+#include "stm32f4xx.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================
+   Memory Ordering
+   ============================================
+   Producer: store data -> DMB -> publish head
+   Consumer: load head -> DMB -> load data -> DMB -> publish tail
+   The DMB keeps the data accesses from being reordered across the
+   index update on the other side (Cortex-M4 write buffer, compiler).
+   ============================================ */
+
+/* ============================================
+   SPSC Ring Buffer Implementation
+   ============================================ */
+
+bool spsc_ring_init(spsc_ring_t *rb, uint16_t *buffer, uint32_t size) {
+    if (rb == NULL || buffer == NULL || size == 0 || (size & (size - 1)) != 0) {
+        return false;
+    }
+
+    rb->buffer = buffer;
+    rb->mask = size - 1;
+    rb->head = 0;
+    rb->tail = 0;
+    rb->dropped = 0;
+
+    return true;
+}
+
+bool spsc_ring_write(spsc_ring_t *rb, uint16_t data) {
+    uint32_t head = rb->head;
+
+    if ((head - rb->tail) > rb->mask) {
+        rb->dropped++;
+        return false;
+    }
+
+    rb->buffer[head & rb->mask] = data;
+    __DMB();
+    rb->head = head + 1;
+
+    return true;
+}
+
+bool spsc_ring_read(spsc_ring_t *rb, uint16_t *data) {
+    uint32_t tail = rb->tail;
+
+    if (rb->head == tail) {
+        return false;
+    }
+
+    __DMB();
+    *data = rb->buffer[tail & rb->mask];
+    __DMB();
+    rb->tail = tail + 1;
+
+    return true;
+}
+
+uint32_t spsc_ring_write_n(spsc_ring_t *rb, const uint16_t *data, uint32_t count) {
+    uint32_t head = rb->head;
+    uint32_t space = (rb->mask + 1) - (head - rb->tail);
+
+    if (count > space) {
+        rb->dropped += count - space;
+        count = space;
+    }
+
+    // Contiguous span up to the end of the buffer, then the wrapped part
+    uint32_t offset = head & rb->mask;
+    uint32_t first = (rb->mask + 1) - offset;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(&rb->buffer[offset], data, first * sizeof(uint16_t));
+    memcpy(&rb->buffer[0], data + first, (count - first) * sizeof(uint16_t));
+
+    __DMB();
+    rb->head = head + count;
+
+    return count;
+}
+
+uint32_t spsc_ring_read_n(spsc_ring_t *rb, uint16_t *data, uint32_t count) {
+    uint32_t tail = rb->tail;
+    uint32_t available = rb->head - tail;
+
+    if (count > available) {
+        count = available;
+    }
+
+    __DMB();
+    uint32_t offset = tail & rb->mask;
+    uint32_t first = (rb->mask + 1) - offset;
+    if (first > count) {
+        first = count;
+    }
+    memcpy(data, &rb->buffer[offset], first * sizeof(uint16_t));
+    memcpy(data + first, &rb->buffer[0], (count - first) * sizeof(uint16_t));
+    __DMB();
+
+    rb->tail = tail + count;
+
+    return count;
+}
+
+uint32_t spsc_ring_count(const spsc_ring_t *rb) {
+    return rb->head - rb->tail;
+}
+
+uint32_t spsc_ring_free(const spsc_ring_t *rb) {
+    return (rb->mask + 1) - (rb->head - rb->tail);
+}
+
+bool spsc_ring_is_empty(const spsc_ring_t *rb) {
+    return rb->head == rb->tail;
+}
+
+bool spsc_ring_is_full(const spsc_ring_t *rb) {
+    return (rb->head - rb->tail) > rb->mask;
+}
@@ -6,21 +6,23 @@
  * This bare-metal CMSIS implementation demonstrates:
  * - Hardware timer configured for 100 Hz trigger
  * - ADC triggered by timer overflow events
- * - DMA transfers ADC results to memory buffer
- * - UART sends results at 115200 baud via serial terminal
+ * - DMA fills a ping-pong block buffer (half/full-transfer events)
+ * - UART sends results at 115200 baud via a DMA-drained TX ring
  * 
  * Hardware Configuration:
  * - PA0: Analog Input (ADC Channel 0) - Connect potentiometer or sensor here
  * - PA9: UART TX (USB-TTL or Serial Adapter)
+ * - PA10: UART RX (runtime commands, ENABLE_COMMAND_INTERFACE)
+ * - PA11/PA12: USB DM/DP (virtual COM port output, ENABLE_USB_CDC)
  * - PC13: LED Output (Status indicator)
  * 
  * System Flow:
  * 1. Timer fires at 100 Hz
  * 2. Timer TRGO triggers ADC conversion
  * 3. ADC converts PA0 analog input
- * 4. DMA transfers result to buffer
- * 5. DMA interrupt signals data ready
- * 6. Main loop sends result via UART
+ * 4. DMA transfers result into the active half of the block buffer
+ * 5. DMA HT/TC interrupt signals a finished block (ADC_BLOCK_SIZE samples)
+ * 6. Scheduler runs the block task, which sends results via UART
  * 7. Result displayed on serial terminal
  * 
  * Expected Output (Putty/Serial Terminal):
@@ -34,79 +36,1278 @@
 
 #include "stm32f4xx.h"
 #include "config.h"
+#include "core/clock.h"
 #include "core/timer.h"
+#include "core/timebase.h"
+#include "core/sampling.h"
 #include "core/adc.h"
+#include "core/adc_convert.h"
+#include "core/adc_oversample.h"
+#include "core/calibration.h"
 #include "core/dma.h"
 #include "core/uart.h"
+#include "core/power.h"
+#include "core/usb_cdc.h"
+#include "middleware/telemetry.h"
+#include "middleware/filter.h"
+#include "middleware/scheduler.h"
+#include "middleware/loss.h"
+#include "middleware/trigger.h"
+#include "middleware/command.h"
+#include "middleware/logger.h"
+#include "middleware/supervisor.h"
+#include "middleware/pipeline.h"
+#include "utils/error.h"
+#include "utils/fault.h"
+#include "utils/stats.h"
+#include "utils/profile.h"
+#include "utils/memory.h"
 #include <stdio.h>
+#include <string.h>
 
 /* ============================================
    Global Variables
    ============================================ */
 
-// DMA buffer for ADC conversion results
-// Circular buffer - DMA writes here, main reads from here
-volatile uint16_t adc_buffer[1] = {0};
+// DMA ping-pong buffer for ADC conversion results
+// DMA fills one half while main processes the other; each half holds
+// ADC_BLOCK_SIZE interleaved frames of ADC_CHANNELS samples. This and
+// the stage output blocks below are drawn from the arena at init.
+static volatile uint16_t *adc_buffer = NULL;
+// false if the arena refused a buffer: acquisition is never started
+static bool buffers_ready = false;
+// Set by "acq off": TIM/DMA halted, so the idle policy may enter Stop
+static bool acquisition_paused = false;
 
-// Status LED counter
+#if ENABLE_MULTICHANNEL
+// Scan sequence: PA0-PA7 = IN0-IN7, converted in list order per trigger
+static const adc_scan_channel_t scan_channels[ADC_CHANNELS] = {
+    {0, ADC_SAMPLE_56_CYCLES}, {1, ADC_SAMPLE_56_CYCLES},
+    {2, ADC_SAMPLE_56_CYCLES}, {3, ADC_SAMPLE_56_CYCLES},
+    {4, ADC_SAMPLE_56_CYCLES}, {5, ADC_SAMPLE_56_CYCLES},
+    {6, ADC_SAMPLE_56_CYCLES}, {7, ADC_SAMPLE_56_CYCLES},
+};
+
+// Channels currently in the scan sequence (a subset after "ch")
+static adc_scan_channel_t active_scan[ADC_CHANNELS];
+#endif
+
+#if ENABLE_FILTER && ENABLE_OVERSAMPLING
+#error "ENABLE_FILTER expects 12-bit input; disable ENABLE_OVERSAMPLING"
+#endif
+
+#if ENABLE_FILTER
+// One FIR decimator per scan channel; block output is re-interleaved
+static fir_decimator_t filters[ADC_CHANNELS];
+// Sized for decimation 1, the smallest the "dec" command accepts
+static uint16_t *filtered_block = NULL;
+#define PIPELINE_BLOCK_SAMPLES (ADC_BLOCK_SIZE * ADC_CHANNELS)
+#define OUTPUT_DECIMATION FILTER_DECIMATION
+#elif ENABLE_OVERSAMPLING
+// 4^k frames in, one (12+k)-bit frame out, re-interleaved per channel;
+// a group may straddle two DMA blocks
+static adc_oversampler_t oversamplers[ADC_CHANNELS];
+static uint16_t *oversampled_block = NULL;
+#define PIPELINE_BLOCK_SAMPLES (ADC_OVERSAMPLE_MAX_OUTPUTS(ADC_BLOCK_SIZE) * ADC_CHANNELS)
+#define OUTPUT_DECIMATION ADC_OVERSAMPLE_RATIO
+#else
+#define OUTPUT_DECIMATION 1
+#endif
+
+// Input frame period and output frame period (after filter/oversampling);
+// retuned at runtime by the "rate" and "dec" commands
+static uint32_t sample_period_us = 1000000UL / ADC_SAMPLE_RATE_HZ;
+static uint16_t output_decimation = OUTPUT_DECIMATION;
+static uint32_t output_period_us = (1000000UL / ADC_SAMPLE_RATE_HZ) * OUTPUT_DECIMATION;
+
+#if ENABLE_STATISTICS
+// Per-channel statistics on the output stream (after filter/oversampling)
+static stats_t channel_stats[ADC_CHANNELS];
+static uint32_t stats_report_frames = 0;
+#endif
+
+// Single-channel ASCII lines: the split table formats straight from the
+// raw count; otherwise one adc_convert_block_mv() pass feeds them
+#define ENCODE_SPLIT_LUT (ADC_CONVERT_SPLIT_LUT && (ADC_OUTPUT_BITS == ADC_RESOLUTION))
+#if !ENCODE_SPLIT_LUT
+// Millivolt results for one single-channel block (ASCII output)
+static uint16_t *mv_block = NULL;
+#endif
+
+// Output sample counter
 static volatile uint32_t sample_count = 0;
-static volatile uint32_t led_toggle_count = 0;
+
+// Event task released by the ADC DMA ISR
+static uint8_t adc_block_task = SCHEDULER_INVALID_TASK;
+
+// Event task released when the UART TX ring drains
+static uint8_t tx_idle_task = SCHEDULER_INVALID_TASK;
+
+#if ENABLE_COMMAND_INTERFACE
+// Event task released by the UART RX ISRs
+static uint8_t command_task = SCHEDULER_INVALID_TASK;
+#endif
 
 /* ============================================
    Function Declarations
    ============================================ */
 
 void system_init(void);
+void print_memory(void);
+void print_sampling(void);
 void gpio_init(void);
+void clock_failure_halt(void) __attribute__((noreturn));
 void print_welcome_message(void);
-void process_adc_sample(uint16_t raw_value);
+void process_adc_sample(uint16_t raw_value, uint16_t voltage_mv);
+void process_adc_frame(const adc_channel_view_t *views, uint8_t channels, uint16_t frame);
+void print_statistics(void);
+void print_profile(void);
+void print_scheduler(void);
+void print_pipeline(void);
+void print_power(void);
+void tasks_init(void);
+void on_dma_block(void);
+void task_adc_block(void);
+void on_uart_tx_idle(void);
+void task_tx_idle(void);
+void task_led(void);
+void task_calibration(void);
+void task_loss(void);
+void task_errors(void);
+void task_supervisor(void);
+void print_reset_report(void);
+void print_fault_report(void);
+void task_fault(void);
+void task_trigger(void);
+void task_logger(void);
+void task_command(void);
+void on_uart_rx(void);
+static bool allocate_buffers(void);
+static void apply_output_timing(void);
+static void reset_output_state(void);
+static uint8_t output_channel_number(uint8_t index);
+static void format_scan_list(char *buf, size_t size);
+
+/* ============================================
+   Processing Pipeline
+   ============================================
+   Every DMA block runs through these stages in order. Stages of
+   disabled features are left out of the list, so neither their code
+   nor their counters are built:
+
+     acquire     Loss tracking, scan frame layout
+     filter      FIR low-pass + decimation      (ENABLE_FILTER)
+     oversample  4^k:1 to 12+k bits             (ENABLE_OVERSAMPLING)
+     log         Flash log staging              (ENABLE_LOGGING)
+     stats       Statistics; ends the block in summary format (ENABLE_STATISTICS)
+     trigger     Capture engine; ends the block (ENABLE_TRIGGER)
+     encode      Binary frame or ASCII lines into the TX ring
+
+   The TX ring is the transport: UART DMA or USB drain it from their
+   interrupts, and its fill level is the encode stage's backlog.
+   ============================================ */
+static bool stage_acquire(pipeline_block_t *block);
+#if ENABLE_FILTER
+static bool stage_filter(pipeline_block_t *block);
+#define PIPELINE_FILTER(X)  X(FILTER, "filter", stage_filter, NULL)
+#elif ENABLE_OVERSAMPLING
+static bool stage_oversample(pipeline_block_t *block);
+#define PIPELINE_FILTER(X)  X(OVERSAMPLE, "oversample", stage_oversample, NULL)
+#else
+#define PIPELINE_FILTER(X)
+#endif
+#if ENABLE_LOGGING
+static bool stage_log(pipeline_block_t *block);
+#define PIPELINE_LOG(X)     X(LOG, "log", stage_log, logger_get_backlog)
+#else
+#define PIPELINE_LOG(X)
+#endif
+#if ENABLE_STATISTICS
+static bool stage_stats(pipeline_block_t *block);
+#define PIPELINE_STATS(X)   X(STATS, "stats", stage_stats, NULL)
+#else
+#define PIPELINE_STATS(X)
+#endif
+#if ENABLE_TRIGGER
+static bool stage_trigger(pipeline_block_t *block);
+#define PIPELINE_OUTPUT(X)  X(TRIGGER, "trigger", stage_trigger, NULL)
+#else
+static bool stage_encode(pipeline_block_t *block);
+#define PIPELINE_OUTPUT(X)  X(ENCODE, "encode", stage_encode, uart_tx_pending)
+#endif
+
+#define APP_PIPELINE(X) \
+    X(ACQUIRE, "acquire", stage_acquire, NULL) \
+    PIPELINE_FILTER(X) \
+    PIPELINE_LOG(X) \
+    PIPELINE_STATS(X) \
+    PIPELINE_OUTPUT(X)
+
+PIPELINE_DEFINE(app_pipeline, APP_PIPELINE)
+
+#if ENABLE_COMMAND_INTERFACE
+static command_status_t cmd_rate(uint8_t argc, char *argv[]);
+static command_status_t cmd_mode(uint8_t argc, char *argv[]);
+static command_status_t cmd_acq(uint8_t argc, char *argv[]);
+static command_status_t cmd_ch(uint8_t argc, char *argv[]);
+static command_status_t cmd_fmt(uint8_t argc, char *argv[]);
+static command_status_t cmd_dec(uint8_t argc, char *argv[]);
+static command_status_t cmd_stats(uint8_t argc, char *argv[]);
+static command_status_t cmd_prof(uint8_t argc, char *argv[]);
+static command_status_t cmd_sched(uint8_t argc, char *argv[]);
+static command_status_t cmd_pipe(uint8_t argc, char *argv[]);
+static command_status_t cmd_log(uint8_t argc, char *argv[]);
+static command_status_t cmd_out(uint8_t argc, char *argv[]);
+static command_status_t cmd_err(uint8_t argc, char *argv[]);
+static command_status_t cmd_mem(uint8_t argc, char *argv[]);
+
+static const command_t command_table[] = {
+    {"rate",  cmd_rate,  "rate [hz]            sampling rate (divisor of the mode's step)"},
+    {"mode",  cmd_mode,  "mode [name]          sampling mode: tim2 tim3 ilv cont"},
+    {"acq",   cmd_acq,   "acq [on|off]         pause/resume acquisition (Stop mode while off)"},
+    {"ch",    cmd_ch,    "ch [list]            scan channels, e.g. 0,2,5 or 0-3"},
+    {"fmt",   cmd_fmt,   "fmt [ascii|bin|sum]  output format"},
+    {"dec",   cmd_dec,   "dec [n]              FIR decimation factor"},
+    {"stats", cmd_stats, "stats                statistics dump"},
+    {"prof",  cmd_prof,  "prof                 profiling dump"},
+    {"sched", cmd_sched, "sched                scheduler dump"},
+    {"pipe",  cmd_pipe,  "pipe [reset]         pipeline stage counters"},
+    {"log",   cmd_log,   "log [cmd]            flash log: read [seq], seek <ms>, stop, erase (acq off)"},
+    {"out",   cmd_out,   "out [uart|usb]       output transport"},
+    {"err",   cmd_err,   "err [clear]          error counters per code"},
+    {"mem",   cmd_mem,   "mem                  RAM budget and stack high-water"},
+};
+#endif
 
 /**
  * @brief Main Application Entry Point
  */
 int main(void) {
+    // Before anything runs deep: the high-water mark starts here
+    memory_paint_stack();
+    
     // Initialize system peripherals
     system_init();
     
     // Print welcome message to serial terminal
     print_welcome_message();
     
-    // Main event loop
-    while (1) {
-        // Check if DMA transfer is complete (new ADC sample available)
-        if (dma_is_transfer_complete()) {
-            // Clear the DMA complete flag
-            dma_clear_transfer_complete_flag();
-            
-            // Process the ADC sample
-            process_adc_sample(adc_buffer[0]);
-            
-            // Toggle LED for visual feedback
-            led_toggle_count++;
-            if (led_toggle_count >= 10) {  // Toggle every 10 samples (at 100Hz = every 100ms)
-                GPIOC->ODR ^= (1 << 13);   // Toggle PC13 LED
-                led_toggle_count = 0;
+    // Dispatch tasks forever; idles per POWER_POLICY when nothing is ready
+    scheduler_run();
+    
+    return 0;
+}
+
+/**
+ * @brief Register the application tasks (highest priority first)
+ * 
+ * 0: adc_block   - event, released by the ADC DMA ISR per block (app_pipeline)
+ * 3: tx_idle     - event, released when the TX ring drains (help, trigger, log readback)
+ * 1: calibration - every CAL_INTERVAL_MS (ENABLE_CALIBRATION)
+ * 2: led         - every LED_BLINK_PERIOD_MS
+ * 3: profile     - every PROFILE_REPORT_INTERVAL_MS (ENABLE_PROFILING)
+ * 3: sched       - every SCHED_REPORT_INTERVAL_MS
+ * 3: pipe        - every PIPELINE_REPORT_INTERVAL_MS
+ * 3: power       - every POWER_REPORT_INTERVAL_MS
+ * 3: loss        - every LOSS_REPORT_INTERVAL_MS
+ * 3: errors      - every ERROR_REPORT_INTERVAL_MS
+ * 3: supervisor  - every WATCHDOG_SERVICE_MS (ENABLE_WATCHDOG)
+ * 3: trigger     - every TRIGGER_SHIP_INTERVAL_MS, starts shipping (ENABLE_TRIGGER)
+ * 3: logger      - every LOG_SERVICE_INTERVAL_MS, programs and starts readback (ENABLE_LOGGING)
+ * 3: command     - event, released by UART RX (ENABLE_COMMAND_INTERFACE)
+ */
+void tasks_init(void) {
+    scheduler_init();
+    
+    adc_block_task = scheduler_add_task("adc_block", task_adc_block, 0, 0);
+    tx_idle_task = scheduler_add_task("tx_idle", task_tx_idle, 0, 3);
+#if ENABLE_CALIBRATION
+    scheduler_add_task("calibration", task_calibration, CAL_INTERVAL_MS, 1);
+#endif
+    scheduler_add_task("led", task_led, LED_BLINK_PERIOD_MS, 2);
+#if ENABLE_PROFILING && PROFILE_REPORT_INTERVAL_MS > 0
+    scheduler_add_task("profile", print_profile, PROFILE_REPORT_INTERVAL_MS, 3);
+#endif
+#if SCHED_REPORT_INTERVAL_MS > 0
+    scheduler_add_task("sched", print_scheduler, SCHED_REPORT_INTERVAL_MS, 3);
+#endif
+#if PIPELINE_REPORT_INTERVAL_MS > 0
+    scheduler_add_task("pipe", print_pipeline, PIPELINE_REPORT_INTERVAL_MS, 3);
+#endif
+#if POWER_REPORT_INTERVAL_MS > 0
+    scheduler_add_task("power", print_power, POWER_REPORT_INTERVAL_MS, 3);
+#endif
+#if LOSS_REPORT_INTERVAL_MS > 0
+    scheduler_add_task("loss", task_loss, LOSS_REPORT_INTERVAL_MS, 3);
+#endif
+#if ERROR_REPORT_INTERVAL_MS > 0
+    scheduler_add_task("errors", task_errors, ERROR_REPORT_INTERVAL_MS, 3);
+#endif
+#if ENABLE_WATCHDOG
+    scheduler_add_task("supervisor", task_supervisor, WATCHDOG_SERVICE_MS, 3);
+    supervisor_set_period(SUPERVISOR_STAGE_TX, WATCHDOG_SERVICE_MS * 1000U);
+#endif
+#if ENABLE_TRIGGER
+    scheduler_add_task("trigger", task_trigger, TRIGGER_SHIP_INTERVAL_MS, 3);
+#endif
+#if ENABLE_LOGGING
+    scheduler_add_task("logger", task_logger, LOG_SERVICE_INTERVAL_MS, 3);
+#endif
+#if ENABLE_COMMAND_INTERFACE
+    command_task = scheduler_add_task("command", task_command, 0, 3);
+    command_init(command_table, sizeof(command_table) / sizeof(command_table[0]));
+    uart_set_rx_callback(on_uart_rx);
+#endif
+#if ENABLE_USB_CDC
+    // Last, so fault records keep naming the same task ids
+    scheduler_add_task("fault", task_fault, FAULT_RETRY_INTERVAL_MS, 3);
+#endif
+    
+    dma_set_block_callback(on_dma_block);
+    uart_set_tx_idle_callback(on_uart_tx_idle);
+}
+
+/**
+ * @brief DMA ISR hook: release the block task
+ */
+void on_dma_block(void) {
+#if ENABLE_WATCHDOG
+    supervisor_checkin(SUPERVISOR_STAGE_DMA);
+#endif
+    scheduler_post_event(adc_block_task);
+}
+
+/**
+ * @brief UART TX ISR hook (USART DMA or USB drain): release the TX-idle task
+ */
+void on_uart_tx_idle(void) {
+    scheduler_post_event(tx_idle_task);
+}
+
+/**
+ * @brief Refill the drained TX ring from the producers paced by its space
+ *
+ * Their timer tasks start the work and cover a ring that never runs
+ * empty; this continues it as soon as the whole ring is free.
+ */
+void task_tx_idle(void) {
+#if ENABLE_COMMAND_INTERFACE
+    if (command_output_pending()) {
+        scheduler_post_event(command_task);
+    }
+#endif
+#if ENABLE_TRIGGER
+    trigger_ship();
+#endif
+#if ENABLE_LOGGING
+    logger_service_readback();
+#endif
+}
+
+/**
+ * @brief Process the most recently finished DMA half-buffer
+ */
+void task_adc_block(void) {
+    dma_block_t dma;
+    
+    if (dma_get_ready_block(&dma)) {
+        // Block is stable until DMA wraps back onto it; stages read it in place
+        pipeline_block_t block = {
+            .data = (const uint16_t *)dma.data,
+            .count = dma.length,
+            .sequence = dma.sequence,
+            .timestamp_us = dma.timestamp_us,
+        };
+        PROFILE_BEGIN(PROFILE_PROBE_ADC_BLOCK);
+        app_pipeline_run(&block);
+        PROFILE_END(PROFILE_PROBE_ADC_BLOCK);
+#if ENABLE_WATCHDOG
+        supervisor_checkin(SUPERVISOR_STAGE_PROCESS);
+#endif
+    }
+}
+
+#if ENABLE_WATCHDOG
+/**
+ * @brief Check in the TX stage, then let the supervisor feed the IWDG
+ * 
+ * The TX ring is healthy while it is empty or drained some bytes since
+ * the previous run. Over USB the host paces the drain, so a port that
+ * is open but not read does not count as a stall.
+ */
+void task_supervisor(void) {
+    static uint16_t last_drained = 0;
+    
+    uint16_t drained = uart_tx_get_drained();
+    if (drained != last_drained || uart_tx_pending() == 0 ||
+        uart_tx_get_route() != UART_TX_ROUTE_USART) {
+        supervisor_checkin(SUPERVISOR_STAGE_TX);
+    }
+    last_drained = drained;
+    
+    supervisor_service();
+}
+#endif
+
+/**
+ * @brief Toggle the status LED (PC13)
+ */
+void task_led(void) {
+    GPIOC->ODR ^= (1 << 13);
+}
+
+#if ENABLE_CALIBRATION
+/**
+ * @brief Track supply drift; the next block converts with the new table
+ * 
+ * Skipped while "acq off" has the ADC powered down: there is nothing to
+ * convert, and the VREFINT measurement needs ADON.
+ */
+void task_calibration(void) {
+    if (acquisition_paused) {
+        return;
+    }
+    if (calibration_update() != CAL_STATUS_OK) {
+        error_report(ERROR_ADC_FAILED, 1, "VREFINT calibration rejected");
+    }
+}
+#endif
+
+#if LOSS_REPORT_INTERVAL_MS > 0
+/**
+ * @brief Fold in the loss counters and publish them
+ * 
+ * Binary format: one status frame (counters, blocks seen, TX peak) per
+ * interval. Text formats: a "Loss | name N | ..." line only when
+ * something was lost since the previous interval.
+ */
+void task_loss(void) {
+    static char uart_buffer[128];
+    
+    bool lost = loss_poll();
+    loss_report_t report;
+    loss_get(&report);
+    
+    if (telemetry_get_format() == TELEMETRY_OUTPUT_BINARY) {
+        uint32_t words[LOSS_COUNTER_COUNT + 2];
+        for (uint8_t c = 0; c < LOSS_COUNTER_COUNT; c++) {
+            words[c] = report.counters[c];
+        }
+        words[LOSS_COUNTER_COUNT] = report.blocks_seen;
+        words[LOSS_COUNTER_COUNT + 1] = report.tx_high_water;
+        telemetry_send_status(words, LOSS_COUNTER_COUNT + 2, timebase_now_us32());
+        return;
+    }
+    
+    if (!lost) {
+        return;
+    }
+    
+    int len = snprintf(uart_buffer, sizeof(uart_buffer), "Loss");
+    for (uint8_t c = 0; c < LOSS_COUNTER_COUNT && len > 0 && len < (int)sizeof(uart_buffer); c++) {
+        len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " | %s %lu",
+                        loss_get_name((loss_counter_t)c), report.counters[c]);
+    }
+    if (len > 0 && len < (int)sizeof(uart_buffer)) {
+        snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " | tx_peak %lu\r\n",
+                 report.tx_high_water);
+        uart_send_string(uart_buffer);
+    }
+}
+
+#endif
+
+#if ERROR_REPORT_INTERVAL_MS > 0
+/**
+ * @brief Print events logged since the previous run
+ * 
+ * "Err 0xCC name | sev S | t T s | n N | message" per event, at most
+ * ERROR_REPORT_MAX_LINES per run; the rest wait for the next run. If
+ * the log wrapped past unread events, one "Err log | skipped K" line
+ * says how many. Binary format prints nothing (events are still
+ * consumed; "err" gives the counters).
+ */
+void task_errors(void) {
+    static uint32_t next_sequence = 0;
+    static char uart_buffer[128];
+    
+    uint32_t head = error_get_sequence();
+    bool text = telemetry_get_format() != TELEMETRY_OUTPUT_BINARY;
+    
+    if (head - next_sequence > ERROR_LOG_SIZE) {
+        uint32_t skipped = head - next_sequence - ERROR_LOG_SIZE;
+        next_sequence = head - ERROR_LOG_SIZE;
+        if (text) {
+            snprintf(uart_buffer, sizeof(uart_buffer), "Err log | skipped %lu\r\n", skipped);
+            uart_send_string(uart_buffer);
+        }
+    }
+    
+    for (uint8_t lines = 0; next_sequence != head && lines < ERROR_REPORT_MAX_LINES; lines++) {
+        error_t event;
+        if (!error_read(next_sequence, &event)) {
+            break;      // Still being written; pick it up next run
+        }
+        next_sequence++;
+        
+        if (!text) {
+            continue;
+        }
+        uint32_t ms = (uint32_t)(event.timestamp_us / 1000U);
+        int len = snprintf(uart_buffer, sizeof(uart_buffer),
+                           "Err 0x%02X %s | sev %u | t %lu.%03lu s | n %lu | %s\r\n",
+                           (unsigned)event.code, error_get_string(event.code), event.severity,
+                           ms / 1000U, ms % 1000U, event.count,
+                           (event.message != NULL) ? event.message : "");
+        if (len > 0) {
+            uart_send_string(uart_buffer);
+        }
+    }
+}
+#endif
+
+#if ENABLE_TRIGGER
+/**
+ * @brief Send as much of a frozen capture as the TX ring has room for
+ */
+void task_trigger(void) {
+    trigger_ship();
+}
+#endif
+
+#if ENABLE_LOGGING
+/**
+ * @brief Program one batch of staged log pages and continue any readback
+ */
+void task_logger(void) {
+    logger_service();
+}
+#endif
+
+/**
+ * @brief Draw the DMA ping-pong buffer and the stage output blocks
+ * @return false if the arena refused any of them
+ */
+static bool allocate_buffers(void) {
+    adc_buffer = memory_alloc(MEMORY_OWNER_ADC, 2U * ADC_BLOCK_SIZE * ADC_CHANNELS * sizeof(uint16_t));
+    bool ok = adc_buffer != NULL;
+#if !ENCODE_SPLIT_LUT
+    mv_block = memory_alloc(MEMORY_OWNER_PIPELINE, ADC_BLOCK_SIZE * sizeof(uint16_t));
+    ok = ok && mv_block != NULL;
+#endif
+#if ENABLE_FILTER
+    filtered_block = memory_alloc(MEMORY_OWNER_PIPELINE, PIPELINE_BLOCK_SAMPLES * sizeof(uint16_t));
+    ok = ok && filtered_block != NULL;
+#elif ENABLE_OVERSAMPLING
+    oversampled_block = memory_alloc(MEMORY_OWNER_PIPELINE, PIPELINE_BLOCK_SAMPLES * sizeof(uint16_t));
+    ok = ok && oversampled_block != NULL;
+#endif
+    return ok;
+}
+
+/**
+ * @brief Push the current sample/output periods to DMA and telemetry
+ */
+static void apply_output_timing(void) {
+    output_period_us = sample_period_us * output_decimation;
+    dma_set_block_timing(ADC_BLOCK_SIZE, sample_period_us);
+    telemetry_set_sample_period_us(output_period_us);
+#if ENABLE_WATCHDOG
+    // One DMA block (and one processed block) per ADC_BLOCK_SIZE frames;
+    // neither stage checks in while acquisition is paused
+    uint32_t block_us = acquisition_paused ? 0 : sample_period_us * ADC_BLOCK_SIZE;
+    supervisor_set_period(SUPERVISOR_STAGE_DMA, block_us);
+    supervisor_set_period(SUPERVISOR_STAGE_PROCESS, block_us);
+#endif
+}
+
+/**
+ * @brief Drop per-channel filter and statistics history
+ *
+ * Called when the channel set or decimation changes, so no state from
+ * the previous layout leaks into the new stream.
+ */
+static void reset_output_state(void) {
+#if ENABLE_FILTER
+    for (uint8_t ch = 0; ch < ADC_CHANNELS; ch++) {
+        fir_decimator_init(&filters[ch], filter_lowpass_d4, FILTER_LOWPASS_D4_TAPS, output_decimation);
+    }
+#elif ENABLE_OVERSAMPLING
+    for (uint8_t ch = 0; ch < ADC_CHANNELS; ch++) {
+        adc_oversampler_reset(&oversamplers[ch]);
+    }
+#endif
+#if ENABLE_STATISTICS
+    for (uint8_t ch = 0; ch < ADC_CHANNELS; ch++) {
+        stats_init(&channel_stats[ch]);
+    }
+    stats_report_frames = 0;
+#endif
+}
+
+/**
+ * @brief Physical ADC channel of a position in the scan frame
+ */
+static uint8_t output_channel_number(uint8_t index) {
+#if ENABLE_MULTICHANNEL
+    return (index < ADC_CHANNELS) ? active_scan[index].channel : index;
+#else
+    return index;
+#endif
+}
+
+/**
+ * @brief Format the active scan list as "0 (PA0), 3 (PA3)"
+ * 
+ * Scan channels 0-7 are PA0-PA7; internal channels print bare.
+ */
+static void format_scan_list(char *buf, size_t size) {
+    int len = 0;
+
+    buf[0] = '\0';
+    for (uint8_t i = 0; i < adc_get_scan_length() && len >= 0 && len < (int)size; i++) {
+        uint8_t channel = output_channel_number(i);
+        const char *sep = (i > 0) ? ", " : "";
+        len += (channel < 8U) ? snprintf(&buf[len], size - len, "%s%u (PA%u)", sep, channel, channel)
+                              : snprintf(&buf[len], size - len, "%s%u", sep, channel);
+    }
+}
+
+#if ENABLE_COMMAND_INTERFACE
+/**
+ * @brief UART RX ISR hook: release the command task
+ */
+void on_uart_rx(void) {
+    scheduler_post_event(command_task);
+}
+
+/**
+ * @brief Execute the command lines received so far
+ */
+void task_command(void) {
+    command_poll();
+}
+
+static command_status_t cmd_rate(uint8_t argc, char *argv[]) {
+    static char uart_buffer[32];
+    uint32_t rate;
+
+    if (argc == 2) {
+        if (!command_parse_u32(argv[1], &rate)) {
+            return COMMAND_ERROR_USAGE;
+        }
+        if (!sampling_set_rate(rate)) {
+            return COMMAND_ERROR_RANGE;
+        }
+        sample_period_us = sampling_get_period_us();
+        apply_output_timing();
+    } else if (argc != 1) {
+        return COMMAND_ERROR_USAGE;
+    }
+
+    snprintf(uart_buffer, sizeof(uart_buffer), "rate %lu Hz\r\n", sampling_get_rate());
+    uart_send_string(uart_buffer);
+    return COMMAND_OK;
+}
+
+/**
+ * @brief Stop sampling, switch mode, restart DMA and sampling
+ *
+ * As with a channel change, the partially filled half is discarded
+ * and the output state restarts; the mode stays as it was if the
+ * current rate is not reachable in the new one.
+ */
+static bool switch_sampling_mode(sampling_mode_t mode) {
+    if (!buffers_ready) {
+        return false;
+    }
+
+    sampling_stop();
+    dma_disable();
+
+    bool ok = sampling_set_mode(mode);
+    dma_set_block_buffer(adc_buffer, ADC_BLOCK_SIZE * adc_get_scan_length());
+    sample_period_us = sampling_get_period_us();
+    apply_output_timing();
+    reset_output_state();
+
+    if (!acquisition_paused) {
+        dma_enable();
+        sampling_start();
+    }
+    return ok;
+}
+
+static command_status_t cmd_mode(uint8_t argc, char *argv[]) {
+    if (argc == 2) {
+        sampling_mode_t mode = SAMPLING_MODE_COUNT;
+        sampling_info_t info;
+
+        for (uint8_t m = 0; m < SAMPLING_MODE_COUNT; m++) {
+            if (sampling_get_info((sampling_mode_t)m, &info) && strcmp(info.name, argv[1]) == 0) {
+                mode = (sampling_mode_t)m;
             }
         }
+        if (mode == SAMPLING_MODE_COUNT) {
+            return COMMAND_ERROR_USAGE;
+        }
+        if (!switch_sampling_mode(mode)) {
+            return COMMAND_ERROR_RANGE;
+        }
+    } else if (argc != 1) {
+        return COMMAND_ERROR_USAGE;
+    }
+
+    print_sampling();
+    return COMMAND_OK;
+}
+
+/**
+ * @brief Halt or restart the trigger and ADC DMA
+ *
+ * Pausing is the only state in which POWER_POLICY_STOP may enter Stop,
+ * since Stop freezes TIM2/TIM3 and DMA, and in which the flash log may
+ * erase a sector. Resuming starts a fresh block
+ * sequence, as after a mode change.
+ */
+static bool set_acquisition_paused(bool paused) {
+    if (!buffers_ready) {
+        return false;
+    }
+    if (paused == acquisition_paused) {
+        return true;
+    }
+
+    if (paused) {
+        sampling_stop();
+        dma_disable();
+        acquisition_paused = true;
+        apply_output_timing();
+        power_set_stop_allowed(true);
+#if ENABLE_LOGGING
+        logger_set_erase_allowed(true);
+#endif
+        return true;
+    }
+
+#if ENABLE_LOGGING
+    logger_set_erase_allowed(false);
+#endif
+    power_set_stop_allowed(false);
+    acquisition_paused = false;
+    dma_set_block_buffer(adc_buffer, ADC_BLOCK_SIZE * adc_get_scan_length());
+    apply_output_timing();
+    reset_output_state();
+
+    dma_enable();
+    sampling_start();
+    return true;
+}
+
+static command_status_t cmd_acq(uint8_t argc, char *argv[]) {
+    if (argc == 2 && (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "off") == 0)) {
+        if (!set_acquisition_paused(strcmp(argv[1], "off") == 0)) {
+            return COMMAND_ERROR_UNSUPPORTED;
+        }
+    } else if (argc != 1) {
+        return COMMAND_ERROR_USAGE;
+    }
+
+    uart_send_string(acquisition_paused ? "acq off\r\n" : "acq on\r\n");
+    return COMMAND_OK;
+}
+
+#if ENABLE_MULTICHANNEL
+/**
+ * @brief Stop triggering, reprogram the scan sequence and DMA, restart
+ *
+ * Runs in task context between triggers; the partially filled half is
+ * discarded and the block sequence restarts at 0.
+ */
+static void acquisition_reconfigure(const adc_scan_channel_t *list, uint8_t count) {
+    if (!buffers_ready) {
+        return;
     }
     
-    return 0;
+    sampling_stop();
+    dma_disable();
+
+    adc_configure_scan(list, count);
+    dma_set_block_buffer(adc_buffer, ADC_BLOCK_SIZE * count);
+    // The cont rate follows the sequence length
+    sample_period_us = sampling_get_period_us();
+    apply_output_timing();
+    reset_output_state();
+
+    if (!acquisition_paused) {
+        dma_enable();
+        sampling_start();
+    }
 }
 
+/**
+ * @brief Parse "0,2,5" / "0-3" / "1,4-6" into scan entries
+ * @return Entries written, 0 on a malformed, out-of-range or repeated channel
+ */
+static uint8_t parse_channel_list(char *text, adc_scan_channel_t list[ADC_CHANNELS]) {
+    uint8_t count = 0;
+    uint8_t seen = 0;
+
+    for (char *item = strtok(text, ","); item != NULL; item = strtok(NULL, ",")) {
+        uint32_t first;
+        uint32_t last;
+        char *dash = strchr(item, '-');
+
+        if (dash != NULL) {
+            *dash = '\0';
+            if (!command_parse_u32(item, &first) || !command_parse_u32(dash + 1, &last)) {
+                return 0;
+            }
+        } else if (!command_parse_u32(item, &first)) {
+            return 0;
+        } else {
+            last = first;
+        }
+
+        if (first > last || last >= ADC_CHANNELS) {
+            return 0;
+        }
+        for (uint32_t ch = first; ch <= last; ch++) {
+            if (seen & (1U << ch)) {
+                return 0;
+            }
+            seen |= (uint8_t)(1U << ch);
+            list[count++] = scan_channels[ch];
+        }
+    }
+    return count;
+}
+#endif
+
+static command_status_t cmd_ch(uint8_t argc, char *argv[]) {
+#if ENABLE_MULTICHANNEL
+    static char uart_buffer[48];
+
+    if (argc == 2) {
+        adc_scan_channel_t list[ADC_CHANNELS];
+        uint8_t count = parse_channel_list(argv[1], list);
+        if (count == 0) {
+            return COMMAND_ERROR_RANGE;
+        }
+        for (uint8_t i = 0; i < count; i++) {
+            active_scan[i] = list[i];
+        }
+        acquisition_reconfigure(active_scan, count);
+    } else if (argc != 1) {
+        return COMMAND_ERROR_USAGE;
+    }
+
+    int len = snprintf(uart_buffer, sizeof(uart_buffer), "ch");
+    for (uint8_t i = 0; i < adc_get_scan_length() && len > 0 && len < (int)sizeof(uart_buffer); i++) {
+        len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " %u", active_scan[i].channel);
+    }
+    if (len > 0 && len < (int)sizeof(uart_buffer) - 2) {
+        snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, "\r\n");
+        uart_send_string(uart_buffer);
+    }
+    return COMMAND_OK;
+#else
+    (void)argc;
+    (void)argv;
+    return COMMAND_ERROR_UNSUPPORTED;
+#endif
+}
+
+static command_status_t cmd_fmt(uint8_t argc, char *argv[]) {
+    static const char *const names[] = {
+        [TELEMETRY_OUTPUT_ASCII] = "ascii",
+        [TELEMETRY_OUTPUT_BINARY] = "bin",
+        [TELEMETRY_OUTPUT_SUMMARY] = "sum",
+    };
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "ascii") == 0) {
+            telemetry_set_format(TELEMETRY_OUTPUT_ASCII);
+        } else if (strcmp(argv[1], "bin") == 0) {
+            telemetry_set_format(TELEMETRY_OUTPUT_BINARY);
+        } else if (strcmp(argv[1], "sum") == 0) {
+#if ENABLE_STATISTICS
+            telemetry_set_format(TELEMETRY_OUTPUT_SUMMARY);
+#else
+            return COMMAND_ERROR_UNSUPPORTED;
+#endif
+        } else {
+            return COMMAND_ERROR_USAGE;
+        }
+    } else if (argc != 1) {
+        return COMMAND_ERROR_USAGE;
+    }
+
+    uart_send_string("fmt ");
+    uart_send_string(names[telemetry_get_format()]);
+    uart_send_string("\r\n");
+    return COMMAND_OK;
+}
+
+static command_status_t cmd_dec(uint8_t argc, char *argv[]) {
+#if ENABLE_FILTER
+    static char uart_buffer[24];
+    uint32_t factor;
+
+    if (argc == 2) {
+        if (!command_parse_u32(argv[1], &factor)) {
+            return COMMAND_ERROR_USAGE;
+        }
+        if (factor == 0 || factor > FILTER_MAX_DECIMATION) {
+            return COMMAND_ERROR_RANGE;
+        }
+        output_decimation = (uint16_t)factor;
+        reset_output_state();
+        apply_output_timing();
+    } else if (argc != 1) {
+        return COMMAND_ERROR_USAGE;
+    }
+
+    snprintf(uart_buffer, sizeof(uart_buffer), "dec %u\r\n", output_decimation);
+    uart_send_string(uart_buffer);
+    return COMMAND_OK;
+#else
+    (void)argc;
+    (void)argv;
+    return COMMAND_ERROR_UNSUPPORTED;
+#endif
+}
+
+static command_status_t cmd_stats(uint8_t argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+#if ENABLE_STATISTICS
+    print_statistics();
+    return COMMAND_OK;
+#else
+    return COMMAND_ERROR_UNSUPPORTED;
+#endif
+}
+
+static command_status_t cmd_prof(uint8_t argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+#if ENABLE_PROFILING
+    print_profile();
+    return COMMAND_OK;
+#else
+    return COMMAND_ERROR_UNSUPPORTED;
+#endif
+}
+
+static command_status_t cmd_sched(uint8_t argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    print_scheduler();
+    return COMMAND_OK;
+}
+
+static command_status_t cmd_pipe(uint8_t argc, char *argv[]) {
+    if (argc == 1) {
+        print_pipeline();
+        return COMMAND_OK;
+    }
+    if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+        pipeline_reset(&app_pipeline);
+        return COMMAND_OK;
+    }
+    return COMMAND_ERROR_USAGE;
+}
+
+static command_status_t cmd_log(uint8_t argc, char *argv[]) {
+#if ENABLE_LOGGING
+    static char uart_buffer[128];
+    uint32_t value = 0;
+
+    if (argc >= 2 && strcmp(argv[1], "read") == 0) {
+        if (argc > 3 || (argc == 3 && !command_parse_u32(argv[2], &value))) {
+            return COMMAND_ERROR_USAGE;
+        }
+        return logger_start_readback(value) ? COMMAND_OK : COMMAND_ERROR_RANGE;
+    }
+    if (argc >= 2 && strcmp(argv[1], "seek") == 0) {
+        uint32_t sequence;
+        if (argc != 3 || !command_parse_u32(argv[2], &value)) {
+            return COMMAND_ERROR_USAGE;
+        }
+        if (!logger_seek_ms(value, &sequence)) {
+            return COMMAND_ERROR_RANGE;
+        }
+        snprintf(uart_buffer, sizeof(uart_buffer), "log seek %lu ms -> page %lu\r\n",
+                 value, sequence);
+        uart_send_string(uart_buffer);
+        return COMMAND_OK;
+    }
+    if (argc == 2 && strcmp(argv[1], "stop") == 0) {
+        logger_stop_readback();
+        return COMMAND_OK;
+    }
+    if (argc == 2 && strcmp(argv[1], "erase") == 0) {
+        // Blocks for every sector erase (1-2 s each), so only with acq off
+        if (!acquisition_paused && LOG_ERASE_WHILE_SAMPLING == 0) {
+            return COMMAND_ERROR_UNSUPPORTED;
+        }
+        logger_erase_all();
+    } else if (argc != 1) {
+        return COMMAND_ERROR_USAGE;
+    }
+
+    logger_stats_t ls;
+    logger_get_stats(&ls);
+    if (!ls.enabled) {
+        return COMMAND_ERROR_UNSUPPORTED;
+    }
+
+    int len = snprintf(uart_buffer, sizeof(uart_buffer),
+                       "Log pages %lu (%lu-%lu) | written %lu | dropped %lu | errors %lu | "
+                       "erase max %lu ms | prog max %lu us | wear",
+                       ls.pages_stored, ls.oldest_sequence, ls.newest_sequence, ls.pages_written,
+                       ls.frames_dropped, ls.flash_errors, ls.erase_us_max / 1000U, ls.program_us_max);
+    for (uint8_t s = 0; s < LOG_FLASH_SECTORS && len > 0 && len < (int)sizeof(uart_buffer); s++) {
+        len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " %lu", ls.erase_count[s]);
+    }
+    if (len > 0 && len < (int)sizeof(uart_buffer)) {
+        snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, "%s\r\n",
+                 ls.erase_pending ? " | erase waits for acq off" : "");
+    }
+    uart_send_string(uart_buffer);
+    return COMMAND_OK;
+#else
+    (void)argc;
+    (void)argv;
+    return COMMAND_ERROR_UNSUPPORTED;
+#endif
+}
+
+static command_status_t cmd_err(uint8_t argc, char *argv[]) {
+    static char uart_buffer[96];
+    
+    if (argc == 2 && strcmp(argv[1], "clear") == 0) {
+        error_clear();
+        return COMMAND_OK;
+    }
+    if (argc != 1) {
+        return COMMAND_ERROR_USAGE;
+    }
+    
+    snprintf(uart_buffer, sizeof(uart_buffer), "Err total %lu | logged %lu%s\r\n",
+             error_get_count(), error_get_sequence(), error_is_critical() ? " | CRITICAL" : "");
+    uart_send_string(uart_buffer);
+    
+    error_code_stats_t cs;
+    for (uint8_t i = 0; error_get_code_stats(i, &cs); i++) {
+        if (cs.count == 0) {
+            continue;
+        }
+        snprintf(uart_buffer, sizeof(uart_buffer), "Err 0x%02X %s | n %lu | suppressed %lu\r\n",
+                 (unsigned)cs.code, error_get_string(cs.code), cs.count, cs.suppressed);
+        uart_send_string(uart_buffer);
+    }
+    return COMMAND_OK;
+}
+
+static command_status_t cmd_mem(uint8_t argc, char *argv[]) {
+    (void)argc;
+    (void)argv;
+    print_memory();
+    return COMMAND_OK;
+}
+
+static command_status_t cmd_out(uint8_t argc, char *argv[]) {
+#if ENABLE_USB_CDC
+    static char uart_buffer[112];
+
+    if (argc == 2 && strcmp(argv[1], "uart") == 0) {
+        usb_cdc_set_output(false);
+    } else if (argc == 2 && strcmp(argv[1], "usb") == 0) {
+        usb_cdc_set_output(true);
+    } else if (argc != 1) {
+        return COMMAND_ERROR_USAGE;
+    }
+
+    usb_cdc_stats_t us;
+    usb_cdc_get_stats(&us);
+    snprintf(uart_buffer, sizeof(uart_buffer),
+             "out %s | usb %s | resets %lu | transfers %lu | tx %lu B | discarded %lu B\r\n",
+             (uart_tx_get_route() == UART_TX_ROUTE_EXTERNAL) ? "usb" : "uart",
+             usb_cdc_is_open() ? "open" : (usb_cdc_is_configured() ? "configured" : "detached"),
+             us.resets, us.transfers, us.tx_bytes, us.discarded);
+    uart_send_string(uart_buffer);
+    return COMMAND_OK;
+#else
+    (void)argc;
+    (void)argv;
+    return COMMAND_ERROR_UNSUPPORTED;
+#endif
+}
+#endif
+
+#if SCHED_REPORT_INTERVAL_MS > 0 || ENABLE_COMMAND_INTERFACE
+/**
+ * @brief Print one "Sched NAME | runs N | overruns M | lat L ms" line per task
+ */
+void print_scheduler(void) {
+    static char uart_buffer[80];
+    
+    for (uint8_t id = 0; id < scheduler_get_task_count(); id++) {
+        scheduler_task_info_t info;
+        if (!scheduler_get_task_info(id, &info)) {
+            continue;
+        }
+        
+        int len = snprintf(uart_buffer, sizeof(uart_buffer),
+                           "Sched %-12s | runs %lu | overruns %lu | lat %lu ms\r\n",
+                           info.name, info.runs, info.overruns,
+                           (info.max_latency_ticks * 1000UL) / SCHED_TICK_HZ);
+        if (len > 0) {
+            uart_send_string(uart_buffer);
+        }
+    }
+}
+#endif
+
+#if PIPELINE_REPORT_INTERVAL_MS > 0 || ENABLE_COMMAND_INTERFACE
+/**
+ * @brief Print one line per pipeline stage
+ * 
+ * "Pipe NAME | n N | pass P | smp S | avg A max M cyc | backlog B max C"
+ * Backlog is in the stage's own unit: staging pages for log, bytes in
+ * the TX ring for encode; stages without a queue show 0.
+ */
+void print_pipeline(void) {
+    static char uart_buffer[112];
+    
+    for (uint8_t s = 0; s < app_pipeline.count; s++) {
+        pipeline_stage_stats_t stats;
+        if (!pipeline_get_stats(&app_pipeline, s, &stats)) {
+            continue;
+        }
+        
+        uint32_t avg = (stats.runs != 0) ? (uint32_t)(stats.cycles_total / stats.runs) : 0;
+        int len = snprintf(uart_buffer, sizeof(uart_buffer),
+                           "Pipe %-10s | n %lu | pass %lu | smp %lu | avg %lu max %lu cyc | backlog %u max %u\r\n",
+                           pipeline_get_name(&app_pipeline, s), stats.runs, stats.passed,
+                           stats.samples, avg, stats.cycles_max, stats.backlog, stats.backlog_max);
+        if (len > 0) {
+            uart_send_string(uart_buffer);
+        }
+    }
+}
+#endif
+
+#if POWER_REPORT_INTERVAL_MS > 0
+/**
+ * @brief Print "Power POLICY | sleeps N | stops S | duty D.D% | wake min/avg/max C cyc"
+ * 
+ * Duty cycle is the awake share of the last report interval: elapsed
+ * SysTick time minus cycles halted in Sleep and ticks spent in Stop.
+ */
+void print_power(void) {
+    static const char *const policy_names[] = {"run", "sleep", "stop"};
+    static char uart_buffer[112];
+    static uint32_t last_ticks = 0;
+    static uint64_t last_asleep = 0;
+    
+    power_stats_t ps;
+    power_get_stats(&ps);
+    
+    uint32_t cycles_per_tick = SystemCoreClock / SCHED_TICK_HZ;
+    uint32_t ticks = scheduler_get_ticks();
+    uint64_t asleep = ps.sleep_cycles + (uint64_t)ps.stop_ticks * cycles_per_tick;
+    uint64_t elapsed = (uint64_t)(ticks - last_ticks) * cycles_per_tick;
+    uint64_t slept = asleep - last_asleep;
+    last_ticks = ticks;
+    last_asleep = asleep;
+    
+    uint32_t duty_permille = 1000U;
+    if (elapsed > 0 && slept <= elapsed) {
+        duty_permille = (uint32_t)(1000U - (slept * 1000U) / elapsed);
+    }
+    uint32_t wake_avg = (ps.wake_samples > 0) ? (uint32_t)(ps.wake_latency_total / ps.wake_samples) : 0;
+    
+    int len = snprintf(uart_buffer, sizeof(uart_buffer),
+                       "Power %s | sleeps %lu | stops %lu | duty %lu.%lu%% | wake %lu/%lu/%lu cyc\r\n",
+                       policy_names[power_get_policy()], ps.sleeps, ps.stops,
+                       duty_permille / 10U, duty_permille % 10U,
+                       ps.wake_latency_min, wake_avg, ps.wake_latency_max);
+    if (len > 0) {
+        uart_send_string(uart_buffer);
+    }
+}
+#endif
+
 /**
  * @brief Initialize all system peripherals
  * 
  * Initialization order:
- * 1. UART (for debug output)
- * 2. GPIO (for analog input and LED)
- * 3. DMA (for ADC data transfer)
- * 4. ADC (for analog input)
- * 5. Timer (starts trigger sequence)
- * 6. Enable interrupts
+ * 1. Clock tree (everything below derives from the bus clocks)
+ * 2. UART (for debug output)
+ * 3. GPIO (for analog input and LED)
+ * 4. DMA (for ADC data transfer)
+ * 5. ADC (for analog input)
+ * 6. Timer (starts trigger sequence)
+ * 7. Scheduler (SysTick + tasks)
+ * 8. Enable interrupts
  */
 void system_init(void) {
+    // Configure SYSCLK and bus dividers before any baud/prescaler is set
+    error_init();
+    fault_init();
+    if (clock_init() != CLOCK_STATUS_OK) {
+        clock_failure_halt();
+    }
+    
+    // 64-bit microsecond timebase; captures every sampling trigger
+    timebase_init();
+    
+#if ENABLE_WATCHDOG
+    // Reset cause, retained boot record, then the IWDG starts counting
+    supervisor_init();
+#endif
+    
+    // Idle policy for the scheduler (RTC wakeup timer for POWER_POLICY_STOP)
+    power_init();
+    
+#if ENABLE_PROFILING
+    // Start CYCCNT before any instrumented code runs
+    profile_init();
+#endif
+    pipeline_init(&app_pipeline);
+    
     // Initialize UART first so we can see debug messages
     uart_init();
+    telemetry_init();
+    telemetry_set_sample_bits(ADC_OUTPUT_BITS);
+    
+#if ENABLE_USB_CDC
+    // Virtual COM port; takes over the output ring once the host opens it
+    if (usb_cdc_init()) {
+        usb_cdc_set_output(USB_CDC_OUTPUT_DEFAULT);
+    } else {
+        error_report(ERROR_USB_FAILED, 1, "USB CDC needs the 96 MHz PLL profile, output stays on UART");
+    }
+#endif
+    
+#if ENABLE_TRIGGER
+    // Armed on a rising edge through TRIGGER_LEVEL (channel 0)
+    trigger_init();
+#endif
+    
+#if ENABLE_LOGGING
+    // Index the flash log region and resume after its newest page; the
+    // next sector is erased now, before sampling starts
+    if (logger_init()) {
+        logger_erase_ahead();
+    }
+#endif
+    
+    // Per-channel statistics; FIR low-pass + decimate (ENABLE_FILTER)
+    reset_output_state();
     
     // Initialize GPIO for analog input (PA0) and status LED (PC13)
     gpio_init();
@@ -114,28 +1315,61 @@ void system_init(void) {
     // Initialize DMA for ADC data transfer
     dma_init();
     
-    // Configure DMA buffer address for ADC data
-    DMA2_Stream0->M0AR = (uint32_t)&adc_buffer[0];
-    dma_enable();
+    // Configure DMA ping-pong buffer for ADC data
+    buffers_ready = allocate_buffers() &&
+                    dma_set_block_buffer(adc_buffer, ADC_BLOCK_SIZE * ADC_CHANNELS);
+    if (buffers_ready) {
+        dma_enable();
+    }
     
     // Initialize ADC with timer trigger
     adc_init();
+#if ENABLE_MULTICHANNEL
+    for (uint8_t ch = 0; ch < ADC_CHANNELS; ch++) {
+        active_scan[ch] = scan_channels[ch];
+    }
+    adc_configure_scan(active_scan, ADC_CHANNELS);
+#endif
+#if ENABLE_CALIBRATION
+    // Measure VDDA via VREFINT and fold the gain into the conversion table
+    if (calibration_init() != CAL_STATUS_OK) {
+        error_report(ERROR_ADC_FAILED, 1, "VREFINT calibration failed, using nominal reference");
+    }
+#endif
     
-    // Initialize timer for 100Hz trigger output
+    // Initialize TIM2/TIM3, then the boot sampling mode (SAMPLING_MODE)
     timer_init();
+    if (!sampling_init(SAMPLING_MODE)) {
+        error_report(ERROR_TIMER_FAILED, 1, "ADC_SAMPLE_RATE_HZ not reachable in SAMPLING_MODE, using tim2");
+    }
+    sample_period_us = sampling_get_period_us();
+    apply_output_timing();
+    
+    // SysTick time base, task table and the DMA block event
+    tasks_init();
+    
+    // Baseline the drop/overrun counters of everything initialised above
+    loss_init();
+    
+    // Every buffer is placed; the arena is fixed from here on
+    memory_seal();
     
     // Enable global interrupts
     __enable_irq();
     
-    // Start the timer (this triggers ADC conversions)
-    timer_start();
+    // Start the trigger timer (or the free-running ADC)
+    if (buffers_ready) {
+        sampling_start();
+    }
 }
 
 /**
  * @brief Initialize GPIO pins
  * 
  * PA0:  Analog input (ADC Channel 0)
+ * PA1-PA7: Analog inputs (Channels 1-7, ENABLE_MULTICHANNEL)
  * PA9:  UART TX (already configured in uart_init)
+ * PA10: UART RX (already configured in uart_init)
  * PC13: LED output (status indicator)
  */
 void gpio_init(void) {
@@ -143,10 +1377,12 @@ void gpio_init(void) {
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOAEN;   // Enable GPIOA
     RCC->AHB1ENR |= RCC_AHB1ENR_GPIOCEN;   // Enable GPIOC
     
-    // Configure PA0 as analog input
-    // MODER[1:0] = 11 (analog mode)
-    GPIOA->MODER &= ~(3U << (0 * 2));      // Clear bits
-    GPIOA->MODER |= (3U << (0 * 2));       // Analog mode
+    // Configure PA0..PA(ADC_CHANNELS-1) as analog inputs
+    // MODER[2n+1:2n] = 11 (analog mode)
+    for (uint32_t pin = 0; pin < ADC_CHANNELS; pin++) {
+        GPIOA->MODER &= ~(3U << (pin * 2));    // Clear bits
+        GPIOA->MODER |= (3U << (pin * 2));     // Analog mode
+    }
     
     // Configure PC13 as output (LED)
     // MODER[27:26] = 01 (output mode)
@@ -157,49 +1393,637 @@ void gpio_init(void) {
     GPIOC->ODR |= (1 << 13);
 }
 
+/**
+ * @brief Stop on an HSE/PLL startup failure, blinking the LED
+ * 
+ * Every baud rate and timer setting is built for SYSCLK_FREQ, so on
+ * the 16 MHz HSI fallback neither the UART nor the timebase can be
+ * trusted; the LED (PC13) blinks a few times a second instead,
+ * timed by a busy loop. The IWDG is not running yet, so the part
+ * stays here until reset.
+ */
+void clock_failure_halt(void) {
+    RCC->AHB1ENR |= RCC_AHB1ENR_GPIOCEN;
+    GPIOC->MODER &= ~(3U << (13 * 2));
+    GPIOC->MODER |= (1U << (13 * 2));
+    
+    for (;;) {
+        GPIOC->ODR ^= (1U << 13);
+        for (volatile uint32_t i = 0; i < 16000000UL / 32U; i++);
+    }
+}
+
 /**
  * @brief Print system initialization message to serial terminal
+ * 
+ * The banner is larger than the TX ring, and uart_send_string() refuses
+ * a string that does not fit, so each section waits for the previous
+ * one to drain.
  */
 void print_welcome_message(void) {
+    static char uart_buffer[64];
+    static char scan_list[96];
+    sampling_info_t info;
+    bool several = adc_get_scan_length() > 1U;
+    
+    sampling_get_info(sampling_get_mode(), &info);
+    
     uart_send_string("\r\n");
     uart_send_string("========================================\r\n");
     uart_send_string("STM32F411CE Data Acquisition System\r\n");
-    uart_send_string("100 Hz Timer-Triggered ADC with DMA\r\n");
+    snprintf(uart_buffer, sizeof(uart_buffer), "%lu Hz ADC with DMA, %s sampling\r\n",
+             sampling_get_rate(), info.name);
+    uart_send_string(uart_buffer);
     uart_send_string("========================================\r\n");
     uart_send_string("Configuration:\r\n");
-    uart_send_string("  Timer Frequency: 100 Hz\r\n");
-    uart_send_string("  ADC Channel: 0 (PA0)\r\n");
+    uart_send_string("  System Clock: " CLOCK_PROFILE_NAME "\r\n");
+    uart_tx_flush();
+    print_sampling();
+    uart_tx_flush();
+    format_scan_list(scan_list, sizeof(scan_list));
+    uart_send_string(several ? "  ADC Channels: " : "  ADC Channel: ");
+    uart_send_string(scan_list);
+    uart_send_string(several ? ", scan mode\r\n" : "\r\n");
+#if ENABLE_OVERSAMPLING
+    snprintf(uart_buffer, sizeof(uart_buffer), "  ADC Resolution: %u-bit (0-%lu), %ux oversampled\r\n",
+             (unsigned)ADC_OUTPUT_BITS, (1UL << ADC_OUTPUT_BITS) - 1UL, (unsigned)ADC_OVERSAMPLE_RATIO);
+    uart_send_string(uart_buffer);
+#else
     uart_send_string("  ADC Resolution: 12-bit (0-4095)\r\n");
+#endif
+#if ENABLE_CALIBRATION
+    uart_send_string("  Reference Voltage: VDDA measured via VREFINT\r\n");
+#else
     uart_send_string("  Reference Voltage: 3.3V\r\n");
+#endif
     uart_send_string("  UART Baud Rate: 115200 bps\r\n");
-    uart_send_string("  DMA Mode: Circular, Memory Increment\r\n");
+#if ENABLE_USB_CDC
+    uart_send_string("  USB: CDC virtual COM port (PA11/PA12)\r\n");
+#endif
+    uart_send_string("  DMA Mode: Circular, Half/Full-Transfer Blocks\r\n");
+#if ENABLE_TRIGGER
+    uart_send_string("  Output: triggered capture (rising edge, CH0)\r\n");
+#endif
+#if ENABLE_LOGGING
+    uart_send_string("  Logging: flash sectors 6-7, circular\r\n");
+#endif
+    uart_tx_flush();
+    print_memory();
+#if ENABLE_WATCHDOG
+    uart_tx_flush();
+    print_reset_report();
+#endif
+    print_fault_report();
+    uart_tx_flush();
     uart_send_string("========================================\r\n");
     uart_send_string("System Ready. Waiting for ADC samples...\r\n");
-    uart_send_string("Monitoring ADC Channel 0 (PA0):\r\n\r\n");
+    uart_send_string(several ? "Monitoring ADC Channels " : "Monitoring ADC Channel ");
+    uart_send_string(scan_list);
+    uart_send_string(":\r\n\r\n");
+}
+
+/**
+ * @brief Print the crash record left by a fault before the reset, once
+ * 
+ * "  Fault: TYPE #N | pc P | lr L | sp S | psr X | at T s | task NAME"
+ * "  Fault regs: cfsr C hfsr H mmfar M bfar B | BITS"
+ * "  Fault state: r0 .. r12 | err 0xCC n N | cyc C"
+ * The task name is looked up in this boot's table, which registers the
+ * same tasks in the same order. This also runs from the "fault" task
+ * while sampling, so it never waits for the TX ring: a line that does
+ * not fit ends the call, and the next call continues with that line.
+ * The record is only cleared once all three lines were queued to a
+ * transport that delivers them: USART1, or USB with the port open (a
+ * closed port discards the ring). Otherwise the "fault" task prints it
+ * again once the port opens, or the next boot does.
+ */
+void print_fault_report(void) {
+    static char uart_buffer[160];
+    static bool counted = false;
+    static uint8_t next_line = 0;       // Lines of this pass already queued
+    static bool delivered = true;       // Every line of this pass reached a reader
+    const fault_record_t *fault = fault_get_pending();
+    
+    if (fault == NULL) {
+        return;
+    }
+    
+    scheduler_task_info_t info;
+    const char *task = "-";
+    if (fault->task < SCHEDULER_INVALID_TASK && scheduler_get_task_info((uint8_t)fault->task, &info)) {
+        task = info.name;
+    }
+    
+    if (!counted) {
+        error_report(ERROR_FAULT, 2, "Reset by the fault handler");
+        counted = true;
+    }
+    
+    bool open = true;
+#if ENABLE_USB_CDC
+    open = (uart_tx_get_route() == UART_TX_ROUTE_USART) || usb_cdc_is_open();
+#endif
+    
+    while (next_line < 3) {
+        int len = 0;
+        
+        if (next_line == 0) {
+            delivered = true;
+            len = snprintf(uart_buffer, sizeof(uart_buffer),
+                           "  Fault: %s #%lu | pc 0x%08lX | lr 0x%08lX | sp 0x%08lX | psr 0x%08lX | at %lu.%03lu s | task %s\r\n",
+                           fault_get_name(fault->exception), fault->faults, fault->pc, fault->lr, fault->sp,
+                           fault->xpsr, fault->uptime_ms / 1000U, fault->uptime_ms % 1000U, task);
+        } else if (next_line == 1) {
+            len = snprintf(uart_buffer, sizeof(uart_buffer),
+                           "  Fault regs: cfsr 0x%08lX hfsr 0x%08lX mmfar 0x%08lX bfar 0x%08lX | ",
+                           fault->cfsr, fault->hfsr, fault->mmfar, fault->bfar);
+            if (len > 0 && len < (int)sizeof(uart_buffer) - 2) {
+                fault_describe(fault, &uart_buffer[len], (uint16_t)(sizeof(uart_buffer) - len - 2));
+                strcat(uart_buffer, "\r\n");
+                len = (int)strlen(uart_buffer);
+            }
+        } else {
+            len = snprintf(uart_buffer, sizeof(uart_buffer),
+                           "  Fault state: r0 0x%08lX r1 0x%08lX r2 0x%08lX r3 0x%08lX r12 0x%08lX | err 0x%02lX n %lu | cyc %lu\r\n",
+                           fault->r0, fault->r1, fault->r2, fault->r3, fault->r12,
+                           fault->last_error, fault->error_count, fault->cycles);
+        }
+        if (len <= 0) {
+            return;
+        }
+        if (len >= (int)sizeof(uart_buffer)) {
+            len = (int)sizeof(uart_buffer) - 1;
+        }
+        
+        // Retried on the next call (FAULT_RETRY_INTERVAL_MS) from this line
+        if (uart_tx_free() < (uint16_t)len) {
+            return;
+        }
+        delivered &= open && uart_send_string(uart_buffer);
+        next_line++;
+    }
+    
+    // A pass that went to a closed port starts over from the first line
+    next_line = 0;
+    if (delivered) {
+        fault_clear_pending();
+    }
+}
+
+#if ENABLE_USB_CDC
+/**
+ * @brief Print a fault record the boot banner could not deliver
+ * 
+ * At boot the output usually goes to a USB port no host has opened
+ * yet; the record stays pending until it has been printed to an open
+ * port or, after "out uart", to USART1.
+ */
+void task_fault(void) {
+    if (fault_get_pending() != NULL &&
+        (uart_tx_get_route() == UART_TX_ROUTE_USART || usb_cdc_is_open())) {
+        print_fault_report();
+    }
+}
+#endif
+
+/**
+ * @brief Print the sampling mode table (welcome banner and "mode" command)
+ * 
+ * "  Sampling: MODE at R Hz (P us) | ADCCLK C Hz", then per mode
+ * "  * NAME  MIN..MAX Hz, divisors of STEP | N cyc/frame | jitter J us (LO..HI us, B blocks)"
+ * with * marking the active one. MAX is the declared ceiling for the
+ * current channel list; J is the spread of the block-to-block stamp
+ * interval, measured while the mode last ran.
+ */
+void print_sampling(void) {
+    static char uart_buffer[128];
+    sampling_info_t info;
+    sampling_mode_t active = sampling_get_mode();
+    
+    sampling_get_info(active, &info);
+    snprintf(uart_buffer, sizeof(uart_buffer), "  Sampling: %s at %lu Hz (%lu us) | ADCCLK %lu Hz\r\n",
+             info.name, sampling_get_rate(), sampling_get_period_us(), (uint32_t)ADC_CLOCK_FREQ);
+    uart_send_string(uart_buffer);
+    
+    for (uint8_t m = 0; m < SAMPLING_MODE_COUNT; m++) {
+        int len;
+        
+        sampling_get_info((sampling_mode_t)m, &info);
+        if (info.step_hz != 0) {
+            len = snprintf(uart_buffer, sizeof(uart_buffer), "  %c %-4s  %lu..%lu Hz, divisors of %lu",
+                           (m == active) ? '*' : ' ', info.name, info.min_rate_hz, info.max_rate_hz, info.step_hz);
+        } else {
+            len = snprintf(uart_buffer, sizeof(uart_buffer), "  %c %-4s  %lu Hz fixed",
+                           (m == active) ? '*' : ' ', info.name, info.max_rate_hz);
+        }
+        if (len > 0 && len < (int)sizeof(uart_buffer)) {
+            len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " | %lu cyc/frame", info.frame_cycles);
+        }
+        if (len > 0 && len < (int)sizeof(uart_buffer)) {
+            if (info.jitter.intervals != 0) {
+                len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " | jitter %lu us (%lu..%lu us, %lu blocks)",
+                                info.jitter.interval_max_us - info.jitter.interval_min_us,
+                                info.jitter.interval_min_us, info.jitter.interval_max_us, info.jitter.intervals);
+            } else {
+                len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " | jitter -");
+            }
+        }
+        if (len > 0 && len < (int)sizeof(uart_buffer) - 2) {
+            uart_buffer[len++] = '\r';
+            uart_buffer[len++] = '\n';
+            uart_buffer[len] = '\0';
+            uart_send_string(uart_buffer);
+        }
+    }
+}
+
+/**
+ * @brief Print the RAM budget (welcome banner and "mem" command)
+ * 
+ * "  RAM: R B | static S | arena U/A | stack peak P of T | free F",
+ * then "  Arena: OWNER N | ..." per subsystem. Static covers .data,
+ * .bss and .noinit, the arena included; free is RAM between the heap
+ * start and the deepest stack use that has never been written.
+ */
+void print_memory(void) {
+    static char uart_buffer[128];
+    memory_report_t mem;
+    
+    memory_get_report(&mem);
+    int len = snprintf(uart_buffer, sizeof(uart_buffer),
+                       "  RAM: %lu B | static %lu | arena %lu/%lu | stack peak %lu of %lu | free %lu",
+                       mem.ram_size, mem.static_bytes, mem.arena_used, mem.arena_size,
+                       mem.stack_peak, mem.stack_size, mem.stack_size - mem.stack_peak);
+    if (mem.failures != 0 && len > 0 && len < (int)sizeof(uart_buffer)) {
+        len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " | refused %lu", mem.failures);
+    }
+    if (len > 0 && len < (int)sizeof(uart_buffer) - 2) {
+        uart_buffer[len++] = '\r';
+        uart_buffer[len++] = '\n';
+        uart_buffer[len] = '\0';
+        uart_send_string(uart_buffer);
+    }
+    
+    len = snprintf(uart_buffer, sizeof(uart_buffer), "  Arena:");
+    for (uint8_t o = 0; o < MEMORY_OWNER_COUNT && len > 0 && len < (int)sizeof(uart_buffer); o++) {
+        len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, "%s %s %lu",
+                        (o == 0) ? "" : " |", memory_owner_name((memory_owner_t)o), mem.owner_bytes[o]);
+    }
+    if (len > 0 && len < (int)sizeof(uart_buffer) - 2) {
+        uart_buffer[len++] = '\r';
+        uart_buffer[len++] = '\n';
+        uart_buffer[len] = '\0';
+        uart_send_string(uart_buffer);
+    }
+}
+
+#if ENABLE_WATCHDOG
+/**
+ * @brief Print the retained boot record (welcome banner)
+ * 
+ * "  Reset: CAUSE | boots B | iwdg W | uptime U s", followed after a
+ * supervisor-detected stall by
+ * "  Stall: late STAGES | at T s | dma A / process A / tx A ms | err 0xCC".
+ * An IWDG reset without a stall line means the supervisor itself
+ * stopped running.
+ */
+void print_reset_report(void) {
+    static char uart_buffer[128];
+    const supervisor_retained_t *boot = supervisor_get_retained();
+    
+    snprintf(uart_buffer, sizeof(uart_buffer), "  Reset: %s | boots %lu | iwdg %lu | uptime %lu s\r\n",
+             watchdog_reset_cause_name((reset_cause_t)boot->reset_cause), boot->boots,
+             boot->watchdog_resets, boot->prior_uptime_s);
+    uart_send_string(uart_buffer);
+    
+    if (!boot->stall_valid) {
+        return;
+    }
+    
+    int len = snprintf(uart_buffer, sizeof(uart_buffer), "  Stall: late");
+    for (uint8_t s = 0; s < SUPERVISOR_STAGE_COUNT && len > 0 && len < (int)sizeof(uart_buffer); s++) {
+        if (boot->stall.late_mask & (1UL << s)) {
+            len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " %s",
+                            supervisor_stage_name((supervisor_stage_t)s));
+        }
+    }
+    if (len > 0 && len < (int)sizeof(uart_buffer)) {
+        len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " | at %lu.%03lu s |",
+                        boot->stall.uptime_ms / 1000U, boot->stall.uptime_ms % 1000U);
+    }
+    for (uint8_t s = 0; s < SUPERVISOR_STAGE_COUNT && len > 0 && len < (int)sizeof(uart_buffer); s++) {
+        len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, "%s %s %lu",
+                        (s == 0) ? "" : " /", supervisor_stage_name((supervisor_stage_t)s),
+                        boot->stall.age_ms[s]);
+    }
+    if (len > 0 && len < (int)sizeof(uart_buffer)) {
+        snprintf(&uart_buffer[len], sizeof(uart_buffer) - len, " ms | err 0x%02lX\r\n",
+                 boot->stall.last_error);
+        uart_send_string(uart_buffer);
+    }
+}
+#endif
+
+/**
+ * @brief Pipeline source: count missed blocks, describe the frames
+ */
+static bool stage_acquire(pipeline_block_t *block) {
+    loss_track_block(block->sequence);
+    block->channels = adc_get_scan_length();
+    block->period_us = sample_period_us;
+#if !ENABLE_OVERSAMPLING
+    // Latest conversion of the first scan channel for adc_get_reading()
+    uint16_t frames = block->count / block->channels;
+    if (frames != 0) {
+        adc_publish_reading(block->data[(frames - 1U) * block->channels], ADC_RESOLUTION,
+                            block->timestamp_us + (uint64_t)(frames - 1U) * block->period_us);
+    }
+#endif
+    return true;
+}
+
+#if ENABLE_FILTER
+/**
+ * @brief Low-pass filter and decimate each channel into filtered_block
+ */
+static bool stage_filter(pipeline_block_t *block) {
+    uint8_t channels = block->channels;
+    uint16_t frames = 0;
+    
+    for (uint8_t ch = 0; ch < channels && ch < ADC_CHANNELS; ch++) {
+        frames = fir_decimator_process(&filters[ch], block->data + ch,
+                                       block->count / channels, channels,
+                                       &filtered_block[ch], channels);
+    }
+    block->data = filtered_block;
+    block->count = frames * channels;
+    block->period_us = output_period_us;
+    return block->count != 0;
+}
+#elif ENABLE_OVERSAMPLING
+/**
+ * @brief Reduce each channel 4^k:1 to 12+k bits into oversampled_block
+ */
+static bool stage_oversample(pipeline_block_t *block) {
+    uint8_t channels = block->channels;
+    uint16_t frames = 0;
+    // The first output's group began in the previous block
+    uint64_t carried_us = (uint64_t)oversamplers[0].pending * block->period_us;
+    
+    // Accumulate straight out of the DMA block; no copy of the input
+    for (uint8_t ch = 0; ch < channels && ch < ADC_CHANNELS; ch++) {
+        frames = adc_oversample_block(&oversamplers[ch], block->data + ch, block->count / channels,
+                                      channels, &oversampled_block[ch], channels);
+    }
+    block->data = oversampled_block;
+    block->count = frames * channels;
+    block->timestamp_us -= carried_us;
+    block->period_us = output_period_us;
+
+    if (frames != 0) {
+        adc_publish_reading(oversampled_block[(frames - 1U) * channels], ADC_OUTPUT_BITS,
+                            block->timestamp_us + (uint64_t)(frames - 1U) * block->period_us);
+    }
+    return block->count != 0;
+}
+#endif
+
+#if ENABLE_LOGGING
+/**
+ * @brief Stage the block for the flash log
+ * 
+ * RAM staging only; task_logger programs flash in small batches.
+ */
+static bool stage_log(pipeline_block_t *block) {
+    logger_write_samples(block->data, block->count, block->channels,
+                         block->timestamp_us, block->period_us);
+    return true;
+}
+#endif
+
+#if ENABLE_STATISTICS
+/**
+ * @brief Update running/windowed statistics of every channel
+ * 
+ * In summary format the block ends here; one "Stats" line per channel
+ * is printed every STATS_REPORT_INTERVAL_MS.
+ */
+static bool stage_stats(pipeline_block_t *block) {
+    uint8_t channels = block->channels;
+    uint16_t frames = block->count / channels;
+    
+    for (uint8_t ch = 0; ch < channels && ch < ADC_CHANNELS; ch++) {
+        stats_update_block(&channel_stats[ch], block->data + ch, frames, channels);
+    }
+
+    if (telemetry_get_format() != TELEMETRY_OUTPUT_SUMMARY) {
+        return true;
+    }
+    
+    sample_count += frames;
+    stats_report_frames += frames;
+    if (stats_report_frames >= (STATS_REPORT_INTERVAL_MS * 1000UL) / block->period_us) {
+        print_statistics();
+        for (uint8_t ch = 0; ch < channels && ch < ADC_CHANNELS; ch++) {
+            stats_reset_running(&channel_stats[ch]);
+        }
+        stats_report_frames = 0;
+    }
+    return false;
+}
+#endif
+
+#if ENABLE_TRIGGER
+/**
+ * @brief Feed the trigger engine; only frozen windows leave the board
+ * 
+ * task_trigger drains captured windows, so nothing is streamed here.
+ */
+static bool stage_trigger(pipeline_block_t *block) {
+    trigger_process_block(block->data, block->count, block->channels,
+                          block->timestamp_us, block->period_us);
+    sample_count += block->count / block->channels;
+    return false;
+}
+#else
+/**
+ * @brief Encode the block into the TX ring
+ * 
+ * Binary format sends the whole block as one packed frame; ASCII
+ * formats one line per sample (single channel) or per scan frame.
+ */
+static bool stage_encode(pipeline_block_t *block) {
+    const uint16_t *samples = block->data;
+    uint16_t count = block->count;
+    uint8_t channels = block->channels;
+    
+    if (telemetry_get_format() == TELEMETRY_OUTPUT_BINARY) {
+        // Frames carry the low 32 bits of the first input frame's trigger time
+        PROFILE_BEGIN(PROFILE_PROBE_TELEMETRY_SEND);
+        telemetry_send_samples(samples, count, channels, (uint32_t)block->timestamp_us);
+        PROFILE_END(PROFILE_PROBE_TELEMETRY_SEND);
+        sample_count += count / channels;
+        return true;
+    }
+
+    if (channels == 1) {
+#if ENCODE_SPLIT_LUT
+        // Volts and millivolts come pre-split from one lookup per sample
+        for (uint16_t i = 0; i < count; i++) {
+            process_adc_sample(samples[i], 0);
+        }
+#else
+        // One table walk for the whole block, then format
+        adc_convert_block_mv(samples, mv_block, count, ADC_OUTPUT_BITS);
+        for (uint16_t i = 0; i < count; i++) {
+            process_adc_sample(samples[i], mv_block[i]);
+        }
+#endif
+        return true;
+    }
+
+    adc_channel_view_t views[ADC_MAX_SCAN_CHANNELS];
+    for (uint8_t ch = 0; ch < channels; ch++) {
+        adc_get_channel_view(samples, count, ch, &views[ch]);
+    }
+
+    for (uint16_t frame = 0; frame < views[0].count; frame++) {
+        process_adc_frame(views, channels, frame);
+    }
+    return true;
+}
+#endif
+
+#if ENABLE_STATISTICS
+/**
+ * @brief Print one statistics line per channel
+ * 
+ * "Stats ch N | n C | min A max B | mean M | sd S | rms R | win ..."
+ * Running figures cover the samples since the last report; "win"
+ * figures cover the last STATS_WINDOW_SIZE samples. Values are in
+ * output counts (ADC_OUTPUT_BITS wide) with two decimals.
+ */
+void print_statistics(void) {
+    static char uart_buffer[160];
+    uint8_t channels = adc_get_scan_length();
+    
+    for (uint8_t ch = 0; ch < channels && ch < ADC_CHANNELS; ch++) {
+        stats_summary_t run;
+        stats_summary_t win;
+        stats_get_summary(&channel_stats[ch], &run);
+        stats_get_window_summary(&channel_stats[ch], &win);
+        
+        // Q8 -> whole.hundredths
+        int len = snprintf(uart_buffer, sizeof(uart_buffer),
+                           "Stats ch %u | n %lu | min %u max %u | mean %lu.%02lu | sd %lu.%02lu"
+                           " | rms %lu.%02lu | win min %u max %u mean %lu.%02lu sd %lu.%02lu\r\n",
+                           output_channel_number(ch), run.count, run.min, run.max,
+                           run.mean_q8 >> 8, ((run.mean_q8 & 0xFFU) * 100U) >> 8,
+                           run.stddev_q8 >> 8, ((run.stddev_q8 & 0xFFU) * 100U) >> 8,
+                           run.rms_q8 >> 8, ((run.rms_q8 & 0xFFU) * 100U) >> 8,
+                           win.min, win.max,
+                           win.mean_q8 >> 8, ((win.mean_q8 & 0xFFU) * 100U) >> 8,
+                           win.stddev_q8 >> 8, ((win.stddev_q8 & 0xFFU) * 100U) >> 8);
+        
+        if (len > 0) {
+            uart_send_string(uart_buffer);
+        }
+    }
+}
+#endif
+
+#if ENABLE_PROFILING
+/**
+ * @brief Print one line per probe that has recorded anything
+ * 
+ * "Prof NAME | n C | min A avg B max C cyc | max D us | 2^b:n ..."
+ * Histogram bucket b counts intervals of [2^b, 2^(b+1)) cycles.
+ */
+void print_profile(void) {
+    static char uart_buffer[96 + 12 * PROFILE_HISTOGRAM_BINS];
+    
+    for (uint8_t p = 0; p < PROFILE_PROBE_COUNT; p++) {
+        profile_stats_t stats;
+        if (!profile_get((profile_probe_t)p, &stats) || stats.count == 0) {
+            continue;
+        }
+        
+        uint32_t avg = (uint32_t)(stats.total / stats.count);
+        int len = snprintf(uart_buffer, sizeof(uart_buffer),
+                           "Prof %-14s | n %lu | min %lu avg %lu max %lu cyc | max %lu us |",
+                           profile_get_name((profile_probe_t)p), stats.count,
+                           stats.min, avg, stats.max, stats.max / (HCLK_FREQ / 1000000UL));
+        
+        for (uint8_t b = 0; b < PROFILE_HISTOGRAM_BINS && len > 0 && len < (int)sizeof(uart_buffer); b++) {
+            if (stats.histogram[b] != 0) {
+                len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len,
+                                " 2^%u:%lu", b, stats.histogram[b]);
+            }
+        }
+        
+        if (len > 0 && len < (int)sizeof(uart_buffer) - 2) {
+            uart_buffer[len++] = '\r';
+            uart_buffer[len++] = '\n';
+            uart_buffer[len] = '\0';
+            uart_send_string(uart_buffer);
+        }
+    }
+}
+#endif
+
+/**
+ * @brief Format one scan frame ("Smp N | 0: XXXX | 1: XXXX ...")
+ * 
+ * @param views Per-channel views into the block
+ * @param channels Number of channels in the frame
+ * @param frame Frame index within the block
+ */
+void process_adc_frame(const adc_channel_view_t *views, uint8_t channels, uint16_t frame) {
+    static char uart_buffer[16 + 12 * ADC_MAX_SCAN_CHANNELS];
+    
+    sample_count++;
+    
+    int len = snprintf(uart_buffer, sizeof(uart_buffer), "Smp %05lu", sample_count);
+    for (uint8_t ch = 0; ch < channels && len > 0 && len < (int)sizeof(uart_buffer); ch++) {
+        len += snprintf(&uart_buffer[len], sizeof(uart_buffer) - len,
+                        " | %u: %4u", output_channel_number(ch), adc_view_get(&views[ch], frame));
+    }
+    
+    if (len > 0 && len < (int)sizeof(uart_buffer) - 2) {
+        uart_buffer[len++] = '\r';
+        uart_buffer[len++] = '\n';
+        uart_buffer[len] = '\0';
+        uart_send_string(uart_buffer);
+    }
 }
 
 /**
  * @brief Process ADC sample and send via UART
  * 
- * Converts raw ADC value to voltage and sends formatted
- * data to serial terminal
+ * Sends the raw value and its voltage (converted for the whole block
+ * by adc_convert_block_mv, or looked up pre-split with
+ * ADC_CONVERT_SPLIT_LUT) as formatted data to serial terminal
  * 
- * @param raw_value Raw 12-bit ADC value (0-4095)
+ * @param raw_value Raw ADC value (ADC_OUTPUT_BITS wide, 0-4095 at 12 bits)
+ * @param voltage_mv Voltage in millivolts (unused with the split table)
  */
-void process_adc_sample(uint16_t raw_value) {
+void process_adc_sample(uint16_t raw_value, uint16_t voltage_mv) {
     static char uart_buffer[64];
+    PROFILE_BEGIN(PROFILE_PROBE_ADC_SAMPLE);
     
     // Increment sample counter
     sample_count++;
     
-    // Convert raw ADC value to voltage (mV)
-    // Voltage(mV) = (ADC_Value × Reference) / Max_Count
-    // = (raw_value × 3300) / 4095
-    uint32_t voltage_mv = (raw_value * 3300) / 4095;
-    
-    // Split voltage into whole and decimal parts
-    uint32_t voltage_whole = voltage_mv / 1000;      // Volts
-    uint32_t voltage_decimal = voltage_mv % 1000;    // Millivolts
+    // Split voltage into whole volts and millivolts
+    uint32_t voltage_whole;
+    uint32_t voltage_decimal;
+#if ENCODE_SPLIT_LUT
+    (void)voltage_mv;
+    adc_convert_raw_to_split(raw_value, &voltage_whole, &voltage_decimal);
+#else
+    voltage_whole = voltage_mv / 1000U;
+    voltage_decimal = voltage_mv % 1000U;
+#endif
     
     // Format message: "Sample #, ADC: XXXX, Voltage: X.XXX V"
     // Using sprintf for formatting, then send via UART
@@ -211,27 +2035,6 @@ void process_adc_sample(uint16_t raw_value) {
     if (len > 0) {
         uart_send_string(uart_buffer);
     }
-}
-
-/**
- * @brief System Clock Configuration
- * 
- * Using HSI (High-Speed Internal) oscillator:
- * - Frequency: 16 MHz (default)
- * - No external crystal required
- * - Sufficient for this application
- */
-// Clock configuration is done by STM32 bootloader
-// Our code uses default 16 MHz HSI
-
-/**
- * @brief Fault Handler - Called on hard fault
- * Indicates system error (useful for debugging)
- */
-void HardFault_Handler(void) {
-    // Flash LED rapidly to indicate error
-    while (1) {
-        GPIOC->ODR ^= (1 << 13);
-        for (volatile int i = 0; i < 100000; i++);
-    }
+    
+    PROFILE_END(PROFILE_PROBE_ADC_SAMPLE);
 }
\ No newline at end of file
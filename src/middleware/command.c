@@ -0,0 +1,209 @@
+#include "middleware/command.h"
+#include "core/uart.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static const command_t *commands = NULL;
+static uint8_t command_count = 0;
+
+static char line[COMMAND_LINE_LENGTH + 1];
+static uint16_t line_length = 0;
+static bool line_overlong = false;          // Discard until the next terminator
+
+static command_stats_t stats;
+
+// "help" in progress: next table line, command_count once all are queued
+static uint8_t help_next = 0;
+static bool help_active = false;
+
+// RX bytes read but not yet parsed (kept while help output waits)
+static uint8_t rx_chunk[32];
+static uint16_t rx_chunk_length = 0;
+static uint16_t rx_chunk_pos = 0;
+
+static const char *const status_text[] = {
+    [COMMAND_OK] = "OK",
+    [COMMAND_ERROR_USAGE] = "ERR usage",
+    [COMMAND_ERROR_RANGE] = "ERR range",
+    [COMMAND_ERROR_UNSUPPORTED] = "ERR unsupported",
+    [COMMAND_ERROR_UNKNOWN] = "ERR unknown",
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+/**
+ * @brief Queue the table's usage lines while they fit in the TX ring
+ *
+ * The whole table can exceed the ring, so this never waits: it stops at
+ * the first line that does not fit and the next poll continues there.
+ *
+ * @return true once every line has been queued
+ */
+static bool command_help_continue(void) {
+    static char buffer[COMMAND_LINE_LENGTH + 32];
+
+    while (help_next < command_count) {
+        const command_t *cmd = &commands[help_next];
+        int len = snprintf(buffer, sizeof(buffer), "  %s\r\n", cmd->usage != NULL ? cmd->usage : cmd->name);
+        if (len > 0 && uart_tx_free() < (uint16_t)len) {
+            return false;
+        }
+        uart_send_string(buffer);
+        help_next++;
+    }
+    return true;
+}
+
+static void command_reply(command_status_t status) {
+    uart_send_string(status_text[status]);
+    uart_send_string("\r\n");
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void command_init(const command_t *table, uint8_t count) {
+    commands = table;
+    command_count = (table != NULL) ? count : 0;
+    line_length = 0;
+    line_overlong = false;
+    help_active = false;
+    rx_chunk_length = 0;
+    rx_chunk_pos = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+command_status_t command_execute(char *text) {
+    char *argv[COMMAND_MAX_ARGS];
+    uint8_t argc = 0;
+
+    if (text == NULL) {
+        return COMMAND_ERROR_USAGE;
+    }
+
+    // Split on blanks in place
+    char *p = text;
+    while (*p != '\0') {
+        while (*p == ' ' || *p == '\t') {
+            *p++ = '\0';
+        }
+        if (*p == '\0') {
+            break;
+        }
+        if (argc == COMMAND_MAX_ARGS) {
+            return COMMAND_ERROR_USAGE;
+        }
+        argv[argc++] = p;
+        while (*p != '\0' && *p != ' ' && *p != '\t') {
+            p++;
+        }
+    }
+
+    if (argc == 0) {
+        return COMMAND_OK;
+    }
+
+    if (strcmp(argv[0], "help") == 0) {
+        help_next = 0;
+        help_active = true;
+        return COMMAND_OK;
+    }
+
+    for (uint8_t i = 0; i < command_count; i++) {
+        if (strcmp(argv[0], commands[i].name) == 0) {
+            return commands[i].handler(argc, argv);
+        }
+    }
+    return COMMAND_ERROR_UNKNOWN;
+}
+
+void command_poll(void) {
+    while (1) {
+        // Finish a help listing (and its OK) before reading further lines
+        if (help_active) {
+            if (!command_help_continue()) {
+                return;
+            }
+            help_active = false;
+            command_reply(COMMAND_OK);
+        }
+
+        if (rx_chunk_pos == rx_chunk_length) {
+            rx_chunk_length = uart_rx_read(rx_chunk, sizeof(rx_chunk));
+            rx_chunk_pos = 0;
+            if (rx_chunk_length == 0) {
+                return;
+            }
+        }
+
+        char c = (char)rx_chunk[rx_chunk_pos++];
+
+        if (c != '\r' && c != '\n') {
+            if (line_length < COMMAND_LINE_LENGTH) {
+                line[line_length++] = c;
+            } else {
+                line_overlong = true;
+            }
+            continue;
+        }
+
+        // Terminator: CR, LF or CRLF (the empty line after CR is ignored)
+        if (line_overlong) {
+            stats.overlong++;
+            stats.errors++;
+            uart_send_string("ERR length\r\n");
+        } else if (line_length > 0) {
+            line[line_length] = '\0';
+            command_status_t status = command_execute(line);
+            stats.lines++;
+            if (status != COMMAND_OK) {
+                stats.errors++;
+            }
+            if (!help_active) {
+                command_reply(status);
+            }
+        }
+        line_length = 0;
+        line_overlong = false;
+    }
+}
+
+bool command_output_pending(void) {
+    return help_active;
+}
+
+void command_get_stats(command_stats_t *out) {
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
+
+bool command_parse_u32(const char *text, uint32_t *value) {
+    uint32_t result = 0;
+
+    if (text == NULL || value == NULL || *text == '\0') {
+        return false;
+    }
+
+    for (; *text != '\0'; text++) {
+        if (*text < '0' || *text > '9') {
+            return false;
+        }
+        uint32_t digit = (uint32_t)(*text - '0');
+        if (result > (0xFFFFFFFFUL - digit) / 10U) {
+            return false;
+        }
+        result = result * 10U + digit;
+    }
+
+    *value = result;
+    return true;
+}
@@ -0,0 +1,159 @@
+#include "middleware/filter.h"
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#include "stm32f4xx.h"
+#define FILTER_USE_SIMD 1
+#else
+#define FILTER_USE_SIMD 0
+#endif
+
+#if (FILTER_MAX_TAPS % 2) != 0
+#error "FILTER_MAX_TAPS must be even"
+#endif
+
+/* ============================================
+   Default Coefficient Table
+   ============================================ */
+
+// 32-tap Hamming-windowed sinc, cutoff 0.1 fs (0.8 x post-decimation
+// Nyquist for N = 4), Q15, sum = 32768
+const int16_t filter_lowpass_d4[FILTER_LOWPASS_D4_TAPS] = {
+      -17,    20,    73,   135,   164,    91,  -129,  -466,
+     -783,  -850,  -435,   588,  2141,  3927,  5501,  6424,
+     6424,  5501,  3927,  2141,   588,  -435,  -850,  -783,
+     -466,  -129,    91,   164,   135,    73,    20,   -17
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+/**
+ * @brief Dot product of num_taps samples with the reversed coefficients
+ *
+ * num_taps is even. SIMD path: each SMLAD multiplies two packed 16-bit
+ * sample/coefficient pairs and accumulates both products; four pairs
+ * per iteration keep the pipeline busy.
+ */
+static inline int32_t fir_dot(const int16_t *x, const int16_t *c, uint16_t num_taps) {
+#if FILTER_USE_SIMD
+    uint32_t acc = 0;
+    uint16_t k = 0;
+
+    for (; k + 8 <= num_taps; k += 8) {
+        uint32_t x0, x1, x2, x3, c0, c1, c2, c3;
+        memcpy(&x0, &x[k], 4);      // Unaligned LDR is fine on Cortex-M4
+        memcpy(&x1, &x[k + 2], 4);
+        memcpy(&x2, &x[k + 4], 4);
+        memcpy(&x3, &x[k + 6], 4);
+        memcpy(&c0, &c[k], 4);
+        memcpy(&c1, &c[k + 2], 4);
+        memcpy(&c2, &c[k + 4], 4);
+        memcpy(&c3, &c[k + 6], 4);
+        acc = __SMLAD(x0, c0, acc);
+        acc = __SMLAD(x1, c1, acc);
+        acc = __SMLAD(x2, c2, acc);
+        acc = __SMLAD(x3, c3, acc);
+    }
+
+    for (; k < num_taps; k += 2) {
+        uint32_t xp, cp;
+        memcpy(&xp, &x[k], 4);
+        memcpy(&cp, &c[k], 4);
+        acc = __SMLAD(xp, cp, acc);
+    }
+
+    return (int32_t)acc;
+#else
+    int32_t acc = 0;
+    for (uint16_t k = 0; k < num_taps; k++) {
+        acc += (int32_t)x[k] * c[k];
+    }
+    return acc;
+#endif
+}
+
+static inline uint16_t fir_round_clamp(int32_t acc) {
+    // Q15 -> integer with rounding, clamped to the 12-bit ADC range
+    int32_t y = (acc + (1 << 14)) >> 15;
+    if (y < 0) {
+        y = 0;
+    } else if (y > ADC_MAX_VALUE) {
+        y = ADC_MAX_VALUE;
+    }
+    return (uint16_t)y;
+}
+
+/* ============================================
+   FIR Decimator Implementation
+   ============================================ */
+
+bool fir_decimator_init(fir_decimator_t *f, const int16_t *coeffs, uint16_t num_taps,
+                        uint16_t decimation) {
+    if (f == NULL || coeffs == NULL || num_taps == 0 || num_taps > FILTER_MAX_TAPS ||
+        decimation == 0) {
+        return false;
+    }
+
+    // Reverse so the dot product walks samples and coefficients forward;
+    // odd lengths get a leading zero tap so pairs stay aligned
+    uint16_t padded = (uint16_t)((num_taps + 1U) & ~1U);
+    memset(f->coeffs, 0, sizeof(f->coeffs));
+    for (uint16_t i = 0; i < num_taps; i++) {
+        f->coeffs[padded - 1 - i] = coeffs[i];
+    }
+
+    f->num_taps = padded;
+    f->decimation = decimation;
+    fir_decimator_reset(f);
+
+    return true;
+}
+
+void fir_decimator_reset(fir_decimator_t *f) {
+    if (f == NULL) {
+        return;
+    }
+
+    memset(f->state, 0, sizeof(f->state));
+    f->phase = f->decimation - 1;
+}
+
+uint16_t fir_decimator_process(fir_decimator_t *f, const uint16_t *in, uint16_t count,
+                               uint16_t in_stride, uint16_t *out, uint16_t out_stride) {
+    if (f == NULL || in == NULL || out == NULL) {
+        return 0;
+    }
+
+    const uint16_t history = f->num_taps - 1;
+    uint16_t produced = 0;
+
+    while (count > 0) {
+        uint16_t chunk = (count > FILTER_MAX_INPUT) ? FILTER_MAX_INPUT : count;
+
+        // Append chunk after the history (12-bit samples fit int16)
+        int16_t *x = &f->state[history];
+        for (uint16_t i = 0; i < chunk; i++) {
+            x[i] = (int16_t)in[(uint32_t)i * in_stride];
+        }
+
+        // Only compute kept outputs: n indexes the newest sample of each window
+        uint16_t n = f->phase;
+        for (; n < chunk; n += f->decimation) {
+            int32_t acc = fir_dot(&f->state[n], f->coeffs, f->num_taps);
+            out[(uint32_t)produced * out_stride] = fir_round_clamp(acc);
+            produced++;
+        }
+        f->phase = n - chunk;
+
+        // Keep the last num_taps - 1 samples as history for the next chunk
+        memmove(f->state, &f->state[chunk], history * sizeof(int16_t));
+
+        in += (uint32_t)chunk * in_stride;
+        count -= chunk;
+    }
+
+    return produced;
+}
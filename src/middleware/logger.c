@@ -0,0 +1,596 @@
+#include "middleware/logger.h"
+#include "middleware/telemetry.h"
+#include "core/flash.h"
+#include "core/timebase.h"
+#include "core/uart.h"
+#include "core/watchdog.h"
+#include "utils/error.h"
+#include "utils/memory.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#if LOG_FLASH_FIRST_SECTOR < 5 || (LOG_FLASH_FIRST_SECTOR + LOG_FLASH_SECTORS) > FLASH_SECTOR_COUNT
+#error "Log region must lie within the 128 KB sectors 5-7"
+#endif
+
+#if (LOGGER_SECTOR_SIZE % LOG_PAGE_SIZE) != 0 || (LOG_PAGE_SIZE % 4) != 0
+#error "LOG_PAGE_SIZE must be a multiple of 4 dividing the sector size"
+#endif
+
+#if LOG_PAGE_SIZE < (LOGGER_PAGE_HEADER_SIZE + TELEMETRY_FRAME_MAX_SIZE) || LOG_PAGE_SIZE > 0xFFFF
+#error "LOG_PAGE_SIZE must hold the page header plus a full telemetry frame"
+#endif
+
+#if LOG_BUFFER_SIZE < (2 * LOG_PAGE_SIZE)
+#error "LOG_BUFFER_SIZE must hold at least two staging pages"
+#endif
+
+#if UART_TX_BUFFER_SIZE < TELEMETRY_FRAME_MAX_SIZE
+#error "UART_TX_BUFFER_SIZE must hold a full telemetry frame for readback"
+#endif
+
+#define LOG_STAGING_PAGES   (LOG_BUFFER_SIZE / LOG_PAGE_SIZE)
+#define PAGE_WORDS          (LOG_PAGE_SIZE / 4U)
+#define HEADER_WORDS        (LOGGER_PAGE_HEADER_SIZE / 4U)
+#define HEADER_CRC_BYTES    22U
+#define SLOT_NONE           0xFFFFU
+#define SECTOR_NONE         0xFFU
+
+typedef struct {
+    uint32_t sequence;                  // 0 = slot empty or invalid
+    uint32_t first_ms;                  // First frame timestamp (ms, lower 32 bits)
+    uint16_t end;                       // Header + payload bytes
+} page_index_t;
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static uint32_t region_base = 0;
+
+// Staging pages form a queue: program_page is the oldest full page,
+// the page after the last queued one is open for new frames. The pages
+// are drawn from the arena by logger_init().
+static uint32_t (*staging)[PAGE_WORDS] = NULL;
+static uint16_t staging_used[LOG_STAGING_PAGES];
+static uint64_t staging_first_us[LOG_STAGING_PAGES];
+static uint8_t program_page = 0;
+static uint8_t queued = 0;
+static bool filling = false;
+static uint16_t program_word = 0;               // 0 = page not started
+
+static page_index_t page_index[LOGGER_PAGE_COUNT];
+static uint16_t write_slot = 0;
+static bool erase_allowed = (LOG_ERASE_WHILE_SAMPLING != 0);
+static uint8_t erased_sector = SECTOR_NONE;     // Next sector, known blank
+static uint32_t next_sequence = 1;
+static uint16_t frame_sequence = 0;
+
+static bool reading = false;
+static uint32_t read_sequence = 0;
+static uint32_t read_last = 0;
+static uint16_t read_slot = SLOT_NONE;
+static uint16_t read_offset = 0;                // 0 = locate read_sequence
+static uint32_t read_frames = 0;
+
+static uint8_t frame[TELEMETRY_FRAME_MAX_SIZE];
+static logger_stats_t stats;
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static uint32_t slot_address(uint16_t slot) {
+    return region_base + (uint32_t)slot * LOG_PAGE_SIZE;
+}
+
+static uint8_t fill_page(void) {
+    return (uint8_t)((program_page + queued) % LOG_STAGING_PAGES);
+}
+
+/**
+ * @brief Recompute pages_stored and the oldest/newest sequence from the index
+ */
+static void refresh_extent(void) {
+    stats.pages_stored = 0;
+    stats.oldest_sequence = 0;
+    stats.newest_sequence = 0;
+
+    for (uint16_t slot = 0; slot < LOGGER_PAGE_COUNT; slot++) {
+        uint32_t seq = page_index[slot].sequence;
+        if (seq == 0) {
+            continue;
+        }
+        stats.pages_stored++;
+        if (stats.oldest_sequence == 0 || seq < stats.oldest_sequence) {
+            stats.oldest_sequence = seq;
+        }
+        if (seq > stats.newest_sequence) {
+            stats.newest_sequence = seq;
+        }
+    }
+}
+
+/**
+ * @brief Find the stored page with the lowest sequence >= sequence
+ * @return Slot, SLOT_NONE if there is none
+ */
+static uint16_t find_slot(uint32_t sequence, uint32_t *found) {
+    uint16_t best = SLOT_NONE;
+
+    for (uint16_t slot = 0; slot < LOGGER_PAGE_COUNT; slot++) {
+        uint32_t seq = page_index[slot].sequence;
+        if (seq >= sequence && seq != 0 &&
+            (best == SLOT_NONE || seq < page_index[best].sequence)) {
+            best = slot;
+        }
+    }
+    if (best != SLOT_NONE) {
+        *found = page_index[best].sequence;
+    }
+    return best;
+}
+
+/**
+ * @brief Validate a page header in flash
+ * @return true and the header fields if magic, CRC and length check out
+ */
+static bool read_header(uint16_t slot, page_index_t *entry, uint32_t *erase_count) {
+    const uint32_t *h = (const uint32_t *)slot_address(slot);
+
+    if (h[0] != LOGGER_PAGE_MAGIC || h[1] == 0 || h[1] == 0xFFFFFFFFUL) {
+        return false;
+    }
+    if ((h[5] >> 16) != telemetry_crc16(0xFFFF, (const uint8_t *)h, HEADER_CRC_BYTES)) {
+        return false;
+    }
+    uint32_t payload = h[5] & 0xFFFFU;
+    if (payload > LOG_PAGE_SIZE - LOGGER_PAGE_HEADER_SIZE) {
+        return false;
+    }
+
+    entry->sequence = h[1];
+    entry->first_ms = (uint32_t)((((uint64_t)h[4] << 32) | h[3]) / 1000U);
+    entry->end = (uint16_t)(LOGGER_PAGE_HEADER_SIZE + payload);
+    *erase_count = h[2];
+    return true;
+}
+
+/**
+ * @brief Erase one sector of the region and drop its pages from the index
+ */
+static bool erase_sector(uint8_t sector) {
+    for (uint16_t i = 0; i < LOGGER_PAGES_PER_SECTOR; i++) {
+        page_index[sector * LOGGER_PAGES_PER_SECTOR + i].sequence = 0;
+    }
+    refresh_extent();
+
+    uint32_t start = timebase_now_us32();
+    flash_status_t status = flash_erase_sector((uint8_t)(LOG_FLASH_FIRST_SECTOR + sector));
+    uint32_t elapsed = timebase_now_us32() - start;
+
+    if (elapsed > stats.erase_us_max) {
+        stats.erase_us_max = elapsed;
+    }
+    if (status != FLASH_STATUS_OK) {
+        stats.flash_errors++;
+        error_report(ERROR_FLASH_FAILED, 1, "Log sector erase failed");
+        return false;
+    }
+    stats.erases++;
+    stats.erase_count[sector]++;
+    return true;
+}
+
+/**
+ * @brief Sector the writer enters next: its own at a sector boundary
+ * @return SECTOR_NONE if that would be the sector it is filling
+ */
+static uint8_t ahead_sector(void) {
+    uint8_t sector = (uint8_t)(write_slot / LOGGER_PAGES_PER_SECTOR);
+
+    if ((write_slot % LOGGER_PAGES_PER_SECTOR) == 0 && program_word == 0) {
+        return sector;
+    }
+    uint8_t next = (uint8_t)((sector + 1U) % LOG_FLASH_SECTORS);
+    return (next == sector) ? SECTOR_NONE : next;
+}
+
+static void open_page(uint64_t timestamp_us) {
+    uint8_t p = fill_page();
+
+    memset(staging[p], 0xFF, sizeof(staging[p]));
+    staging_used[p] = LOGGER_PAGE_HEADER_SIZE;
+    staging_first_us[p] = timestamp_us;
+    filling = true;
+}
+
+/**
+ * @brief Append one encoded frame, opening a new page when it does not fit
+ * @return false if every staging page is queued for programming
+ */
+static bool stage_frame(const uint8_t *data, uint16_t length, uint64_t timestamp_us) {
+    if (filling && staging_used[fill_page()] + length > LOG_PAGE_SIZE) {
+        logger_flush();
+    }
+    if (!filling) {
+        if (queued == LOG_STAGING_PAGES) {
+            return false;
+        }
+        open_page(timestamp_us);
+    }
+
+    uint8_t p = fill_page();
+    memcpy((uint8_t *)staging[p] + staging_used[p], data, length);
+    staging_used[p] += length;
+    return true;
+}
+
+/**
+ * @brief Write the header words of the page about to be programmed
+ */
+static void build_header(uint8_t p) {
+    uint32_t *h = staging[p];
+    uint8_t sector = (uint8_t)(write_slot / LOGGER_PAGES_PER_SECTOR);
+
+    h[0] = LOGGER_PAGE_MAGIC;
+    h[1] = next_sequence;
+    h[2] = stats.erase_count[sector];
+    h[3] = (uint32_t)staging_first_us[p];
+    h[4] = (uint32_t)(staging_first_us[p] >> 32);
+    h[5] = (uint32_t)(staging_used[p] - LOGGER_PAGE_HEADER_SIZE);
+    h[5] |= (uint32_t)telemetry_crc16(0xFFFF, (const uint8_t *)h, HEADER_CRC_BYTES) << 16;
+}
+
+/**
+ * @brief Program the next batch of the oldest queued page
+ *
+ * Payload words go first, the header in a final batch of its own, so a
+ * reset mid-page leaves a slot without a valid header (skipped).
+ */
+static void program_step(void) {
+    uint8_t p = program_page;
+    uint32_t address = slot_address(write_slot);
+
+    if (program_word == 0) {
+        if ((write_slot % LOGGER_PAGES_PER_SECTOR) == 0) {
+            // Entering a sector: it holds the oldest pages. The erase
+            // stalls every flash fetch, so it waits for an erase window
+            // while sampling; staged frames are dropped meanwhile
+            if (!flash_is_erased(address, LOGGER_SECTOR_SIZE)) {
+                stats.erase_pending = !erase_allowed;
+                if (!erase_allowed || !erase_sector((uint8_t)(write_slot / LOGGER_PAGES_PER_SECTOR))) {
+                    return;
+                }
+            }
+            stats.erase_pending = false;
+            erased_sector = SECTOR_NONE;
+        } else if (!flash_is_erased(address, LOG_PAGE_SIZE)) {
+            // Partly written before a reset; never program over it
+            page_index[write_slot].sequence = 0;
+            write_slot = (uint16_t)((write_slot + 1U) % LOGGER_PAGE_COUNT);
+            return;
+        }
+        build_header(p);
+        program_word = HEADER_WORDS;
+    }
+
+    uint16_t end_word = (uint16_t)((staging_used[p] + 3U) / 4U);
+    bool header = (program_word >= end_word);
+    uint32_t start = timebase_now_us32();
+    flash_status_t status;
+
+    if (!header) {
+        uint16_t words = end_word - program_word;
+        if (words > LOG_PROGRAM_WORDS) {
+            words = LOG_PROGRAM_WORDS;
+        }
+        status = flash_program(address + 4U * program_word, &staging[p][program_word], words);
+        program_word += words;
+    } else {
+        status = flash_program(address, staging[p], HEADER_WORDS);
+    }
+
+    uint32_t elapsed = timebase_now_us32() - start;
+    if (elapsed > stats.program_us_max) {
+        stats.program_us_max = elapsed;
+    }
+
+    if (status != FLASH_STATUS_OK) {
+        // Retry the same page in the next slot
+        stats.flash_errors++;
+        error_report(ERROR_FLASH_FAILED, 1, "Log page program failed");
+        page_index[write_slot].sequence = 0;
+        write_slot = (uint16_t)((write_slot + 1U) % LOGGER_PAGE_COUNT);
+        program_word = 0;
+        return;
+    }
+
+    if (header) {
+        page_index[write_slot].sequence = next_sequence++;
+        page_index[write_slot].first_ms = (uint32_t)(staging_first_us[p] / 1000U);
+        page_index[write_slot].end = staging_used[p];
+        refresh_extent();
+
+        stats.pages_written++;
+        write_slot = (uint16_t)((write_slot + 1U) % LOGGER_PAGE_COUNT);
+        program_word = 0;
+        program_page = (uint8_t)((program_page + 1U) % LOG_STAGING_PAGES);
+        queued--;
+    }
+}
+
+/**
+ * @brief Queue whole stored frames while the TX ring has room for them
+ */
+static void readback_step(void) {
+    static char line[48];
+
+    while (reading) {
+        if (read_offset == 0) {
+            uint32_t seq = 0;
+            uint16_t slot = find_slot(read_sequence, &seq);
+
+            if (slot == SLOT_NONE || seq > read_last) {
+                if (read_sequence <= read_last && read_sequence >= next_sequence) {
+                    return;             // Still staged; programmed shortly
+                }
+                reading = false;
+                snprintf(line, sizeof(line), "Log read done | frames %lu\r\n",
+                         (unsigned long)read_frames);
+                uart_send_string(line);
+                return;
+            }
+            read_sequence = seq;
+            read_slot = slot;
+            read_offset = LOGGER_PAGE_HEADER_SIZE;
+        }
+
+        // The page may have been erased by the rotation since
+        const page_index_t *entry = &page_index[read_slot];
+        const uint8_t *page = (const uint8_t *)slot_address(read_slot);
+        uint16_t length = 0;
+
+        if (entry->sequence == read_sequence && read_offset + TELEMETRY_HEADER_SIZE <= entry->end) {
+            length = telemetry_frame_length(&page[read_offset]);
+        }
+        if (length == 0 || read_offset + length > entry->end) {
+            read_sequence++;
+            read_offset = 0;
+            continue;
+        }
+
+        if (uart_tx_free() < length) {
+            return;
+        }
+        uart_tx_write(&page[read_offset], length);
+        read_offset += length;
+        read_frames++;
+    }
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+bool logger_init(void) {
+    memset(&stats, 0, sizeof(stats));
+    memset(page_index, 0, sizeof(page_index));
+    program_page = 0;
+    queued = 0;
+    filling = false;
+    program_word = 0;
+    frame_sequence = 0;
+    reading = false;
+    erased_sector = SECTOR_NONE;
+
+    region_base = flash_sector_address(LOG_FLASH_FIRST_SECTOR);
+    if (flash_image_end() > region_base) {
+        error_report(ERROR_FLASH_FAILED, 2, "Log region overlaps firmware image");
+        return false;
+    }
+    if (staging == NULL) {
+        staging = memory_alloc(MEMORY_OWNER_LOGGER, LOG_STAGING_PAGES * LOG_PAGE_SIZE);
+        if (staging == NULL) {
+            return false;
+        }
+    }
+    stats.enabled = true;
+
+    uint16_t newest_slot = SLOT_NONE;
+    uint32_t newest = 0;
+    for (uint16_t slot = 0; slot < LOGGER_PAGE_COUNT; slot++) {
+        page_index_t entry;
+        uint32_t erase_count;
+
+        if (!read_header(slot, &entry, &erase_count)) {
+            continue;
+        }
+        page_index[slot] = entry;
+
+        uint8_t sector = (uint8_t)(slot / LOGGER_PAGES_PER_SECTOR);
+        if (erase_count > stats.erase_count[sector]) {
+            stats.erase_count[sector] = erase_count;
+        }
+        if (entry.sequence > newest) {
+            newest = entry.sequence;
+            newest_slot = slot;
+        }
+    }
+
+    // Resume right after the newest page
+    write_slot = (newest_slot == SLOT_NONE) ? 0 : (uint16_t)((newest_slot + 1U) % LOGGER_PAGE_COUNT);
+    next_sequence = newest + 1U;
+    refresh_extent();
+    return true;
+}
+
+bool logger_write_samples(const uint16_t *samples, uint16_t count, uint8_t channels,
+                          uint64_t timestamp_us, uint32_t period_us) {
+    bool ok = true;
+
+    if (!stats.enabled || samples == NULL || channels == 0) {
+        return false;
+    }
+
+    // Same framing as telemetry_send_samples(): whole scan frames only
+    uint16_t max_chunk = TELEMETRY_MAX_SAMPLES - (TELEMETRY_MAX_SAMPLES % channels);
+
+    while (count > 0) {
+        uint16_t chunk = (count > max_chunk) ? max_chunk : count;
+        uint16_t length = telemetry_encode_samples(frame, frame_sequence++, (uint32_t)timestamp_us,
+                                                   channels, samples, chunk);
+
+        if (stage_frame(frame, length, timestamp_us)) {
+            stats.frames_logged++;
+        } else {
+            stats.frames_dropped++;
+            ok = false;
+        }
+
+        samples += chunk;
+        count -= chunk;
+        timestamp_us += (uint64_t)(chunk / channels) * period_us;
+    }
+
+    return ok;
+}
+
+void logger_flush(void) {
+    if (filling && staging_used[fill_page()] > LOGGER_PAGE_HEADER_SIZE) {
+        queued++;
+        filling = false;
+    }
+}
+
+void logger_set_erase_allowed(bool allowed) {
+    erase_allowed = allowed || (LOG_ERASE_WHILE_SAMPLING != 0);
+}
+
+bool logger_erase_ahead(void) {
+    uint8_t sector = ahead_sector();
+
+    if (!stats.enabled || sector == SECTOR_NONE || sector == erased_sector) {
+        return true;
+    }
+    // Readback may be streaming the oldest pages out of this sector
+    if (reading) {
+        return true;
+    }
+
+    uint32_t address = slot_address((uint16_t)(sector * LOGGER_PAGES_PER_SECTOR));
+    if (!flash_is_erased(address, LOGGER_SECTOR_SIZE)) {
+#if ENABLE_WATCHDOG
+        watchdog_feed();
+#endif
+        if (!erase_sector(sector)) {
+            return false;
+        }
+    }
+    erased_sector = sector;
+    return true;
+}
+
+void logger_service(void) {
+    if (!stats.enabled) {
+        return;
+    }
+    if (erase_allowed && LOG_ERASE_WHILE_SAMPLING == 0 && !logger_erase_ahead()) {
+        // Reported once; retried in the next erase window
+        erase_allowed = false;
+    }
+    if (queued > 0) {
+        program_step();
+    }
+    if (reading) {
+        readback_step();
+    }
+}
+
+void logger_service_readback(void) {
+    if (stats.enabled && reading) {
+        readback_step();
+    }
+}
+
+bool logger_start_readback(uint32_t first_sequence) {
+    if (!stats.enabled) {
+        return false;
+    }
+
+    // Include what is still in RAM: those pages take the next sequences
+    logger_flush();
+    if (stats.pages_stored == 0 && queued == 0) {
+        return false;
+    }
+
+    read_sequence = first_sequence;
+    read_last = next_sequence + queued - 1U;
+    read_offset = 0;
+    read_frames = 0;
+    reading = true;
+    return true;
+}
+
+void logger_stop_readback(void) {
+    reading = false;
+}
+
+bool logger_seek_ms(uint64_t time_ms, uint32_t *sequence) {
+    uint32_t best = 0;
+
+    if (sequence == NULL || stats.pages_stored == 0) {
+        return false;
+    }
+
+    // Timestamps restart at reset: the newest page at or before time_ms wins
+    for (uint16_t slot = 0; slot < LOGGER_PAGE_COUNT; slot++) {
+        const page_index_t *entry = &page_index[slot];
+        if (entry->sequence != 0 && entry->first_ms <= (uint32_t)time_ms && entry->sequence > best) {
+            best = entry->sequence;
+        }
+    }
+
+    *sequence = (best != 0) ? best : stats.oldest_sequence;
+    return true;
+}
+
+bool logger_erase_all(void) {
+    bool ok = true;
+
+    // Three back-to-back sector erases would stall sampling for 3-6 s
+    if (!stats.enabled || !erase_allowed) {
+        return false;
+    }
+
+    reading = false;
+    for (uint8_t sector = 0; sector < LOG_FLASH_SECTORS; sector++) {
+        uint32_t address = slot_address((uint16_t)(sector * LOGGER_PAGES_PER_SECTOR));
+        if (!flash_is_erased(address, LOGGER_SECTOR_SIZE) && !erase_sector(sector)) {
+            ok = false;
+        }
+#if ENABLE_WATCHDOG
+        // Back-to-back erases would add up past WATCHDOG_TIMEOUT_MS
+        watchdog_feed();
+#endif
+    }
+
+    // A page caught mid-program starts over in the first slot
+    write_slot = 0;
+    program_word = 0;
+    stats.erase_pending = false;
+    refresh_extent();
+    return ok;
+}
+
+uint16_t logger_get_backlog(void) {
+    return queued;
+}
+
+void logger_get_stats(logger_stats_t *out) {
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+    out->reading = reading;
+}
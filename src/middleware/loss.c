@@ -0,0 +1,110 @@
+#include "middleware/loss.h"
+#include "middleware/telemetry.h"
+#include "core/adc.h"
+#include "core/dma.h"
+#include "core/uart.h"
+#include "utils/error.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static loss_report_t report;
+static uint32_t baseline[LOSS_COUNTER_COUNT];   // Source counts at loss_init()
+
+static uint32_t expected_sequence = 0;
+static bool sequence_valid = false;
+static uint32_t blocks_missed = 0;
+
+static const char *const counter_names[LOSS_COUNTER_COUNT] = {
+    [LOSS_ADC_OVERRUN] = "adc_ovr",
+    [LOSS_DMA_SAMPLES] = "dma_lost",
+    [LOSS_BLOCKS_MISSED] = "blocks",
+    [LOSS_TX_BYTES] = "tx_bytes",
+    [LOSS_TX_FRAMES] = "tx_frames",
+};
+
+static const error_code_t counter_errors[LOSS_COUNTER_COUNT] = {
+    [LOSS_ADC_OVERRUN] = ERROR_ADC_OVERRUN,
+    [LOSS_DMA_SAMPLES] = ERROR_SAMPLES_DROPPED,
+    [LOSS_BLOCKS_MISSED] = ERROR_SAMPLES_DROPPED,
+    [LOSS_TX_BYTES] = ERROR_TX_DROPPED,
+    [LOSS_TX_FRAMES] = ERROR_TX_DROPPED,
+};
+
+static const char *const counter_messages[LOSS_COUNTER_COUNT] = {
+    [LOSS_ADC_OVERRUN] = "ADC overrun, conversions lost",
+    [LOSS_DMA_SAMPLES] = "DMA resync discarded a partial block",
+    [LOSS_BLOCKS_MISSED] = "Block overwritten before processing",
+    [LOSS_TX_BYTES] = "UART TX ring full, bytes dropped",
+    [LOSS_TX_FRAMES] = "Telemetry frame dropped",
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static void loss_read_sources(uint32_t counts[LOSS_COUNTER_COUNT]) {
+    counts[LOSS_ADC_OVERRUN] = adc_get_overrun_count();
+    counts[LOSS_DMA_SAMPLES] = dma_get_lost_samples();
+    counts[LOSS_BLOCKS_MISSED] = blocks_missed;
+    counts[LOSS_TX_BYTES] = uart_tx_get_dropped();
+    counts[LOSS_TX_FRAMES] = telemetry_get_dropped_frames();
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void loss_init(void) {
+    memset(&report, 0, sizeof(report));
+    sequence_valid = false;
+    blocks_missed = 0;
+
+    loss_read_sources(baseline);
+}
+
+void loss_track_block(uint32_t sequence) {
+    // Sequence numbers count every finished half, consumed or not; a
+    // lower number means the block buffer was reprogrammed, so resync
+    if (sequence_valid && sequence > expected_sequence) {
+        blocks_missed += sequence - expected_sequence;
+    }
+    expected_sequence = sequence + 1U;
+    sequence_valid = true;
+    report.blocks_seen++;
+}
+
+bool loss_poll(void) {
+    uint32_t counts[LOSS_COUNTER_COUNT];
+    bool lost = false;
+
+    loss_read_sources(counts);
+
+    for (uint8_t c = 0; c < LOSS_COUNTER_COUNT; c++) {
+        uint32_t total = counts[c] - baseline[c];
+        if (total != report.counters[c]) {
+            error_report(counter_errors[c], 1, counter_messages[c]);
+            lost = true;
+        }
+        report.counters[c] = total;
+    }
+    report.tx_high_water = uart_tx_get_high_water();
+
+    return lost;
+}
+
+void loss_get(loss_report_t *out) {
+    if (out == NULL) {
+        return;
+    }
+    *out = report;
+}
+
+const char *loss_get_name(loss_counter_t counter) {
+    if (counter >= LOSS_COUNTER_COUNT) {
+        return "?";
+    }
+    return counter_names[counter];
+}
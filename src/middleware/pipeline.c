@@ -0,0 +1,31 @@
+#include "middleware/pipeline.h"
+#include <string.h>
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void pipeline_init(const pipeline_t *pipe) {
+    // Same counter as utils/profile.h; enabling it twice is harmless
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    pipeline_reset(pipe);
+}
+
+void pipeline_reset(const pipeline_t *pipe) {
+    memset(pipe->stats, 0, pipe->count * sizeof(pipe->stats[0]));
+}
+
+bool pipeline_get_stats(const pipeline_t *pipe, uint8_t stage, pipeline_stage_stats_t *out) {
+    if (stage >= pipe->count || out == NULL) {
+        return false;
+    }
+
+    *out = pipe->stats[stage];
+    return true;
+}
+
+const char *pipeline_get_name(const pipeline_t *pipe, uint8_t stage) {
+    return (stage < pipe->count) ? pipe->names[stage] : "?";
+}
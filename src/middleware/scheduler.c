@@ -0,0 +1,215 @@
+#include "middleware/scheduler.h"
+#include "core/power.h"
+#include "stm32f4xx.h"
+#include <stddef.h>
+#include <string.h>
+
+#if SCHED_MAX_TASKS >= SCHEDULER_INVALID_TASK
+#error "SCHED_MAX_TASKS must be below SCHEDULER_INVALID_TASK"
+#endif
+
+/* ============================================
+   Task Table
+   ============================================ */
+typedef struct {
+    scheduler_task_fn run;
+    scheduler_task_info_t info;
+    uint32_t next_release;              // Tick of the next periodic release
+    uint32_t released_at;               // Tick of the pending release
+    volatile bool event_pending;        // Set by ISRs, cleared on dispatch
+    volatile uint32_t event_overruns;   // ISR-owned
+    bool period_pending;
+} scheduler_slot_t;
+
+static scheduler_slot_t tasks[SCHED_MAX_TASKS];
+static uint8_t task_order[SCHED_MAX_TASKS];    // Slot indices by priority
+static uint8_t task_count = 0;
+static volatile uint32_t scheduler_ticks = 0;
+static volatile uint8_t running_task = SCHEDULER_INVALID_TASK;
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static bool scheduler_tick_reached(uint32_t now, uint32_t deadline) {
+    // Wrap-safe "now >= deadline"
+    return (int32_t)(now - deadline) >= 0;
+}
+
+/**
+ * @brief Fold elapsed periods into the pending flag
+ *
+ * Every period that elapsed while the task was already pending is an
+ * overrun; next_release stays on the original grid so the task does
+ * not drift.
+ */
+static void scheduler_update_period(scheduler_slot_t *t, uint32_t now) {
+    if (t->info.period_ticks == 0 || !scheduler_tick_reached(now, t->next_release)) {
+        return;
+    }
+
+    uint32_t late = now - t->next_release;
+    uint32_t releases = late / t->info.period_ticks + 1U;
+
+    if (t->period_pending) {
+        t->info.overruns += releases;
+    } else {
+        t->info.overruns += releases - 1U;
+        t->period_pending = true;
+        t->released_at = t->next_release;
+    }
+    t->next_release += releases * t->info.period_ticks;
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void scheduler_init(void) {
+    memset(tasks, 0, sizeof(tasks));
+    task_count = 0;
+    scheduler_ticks = 0;
+
+    // SysTick from HCLK (SystemCoreClock tracks an HSI fallback)
+    SysTick->LOAD = (SystemCoreClock / SCHED_TICK_HZ) - 1U;
+    SysTick->VAL = 0;
+    NVIC_SetPriority(SysTick_IRQn, INTERRUPT_PRIORITY + 2);
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+uint8_t scheduler_add_task(const char *name, scheduler_task_fn run, uint32_t period_ms,
+                           uint8_t priority) {
+    if (run == NULL || task_count >= SCHED_MAX_TASKS) {
+        return SCHEDULER_INVALID_TASK;
+    }
+
+    uint8_t id = task_count;
+    scheduler_slot_t *t = &tasks[id];
+    t->run = run;
+    t->info.name = name;
+    t->info.priority = priority;
+    t->info.period_ticks = (period_ms > 0) ? SCHEDULER_MS_TO_TICKS(period_ms) : 0;
+    t->next_release = scheduler_ticks + t->info.period_ticks;
+
+    // Insertion into the priority order, stable for equal priorities
+    uint8_t pos = task_count;
+    while (pos > 0 && tasks[task_order[pos - 1]].info.priority > priority) {
+        task_order[pos] = task_order[pos - 1];
+        pos--;
+    }
+    task_order[pos] = id;
+    task_count++;
+
+    return id;
+}
+
+void scheduler_post_event(uint8_t id) {
+    if (id >= task_count) {
+        return;
+    }
+
+    scheduler_slot_t *t = &tasks[id];
+    if (t->event_pending) {
+        t->event_overruns++;
+    } else {
+        t->released_at = scheduler_ticks;
+        t->event_pending = true;
+    }
+}
+
+bool scheduler_run_once(void) {
+    uint32_t now = scheduler_ticks;
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        scheduler_slot_t *t = &tasks[task_order[i]];
+        scheduler_update_period(t, now);
+
+        if (!t->event_pending && !t->period_pending) {
+            continue;
+        }
+
+        // Clear before running so a release during the run is kept
+        uint32_t latency = now - t->released_at;
+        t->event_pending = false;
+        t->period_pending = false;
+        if (latency > t->info.max_latency_ticks) {
+            t->info.max_latency_ticks = latency;
+        }
+
+        running_task = task_order[i];
+        t->run();
+        running_task = SCHEDULER_INVALID_TASK;
+        t->info.runs++;
+        return true;
+    }
+
+    return false;
+}
+
+void scheduler_run(void) {
+    while (1) {
+        if (scheduler_run_once()) {
+            continue;
+        }
+
+        // Re-check with interrupts masked: WFI still wakes on a pending
+        // interrupt, so a release between the scan and WFI is not lost
+        __disable_irq();
+        bool idle = true;
+        uint32_t now = scheduler_ticks;
+        uint32_t idle_ticks = UINT32_MAX;
+        for (uint8_t i = 0; i < task_count && idle; i++) {
+            scheduler_slot_t *t = &tasks[i];
+            if (t->event_pending || t->period_pending) {
+                idle = false;
+            } else if (t->info.period_ticks != 0) {
+                if (scheduler_tick_reached(now, t->next_release)) {
+                    idle = false;
+                } else if (t->next_release - now < idle_ticks) {
+                    idle_ticks = t->next_release - now;
+                }
+            }
+        }
+        if (idle) {
+            // Stop mode halts SysTick; credit the time spent there
+            scheduler_ticks += power_idle(idle_ticks);
+        }
+        __enable_irq();
+    }
+}
+
+uint32_t scheduler_get_ticks(void) {
+    return scheduler_ticks;
+}
+
+uint8_t scheduler_get_running_task(void) {
+    return running_task;
+}
+
+uint8_t scheduler_get_task_count(void) {
+    return task_count;
+}
+
+bool scheduler_get_task_info(uint8_t id, scheduler_task_info_t *info) {
+    if (id >= task_count || info == NULL) {
+        return false;
+    }
+
+    *info = tasks[id].info;
+    info->overruns += tasks[id].event_overruns;
+    return true;
+}
+
+/* ============================================
+   Interrupt Handler
+   ============================================ */
+
+/**
+ * @brief SysTick interrupt: advance the scheduler time base
+ *
+ * Releases are evaluated lazily in scheduler_run_once(), so the ISR is
+ * a single increment.
+ */
+void SysTick_Handler(void) {
+    scheduler_ticks++;
+}
@@ -0,0 +1,157 @@
+#include "middleware/supervisor.h"
+#include "core/timebase.h"
+#include "utils/error.h"
+#include <stddef.h>
+#include <string.h>
+
+#define SUPERVISOR_DEADLINE_MAX_US  0x7FFFFFFFUL    // Ages are 32-bit us differences
+
+/* ============================================
+   Static Variables
+   ============================================ */
+
+// Not zeroed by the startup code; validated in supervisor_init()
+static supervisor_retained_t retained __attribute__((section(".noinit")));
+
+static volatile uint32_t checkin_us[SUPERVISOR_STAGE_COUNT];
+static uint32_t deadline_us[SUPERVISOR_STAGE_COUNT];    // 0 = unsupervised
+static bool stalled = false;
+
+static const char *const stage_names[SUPERVISOR_STAGE_COUNT] = {
+    [SUPERVISOR_STAGE_DMA] = "dma",
+    [SUPERVISOR_STAGE_PROCESS] = "process",
+    [SUPERVISOR_STAGE_TX] = "tx",
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static uint32_t retained_checksum(void) {
+    const uint32_t *words = (const uint32_t *)&retained;
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < offsetof(supervisor_retained_t, checksum) / sizeof(uint32_t); i++) {
+        sum = (sum << 1 | sum >> 31) ^ words[i];
+    }
+    return ~sum;
+}
+
+static void retained_seal(void) {
+    retained.checksum = retained_checksum();
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void supervisor_init(void) {
+    reset_cause_t cause = watchdog_read_reset_cause();
+    bool valid = retained.magic == SUPERVISOR_RETAINED_MAGIC && retained.checksum == retained_checksum();
+
+    // SRAM content is undefined after power loss, whatever the checksum says
+    if (!valid || cause == RESET_CAUSE_POWER_ON || cause == RESET_CAUSE_BROWN_OUT) {
+        memset(&retained, 0, sizeof(retained));
+        retained.magic = SUPERVISOR_RETAINED_MAGIC;
+    } else {
+        retained.prior_uptime_s += retained.uptime_ms / 1000U;
+    }
+
+    retained.boots++;
+    if (cause == RESET_CAUSE_IWDG) {
+        retained.watchdog_resets++;
+    } else {
+        // A stall is only the story of an IWDG reset
+        retained.stall_valid = 0;
+    }
+    retained.reset_cause = cause;
+    retained.uptime_ms = 0;
+    retained_seal();
+
+    uint32_t now = timebase_now_us32();
+    for (uint8_t s = 0; s < SUPERVISOR_STAGE_COUNT; s++) {
+        checkin_us[s] = now;
+        deadline_us[s] = 0;
+    }
+    stalled = false;
+
+    if (!watchdog_init(WATCHDOG_TIMEOUT_MS)) {
+        error_report(ERROR_INVALID_PARAM, 2, "WATCHDOG_TIMEOUT_MS out of IWDG range");
+    }
+}
+
+void supervisor_set_period(supervisor_stage_t stage, uint32_t period_us) {
+    if (stage >= SUPERVISOR_STAGE_COUNT) {
+        return;
+    }
+
+    uint64_t deadline = 0;
+    if (period_us > 0) {
+        deadline = 2ULL * period_us + (uint64_t)WATCHDOG_STAGE_MARGIN_MS * 1000U;
+        if (deadline > SUPERVISOR_DEADLINE_MAX_US) {
+            deadline = SUPERVISOR_DEADLINE_MAX_US;
+        }
+    }
+
+    // Restart the clock so a newly supervised stage gets a full deadline
+    checkin_us[stage] = timebase_now_us32();
+    deadline_us[stage] = (uint32_t)deadline;
+}
+
+void supervisor_checkin(supervisor_stage_t stage) {
+    checkin_us[stage] = timebase_now_us32();
+}
+
+bool supervisor_service(void) {
+    if (stalled) {
+        return false;
+    }
+
+    uint32_t now = timebase_now_us32();
+    uint32_t ages[SUPERVISOR_STAGE_COUNT];
+    uint32_t late = 0;
+
+    for (uint8_t s = 0; s < SUPERVISOR_STAGE_COUNT; s++) {
+        ages[s] = now - checkin_us[s];
+        if (deadline_us[s] != 0 && ages[s] > deadline_us[s]) {
+            late |= 1UL << s;
+        }
+    }
+
+    retained.uptime_ms = (uint32_t)timebase_now_ms();
+
+    if (late == 0) {
+        retained_seal();
+        watchdog_feed();
+        return true;
+    }
+
+    // Latch: no more feeding, the IWDG resets us
+    stalled = true;
+    retained.stall_valid = 1;
+    retained.stall.uptime_ms = retained.uptime_ms;
+    retained.stall.late_mask = late;
+    for (uint8_t s = 0; s < SUPERVISOR_STAGE_COUNT; s++) {
+        retained.stall.age_ms[s] = ages[s] / 1000U;
+    }
+    retained.stall.last_error = (uint32_t)error_get_last().code;
+    retained_seal();
+
+    error_report(ERROR_STALL, 3, "Pipeline stage missed its deadline, watchdog reset pending");
+    return false;
+}
+
+const supervisor_retained_t *supervisor_get_retained(void) {
+    return &retained;
+}
+
+uint32_t supervisor_get_uptime_s(void) {
+    return retained.prior_uptime_s + (uint32_t)(timebase_now_ms() / 1000U);
+}
+
+const char *supervisor_stage_name(supervisor_stage_t stage) {
+    if (stage >= SUPERVISOR_STAGE_COUNT) {
+        return "?";
+    }
+    return stage_names[stage];
+}
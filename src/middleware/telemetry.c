@@ -0,0 +1,274 @@
+#include "middleware/telemetry.h"
+#include "core/uart.h"
+#include <stddef.h>
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static telemetry_format_t telemetry_format = (telemetry_format_t)TELEMETRY_FORMAT;
+static uint16_t telemetry_sequence = 0;
+static uint32_t telemetry_period_us = 1000000UL / ADC_SAMPLE_RATE_HZ;
+static uint8_t telemetry_sample_bits = ADC_RESOLUTION;
+static uint32_t telemetry_dropped_frames = 0;
+static uint8_t frame_buffer[TELEMETRY_FRAME_MAX_SIZE];
+
+// CRC-16/CCITT-FALSE lookup table (poly 0x1021, MSB first)
+static const uint16_t crc16_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static inline void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/**
+ * @brief Pack 12-bit samples two per three bytes
+ *
+ * Pair layout: b0 = s0[7:0], b1 = s1[3:0] << 4 | s0[11:8], b2 = s1[11:4].
+ * An odd trailing sample occupies two bytes (b0, b1 low nibble).
+ */
+static uint16_t pack12(uint8_t *out, const uint16_t *samples, uint16_t count) {
+    uint8_t *p = out;
+    uint16_t i = 0;
+
+    for (; i + 1 < count; i += 2) {
+        uint16_t s0 = samples[i] & 0x0FFF;
+        uint16_t s1 = samples[i + 1] & 0x0FFF;
+        p[0] = (uint8_t)s0;
+        p[1] = (uint8_t)((s0 >> 8) | (s1 << 4));
+        p[2] = (uint8_t)(s1 >> 4);
+        p += 3;
+    }
+
+    if (i < count) {
+        uint16_t s0 = samples[i] & 0x0FFF;
+        p[0] = (uint8_t)s0;
+        p[1] = (uint8_t)(s0 >> 8);
+        p += 2;
+    }
+
+    return (uint16_t)(p - out);
+}
+
+static uint16_t pack16(uint8_t *out, const uint16_t *samples, uint16_t count, uint8_t bits) {
+    out[0] = bits;
+    for (uint16_t i = 0; i < count; i++) {
+        put_u16(&out[1 + 2 * i], samples[i]);
+    }
+    return (uint16_t)TELEMETRY_WIDE_SIZE(count);
+}
+
+/**
+ * @brief Write the header around an already packed payload
+ * @return Frame length in bytes
+ */
+static uint16_t finish_frame(uint8_t *out, uint8_t type, uint8_t channels, uint16_t sequence,
+                             uint16_t count, uint32_t timestamp_us, uint16_t payload) {
+    out[0] = TELEMETRY_SYNC_0;
+    out[1] = TELEMETRY_SYNC_1;
+    out[2] = type;
+    out[3] = channels;
+    put_u16(&out[4], sequence);
+    put_u16(&out[6], count);
+    put_u32(&out[8], timestamp_us);
+
+    // CRC covers the header after the sync word and the payload, not itself
+    uint16_t crc = telemetry_crc16(0xFFFF, &out[2], 10);
+    crc = telemetry_crc16(crc, &out[TELEMETRY_HEADER_SIZE], payload);
+    put_u16(&out[12], crc);
+
+    return (uint16_t)(TELEMETRY_HEADER_SIZE + payload);
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void telemetry_init(void) {
+    telemetry_format = (telemetry_format_t)TELEMETRY_FORMAT;
+    telemetry_sequence = 0;
+    telemetry_period_us = 1000000UL / ADC_SAMPLE_RATE_HZ;
+    telemetry_sample_bits = ADC_RESOLUTION;
+    telemetry_dropped_frames = 0;
+}
+
+void telemetry_set_sample_bits(uint8_t bits) {
+    telemetry_sample_bits = bits;
+}
+
+void telemetry_set_sample_period_us(uint32_t period_us) {
+    telemetry_period_us = period_us;
+}
+
+void telemetry_set_format(telemetry_format_t format) {
+    telemetry_format = format;
+}
+
+telemetry_format_t telemetry_get_format(void) {
+    return telemetry_format;
+}
+
+uint16_t telemetry_crc16(uint16_t crc, const uint8_t *data, uint16_t length) {
+    while (length--) {
+        crc = (uint16_t)((crc << 8) ^ crc16_table[((crc >> 8) ^ *data++) & 0xFF]);
+    }
+    return crc;
+}
+
+uint16_t telemetry_encode_samples(uint8_t *out, uint16_t sequence, uint32_t timestamp_us,
+                                  uint8_t channels, const uint16_t *samples, uint16_t count) {
+    if (out == NULL || samples == NULL || count == 0 || count > TELEMETRY_MAX_SAMPLES) {
+        return 0;
+    }
+
+    bool wide = telemetry_sample_bits > 12;
+    uint16_t payload = wide ? pack16(&out[TELEMETRY_HEADER_SIZE], samples, count, telemetry_sample_bits)
+                            : pack12(&out[TELEMETRY_HEADER_SIZE], samples, count);
+
+    return finish_frame(out, wide ? TELEMETRY_FRAME_SAMPLES16 : TELEMETRY_FRAME_SAMPLES,
+                        channels, sequence, count, timestamp_us, payload);
+}
+
+/**
+ * @brief Encode a frame carrying 32-bit words (status, capture header)
+ * @return Frame length in bytes, 0 on invalid parameters
+ */
+static uint16_t encode_words(uint8_t *out, uint8_t type, uint8_t channels, uint16_t sequence,
+                             uint32_t timestamp_us, const uint32_t *values, uint8_t count) {
+    if (out == NULL || values == NULL || count == 0 || count > TELEMETRY_STATUS_MAX_WORDS) {
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+        put_u32(&out[TELEMETRY_HEADER_SIZE + 4U * i], values[i]);
+    }
+
+    return finish_frame(out, type, channels, sequence, count, timestamp_us,
+                        (uint16_t)TELEMETRY_STATUS_SIZE(count));
+}
+
+/**
+ * @brief Queue an encoded frame, counting it as dropped if it does not fit
+ */
+static bool send_frame(uint16_t length) {
+    if (length == 0) {
+        return false;
+    }
+
+    if (!uart_tx_write(frame_buffer, length)) {
+        telemetry_dropped_frames++;
+        return false;
+    }
+    return true;
+}
+
+uint16_t telemetry_encode_status(uint8_t *out, uint16_t sequence, uint32_t timestamp_us,
+                                 const uint32_t *values, uint8_t count) {
+    return encode_words(out, TELEMETRY_FRAME_STATUS, 0, sequence, timestamp_us, values, count);
+}
+
+bool telemetry_send_samples(const uint16_t *samples, uint16_t count, uint8_t channels,
+                            uint32_t timestamp_us) {
+    bool ok = true;
+
+    if (samples == NULL || channels == 0) {
+        return false;
+    }
+
+    // Never split a scan frame across two telemetry frames
+    uint16_t max_chunk = TELEMETRY_MAX_SAMPLES - (TELEMETRY_MAX_SAMPLES % channels);
+
+    while (count > 0) {
+        uint16_t chunk = (count > max_chunk) ? max_chunk : count;
+        uint16_t length = telemetry_encode_samples(frame_buffer, telemetry_sequence++,
+                                                   timestamp_us, channels, samples, chunk);
+
+        if (!uart_tx_write(frame_buffer, length)) {
+            telemetry_dropped_frames++;
+            ok = false;
+        }
+
+        samples += chunk;
+        count -= chunk;
+        timestamp_us += (uint32_t)(chunk / channels) * telemetry_period_us;
+    }
+
+    return ok;
+}
+
+bool telemetry_send_status(const uint32_t *values, uint8_t count, uint32_t timestamp_us) {
+    return send_frame(telemetry_encode_status(frame_buffer, telemetry_sequence++,
+                                              timestamp_us, values, count));
+}
+
+bool telemetry_send_capture(const uint32_t *values, uint8_t count, uint8_t channels,
+                            uint32_t timestamp_us) {
+    return send_frame(encode_words(frame_buffer, TELEMETRY_FRAME_CAPTURE, channels,
+                                   telemetry_sequence++, timestamp_us, values, count));
+}
+
+uint16_t telemetry_frame_length(const uint8_t *header) {
+    if (header == NULL || header[0] != TELEMETRY_SYNC_0 || header[1] != TELEMETRY_SYNC_1) {
+        return 0;
+    }
+
+    uint16_t count = (uint16_t)(header[6] | (header[7] << 8));
+    switch (header[2]) {
+        case TELEMETRY_FRAME_SAMPLES:
+            return (uint16_t)(TELEMETRY_HEADER_SIZE + TELEMETRY_PACKED_SIZE(count));
+        case TELEMETRY_FRAME_SAMPLES16:
+            return (uint16_t)(TELEMETRY_HEADER_SIZE + TELEMETRY_WIDE_SIZE(count));
+        case TELEMETRY_FRAME_STATUS:
+        case TELEMETRY_FRAME_CAPTURE:
+            return (uint16_t)(TELEMETRY_HEADER_SIZE + TELEMETRY_STATUS_SIZE(count));
+        default:
+            return 0;
+    }
+}
+
+uint32_t telemetry_get_dropped_frames(void) {
+    return telemetry_dropped_frames;
+}
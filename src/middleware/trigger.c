@@ -0,0 +1,422 @@
+#include "middleware/trigger.h"
+#include "middleware/telemetry.h"
+#include "drivers/buffer.h"
+#include "core/uart.h"
+#include "utils/memory.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#if (TRIGGER_PRE_FRAMES * ADC_CHANNELS) > 0xFFFF
+#error "TRIGGER_PRE_FRAMES * ADC_CHANNELS must fit a ring_buffer_t"
+#endif
+
+#if UART_TX_BUFFER_SIZE < TELEMETRY_FRAME_MAX_SIZE
+#error "UART_TX_BUFFER_SIZE must hold a full telemetry frame for trigger_ship()"
+#endif
+
+#if TRIGGER_POST_FRAMES == 0
+#error "TRIGGER_POST_FRAMES must be at least 1"
+#endif
+
+// ASCII lines sent per trigger_ship() call
+#define TRIGGER_SHIP_LINES 8
+
+/* ============================================
+   Static Variables
+   ============================================ */
+// History and capture storage are drawn from the arena by trigger_init()
+static uint16_t *history_storage = NULL;
+static ring_buffer_t history;
+static uint8_t history_channels = 0;
+
+// Frozen window: pre-trigger frames, then post-trigger frames
+static uint16_t *capture = NULL;
+static uint16_t capture_frames = 0;         // Frames stored
+static uint16_t capture_pre = 0;            // Of which ahead of the trigger
+static uint16_t capture_target = 0;         // capture_pre + post_frames
+static uint64_t capture_trigger_us = 0;
+static uint32_t capture_period_us = 0;
+
+static uint16_t ship_frame = 0;             // Next frame to send
+static bool ship_header_sent = false;
+
+static trigger_config_t config;
+static trigger_state_t state = TRIGGER_IDLE;
+static trigger_stats_t stats;
+
+// Edge detector: TRIGGER_EDGE_* may fire once the signal has retreated
+static bool edge_armed = false;
+static bool edge_above = false;             // TRIGGER_EDGE_BOTH side
+static bool edge_valid = false;             // edge_above set from a sample
+static bool force_pending = false;
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static void reset_edge(void) {
+    edge_armed = false;
+    edge_valid = false;
+    force_pending = false;
+}
+
+/**
+ * @brief Append samples, dropping the oldest history to make room
+ */
+static void history_push(const uint16_t *samples, uint16_t count) {
+    ring_buffer_span_t spans[2];
+
+    if (count > history.size) {
+        samples += count - history.size;
+        count = history.size;
+    }
+
+    uint16_t free_space = history.size - ring_buffer_count(&history);
+    if (count > free_space) {
+        ring_buffer_release_read(&history, count - free_space);
+    }
+
+    ring_buffer_claim_write(&history, spans);
+    uint16_t first = (count < spans[0].length) ? count : spans[0].length;
+    memcpy(spans[0].data, samples, first * sizeof(uint16_t));
+    memcpy(spans[1].data, samples + first, (count - first) * sizeof(uint16_t));
+    ring_buffer_commit_write(&history, count);
+}
+
+/**
+ * @brief Copy the newest count samples of history to dst (oldest first)
+ */
+static void history_copy_newest(uint16_t *dst, uint16_t count) {
+    ring_buffer_span_t spans[2];
+    uint16_t total = ring_buffer_peek_read(&history, spans);
+    uint16_t skip = total - count;
+
+    for (uint8_t s = 0; s < 2; s++) {
+        if (skip >= spans[s].length) {
+            skip -= spans[s].length;
+            continue;
+        }
+        uint16_t n = spans[s].length - skip;
+        memcpy(dst, spans[s].data + skip, n * sizeof(uint16_t));
+        dst += n;
+        skip = 0;
+    }
+}
+
+/**
+ * @brief Evaluate one sample against the configured condition
+ */
+static bool evaluate(uint16_t sample) {
+    int32_t level = config.level;
+    int32_t hyst = config.hysteresis;
+
+    switch (config.type) {
+        case TRIGGER_LEVEL_ABOVE:
+            return sample >= level;
+        case TRIGGER_LEVEL_BELOW:
+            return sample <= level;
+        case TRIGGER_EDGE_RISING:
+            if (sample < level - hyst) {
+                edge_armed = true;
+            } else if (edge_armed && sample >= level) {
+                return true;
+            }
+            return false;
+        case TRIGGER_EDGE_FALLING:
+            if (sample > level + hyst) {
+                edge_armed = true;
+            } else if (edge_armed && sample <= level) {
+                return true;
+            }
+            return false;
+        case TRIGGER_EDGE_BOTH:
+            if (!edge_valid) {
+                edge_above = sample >= level;
+                edge_valid = true;
+                return false;
+            }
+            if (edge_above && sample <= level - hyst) {
+                edge_above = false;
+                return true;
+            }
+            if (!edge_above && sample >= level + hyst) {
+                edge_above = true;
+                return true;
+            }
+            return false;
+        case TRIGGER_WINDOW_OUTSIDE:
+            return sample < config.window_low || sample > config.window_high;
+        case TRIGGER_WINDOW_INSIDE:
+            return sample >= config.window_low && sample <= config.window_high;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Append post-trigger frames; freeze the window once full
+ * @return Frames consumed
+ */
+static uint16_t capture_append(const uint16_t *samples, uint16_t frames, uint8_t channels) {
+    uint16_t room = capture_target - capture_frames;
+    uint16_t n = (frames < room) ? frames : room;
+
+    memcpy(&capture[capture_frames * channels], samples, (uint32_t)n * channels * sizeof(uint16_t));
+    capture_frames += n;
+
+    if (capture_frames == capture_target) {
+        ship_frame = 0;
+        ship_header_sent = false;
+        state = TRIGGER_READY;
+    }
+    return n;
+}
+
+/**
+ * @brief Freeze the pre-trigger part of the window from history
+ */
+static void capture_start(uint8_t channels, uint64_t trigger_us, uint32_t period_us) {
+    uint16_t available = ring_buffer_count(&history) / channels;
+    uint16_t pre = (config.pre_frames < available) ? config.pre_frames : available;
+
+    history_copy_newest(capture, pre * channels);
+    capture_frames = pre;
+    capture_pre = pre;
+    capture_target = pre + config.post_frames;
+    capture_trigger_us = trigger_us;
+    capture_period_us = period_us;
+
+    stats.captures++;
+    state = TRIGGER_CAPTURING;
+}
+
+static void capture_done(void) {
+    stats.shipped++;
+    reset_edge();
+    state = config.auto_rearm ? TRIGGER_ARMED : TRIGGER_IDLE;
+}
+
+static uint64_t frame_time_us(uint16_t frame) {
+    return capture_trigger_us - (uint64_t)capture_pre * capture_period_us
+           + (uint64_t)frame * capture_period_us;
+}
+
+static bool ship_binary(void) {
+    uint8_t channels = history_channels;
+
+    if (!ship_header_sent) {
+        uint32_t words[TRIGGER_HEADER_WORDS] = {
+            stats.captures,
+            capture_pre,
+            (uint32_t)(capture_frames - capture_pre),
+            capture_period_us,
+            (uint32_t)(capture_trigger_us >> 32),
+        };
+        if (uart_tx_free() < TELEMETRY_HEADER_SIZE + TELEMETRY_STATUS_SIZE(TRIGGER_HEADER_WORDS)) {
+            return false;
+        }
+        telemetry_send_capture(words, TRIGGER_HEADER_WORDS, channels, (uint32_t)capture_trigger_us);
+        ship_header_sent = true;
+    }
+
+    // One full-size sample frame at a time, only when it fits
+    uint16_t max_frames = TELEMETRY_MAX_SAMPLES / channels;
+    uint16_t frames = capture_frames - ship_frame;
+    if (frames > max_frames) {
+        frames = max_frames;
+    }
+    if (uart_tx_free() < TELEMETRY_FRAME_MAX_SIZE) {
+        return false;
+    }
+
+    telemetry_send_samples(&capture[ship_frame * channels], frames * channels, channels,
+                           (uint32_t)frame_time_us(ship_frame));
+    ship_frame += frames;
+    return true;
+}
+
+static bool ship_ascii(void) {
+    static char line[96];
+    uint8_t channels = history_channels;
+    int len;
+
+    if (!ship_header_sent) {
+        len = snprintf(line, sizeof(line),
+                       "Capture %lu | ch %u | pre %u | post %u | t %lu us\r\n",
+                       (unsigned long)stats.captures, config.channel, capture_pre,
+                       capture_frames - capture_pre, (unsigned long)capture_trigger_us);
+        if (len <= 0 || uart_tx_free() < (uint16_t)len) {
+            return false;
+        }
+        uart_send_string(line);
+        ship_header_sent = true;
+    }
+
+    for (uint8_t n = 0; n < TRIGGER_SHIP_LINES && ship_frame < capture_frames; n++) {
+        const uint16_t *frame = &capture[ship_frame * channels];
+
+        // Frame index relative to the trigger point, then raw counts
+        len = snprintf(line, sizeof(line), "Cap %+d", (int)ship_frame - (int)capture_pre);
+        for (uint8_t ch = 0; ch < channels && len > 0 && len < (int)sizeof(line); ch++) {
+            len += snprintf(&line[len], sizeof(line) - len, " %u", frame[ch]);
+        }
+        if (len <= 0 || len >= (int)sizeof(line) - 2) {
+            return false;
+        }
+        line[len++] = '\r';
+        line[len++] = '\n';
+        line[len] = '\0';
+
+        if (uart_tx_free() < (uint16_t)len) {
+            return n > 0;
+        }
+        uart_send_string(line);
+        ship_frame++;
+    }
+
+    if (ship_frame == capture_frames) {
+        len = snprintf(line, sizeof(line), "Capture %lu end\r\n", (unsigned long)stats.captures);
+        if (len <= 0 || uart_tx_free() < (uint16_t)len) {
+            return false;
+        }
+        uart_send_string(line);
+    }
+    return true;
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void trigger_init(void) {
+    if (capture == NULL) {
+        history_storage = memory_alloc(MEMORY_OWNER_TRIGGER,
+                                       TRIGGER_PRE_FRAMES * ADC_CHANNELS * sizeof(uint16_t));
+        capture = memory_alloc(MEMORY_OWNER_TRIGGER,
+                               (TRIGGER_PRE_FRAMES + TRIGGER_POST_FRAMES) * ADC_CHANNELS * sizeof(uint16_t));
+    }
+    
+    config.type = TRIGGER_EDGE_RISING;
+    config.channel = 0;
+    config.level = TRIGGER_LEVEL;
+    config.hysteresis = TRIGGER_HYSTERESIS;
+    config.window_low = 0;
+    config.window_high = TRIGGER_LEVEL;
+    config.pre_frames = TRIGGER_PRE_FRAMES;
+    config.post_frames = TRIGGER_POST_FRAMES;
+    config.auto_rearm = true;
+
+    memset(&stats, 0, sizeof(stats));
+    history_channels = 0;
+    capture_frames = 0;
+    reset_edge();
+    state = TRIGGER_ARMED;
+}
+
+bool trigger_configure(const trigger_config_t *cfg) {
+    if (cfg == NULL || cfg->type > TRIGGER_WINDOW_INSIDE || cfg->channel >= ADC_CHANNELS ||
+        cfg->pre_frames > TRIGGER_PRE_FRAMES ||
+        cfg->post_frames == 0 || cfg->post_frames > TRIGGER_POST_FRAMES ||
+        cfg->window_low > cfg->window_high) {
+        return false;
+    }
+
+    config = *cfg;
+    reset_edge();
+    state = TRIGGER_ARMED;
+    return true;
+}
+
+void trigger_get_config(trigger_config_t *cfg) {
+    if (cfg == NULL) {
+        return;
+    }
+    *cfg = config;
+}
+
+void trigger_arm(void) {
+    if (state == TRIGGER_IDLE) {
+        reset_edge();
+        state = TRIGGER_ARMED;
+    }
+}
+
+void trigger_disarm(void) {
+    reset_edge();
+    state = TRIGGER_IDLE;
+}
+
+void trigger_force(void) {
+    trigger_arm();
+    force_pending = true;
+}
+
+trigger_state_t trigger_get_state(void) {
+    return state;
+}
+
+bool trigger_process_block(const uint16_t *samples, uint16_t count, uint8_t channels,
+                           uint64_t timestamp_us, uint32_t period_us) {
+    if (samples == NULL || channels == 0 || channels > ADC_CHANNELS ||
+        history_storage == NULL || capture == NULL) {
+        return false;
+    }
+
+    // Keep the history frame-aligned: size it for the current scan length
+    if (channels != history_channels) {
+        ring_buffer_init(&history, history_storage, (uint16_t)(TRIGGER_PRE_FRAMES * channels));
+        history_channels = channels;
+        if (state == TRIGGER_CAPTURING || state == TRIGGER_READY) {
+            reset_edge();
+            state = TRIGGER_ARMED;
+        }
+    }
+
+    uint16_t frames = count / channels;
+    count = frames * channels;
+
+    if (state == TRIGGER_CAPTURING) {
+        capture_append(samples, frames, channels);
+    } else if (state == TRIGGER_ARMED && config.channel < channels) {
+        for (uint16_t f = 0; f < frames; f++) {
+            if (force_pending || evaluate(samples[f * channels + config.channel])) {
+                // History must end just before the trigger frame
+                history_push(samples, f * channels);
+                capture_start(channels, timestamp_us + (uint64_t)f * period_us, period_us);
+                capture_append(&samples[f * channels], frames - f, channels);
+                history_push(&samples[f * channels], (uint16_t)((frames - f) * channels));
+                force_pending = false;
+                return true;
+            }
+        }
+    }
+
+    history_push(samples, count);
+    return false;
+}
+
+bool trigger_ship(void) {
+    if (state != TRIGGER_READY) {
+        return false;
+    }
+
+    bool progressed = (telemetry_get_format() == TELEMETRY_OUTPUT_BINARY) ? ship_binary()
+                                                                          : ship_ascii();
+    if (!progressed) {
+        stats.ship_stalls++;
+    }
+
+    if (ship_frame == capture_frames && ship_header_sent && progressed) {
+        capture_done();
+        return false;
+    }
+    return true;
+}
+
+void trigger_get_stats(trigger_stats_t *out) {
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
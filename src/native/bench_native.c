@@ -0,0 +1,230 @@
+/**
+ * =============================================================================
+ * STM32F4 Data Acquisition System - Host Microbenchmark
+ * =============================================================================
+ *
+ * Built by the native environment from the hardware-free modules plus
+ * the HAL shim in include/native:
+ *
+ *   pio run -e native -t exec                  # default stream length
+ *   .pio/build/native/program 16777216         # samples per benchmark
+ *
+ * Each benchmark pushes the same synthetic 12-bit stream (slow sine plus
+ * LFSR noise) through one module in DMA-block-sized chunks and prints
+ *
+ *   NATIVE,<name>,<samples>,<total_ns>,<ns_per_sample>,<msamples_per_s>,<checksum>
+ *
+ * The checksum folds every output so the work cannot be optimised away,
+ * and lets two builds be checked for identical results.
+ *
+ * =============================================================================
+ */
+
+#include "config.h"
+#include "core/adc_convert.h"
+#include "core/uart.h"
+#include "drivers/buffer.h"
+#include "drivers/spsc_ring.h"
+#include "middleware/filter.h"
+#include "middleware/telemetry.h"
+#include "utils/error.h"
+#include "utils/stats.h"
+#include "native/native_shim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NATIVE_DEFAULT_SAMPLES (1UL << 22)
+#define NATIVE_CHUNK 1024U              // Samples per simulated DMA block
+
+/* ============================================
+   Benchmark State
+   ============================================ */
+static uint16_t *stream;
+static uint32_t stream_length;
+static uint16_t chunk_out[NATIVE_CHUNK];
+static uint16_t ring_storage[NATIVE_CHUNK * 2];
+static fir_decimator_t filter;
+static stats_t stats;
+
+/* ============================================
+   Helpers
+   ============================================ */
+
+static uint64_t native_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t fold(uint32_t checksum, const uint16_t *data, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        checksum = (checksum ^ data[i]) * 16777619U;
+    }
+    return checksum;
+}
+
+static void report(const char *name, uint64_t samples, uint64_t ns, uint32_t checksum) {
+    double ns_per = (double)ns / (double)samples;
+    printf("NATIVE,%s,%llu,%llu,%.3f,%.2f,%08x\n", name,
+           (unsigned long long)samples, (unsigned long long)ns, ns_per,
+           ns_per > 0.0 ? 1000.0 / ns_per : 0.0, checksum);
+}
+
+static void generate_stream(uint32_t length) {
+    // Triangle-shaped slow sweep plus +-31 counts of LFSR noise, 12-bit
+    uint32_t lfsr = 0xACE1U;
+    for (uint32_t i = 0; i < length; i++) {
+        lfsr = (lfsr >> 1) ^ (-(lfsr & 1U) & 0xB400U);
+        int32_t phase = (int32_t)(i & 0x3FFFU);
+        int32_t sweep = (phase < 0x2000) ? phase : (0x3FFF - phase);
+        int32_t value = 96 + (sweep >> 1) + (int32_t)(lfsr & 0x3FU) - 31;
+        stream[i] = (uint16_t)(value & ADC_MAX_VALUE);
+    }
+}
+
+/* ============================================
+   Benchmarks
+   ============================================ */
+
+static void bench_ring_buffer(void) {
+    ring_buffer_t rb;
+    uint32_t checksum = 2166136261U;
+    ring_buffer_init(&rb, ring_storage, NATIVE_CHUNK);
+
+    uint64_t start = native_now_ns();
+    for (uint32_t off = 0; off + NATIVE_CHUNK <= stream_length; off += NATIVE_CHUNK) {
+        for (uint32_t i = 0; i < NATIVE_CHUNK; i++) {
+            ring_buffer_write(&rb, stream[off + i]);
+        }
+        for (uint32_t i = 0; i < NATIVE_CHUNK; i++) {
+            ring_buffer_read(&rb, &chunk_out[i]);
+        }
+        checksum = fold(checksum, chunk_out, NATIVE_CHUNK);
+    }
+    report("ring_buffer_write_read", stream_length, native_now_ns() - start, checksum);
+}
+
+static void bench_spsc_ring(void) {
+    spsc_ring_t rb;
+    uint32_t checksum = 2166136261U;
+    spsc_ring_init(&rb, ring_storage, NATIVE_CHUNK * 2);
+
+    uint64_t start = native_now_ns();
+    for (uint32_t off = 0; off + NATIVE_CHUNK <= stream_length; off += NATIVE_CHUNK) {
+        spsc_ring_write_n(&rb, &stream[off], NATIVE_CHUNK);
+        spsc_ring_read_n(&rb, chunk_out, NATIVE_CHUNK);
+        checksum = fold(checksum, chunk_out, NATIVE_CHUNK);
+    }
+    report("spsc_ring_write_read_n", stream_length, native_now_ns() - start, checksum);
+}
+
+static void bench_conversion(void) {
+    uint32_t checksum = 2166136261U;
+
+    uint64_t start = native_now_ns();
+    for (uint32_t off = 0; off + NATIVE_CHUNK <= stream_length; off += NATIVE_CHUNK) {
+        adc_convert_block_mv(&stream[off], chunk_out, NATIVE_CHUNK, ADC_RESOLUTION);
+        checksum = fold(checksum, chunk_out, NATIVE_CHUNK);
+    }
+    report("adc_convert_block_mv", stream_length, native_now_ns() - start, checksum);
+
+    // Reference: the multiply/divide the table replaced
+    checksum = 2166136261U;
+    start = native_now_ns();
+    for (uint32_t off = 0; off + NATIVE_CHUNK <= stream_length; off += NATIVE_CHUNK) {
+        for (uint32_t i = 0; i < NATIVE_CHUNK; i++) {
+            chunk_out[i] = (uint16_t)(((uint32_t)stream[off + i] * ADC_REFERENCE_MV) / ADC_MAX_VALUE);
+        }
+        checksum = fold(checksum, chunk_out, NATIVE_CHUNK);
+    }
+    report("mv_multiply_divide", stream_length, native_now_ns() - start, checksum);
+}
+
+static void bench_filter(void) {
+    uint32_t checksum = 2166136261U;
+    uint64_t outputs = 0;
+    fir_decimator_init(&filter, filter_lowpass_d4, FILTER_LOWPASS_D4_TAPS, FILTER_DECIMATION);
+
+    uint64_t start = native_now_ns();
+    for (uint32_t off = 0; off + NATIVE_CHUNK <= stream_length; off += NATIVE_CHUNK) {
+        uint16_t n = fir_decimator_process(&filter, &stream[off], NATIVE_CHUNK, 1, chunk_out, 1);
+        checksum = fold(checksum, chunk_out, n);
+        outputs += n;
+    }
+    report("fir_decimator_32tap_d4", stream_length, native_now_ns() - start, checksum ^ (uint32_t)outputs);
+}
+
+static void bench_statistics(void) {
+    stats_summary_t summary;
+    stats_init(&stats);
+
+    uint64_t start = native_now_ns();
+    for (uint32_t off = 0; off + NATIVE_CHUNK <= stream_length; off += NATIVE_CHUNK) {
+        stats_update_block(&stats, &stream[off], NATIVE_CHUNK, 1);
+    }
+    uint64_t ns = native_now_ns() - start;
+
+    stats_get_summary(&stats, &summary);
+    report("stats_update", stream_length, ns, summary.mean_q8 ^ summary.variance_q8);
+}
+
+static void bench_telemetry(void) {
+    telemetry_init();
+    telemetry_set_format(TELEMETRY_OUTPUT_BINARY);
+    uart_init();
+
+    uint64_t start = native_now_ns();
+    for (uint32_t off = 0; off + NATIVE_CHUNK <= stream_length; off += NATIVE_CHUNK) {
+        telemetry_send_samples(&stream[off], NATIVE_CHUNK, 1, off * 10U);
+    }
+    uint64_t ns = native_now_ns() - start;
+
+    report("telemetry_send_samples", stream_length, ns, native_uart_get_checksum());
+    printf("NATIVE_INFO,telemetry_bytes,%llu\n", (unsigned long long)native_uart_get_bytes());
+}
+
+static void bench_error(void) {
+    const uint32_t calls = stream_length / 16U;
+    error_init();
+
+    uint64_t start = native_now_ns();
+    for (uint32_t i = 0; i < calls; i++) {
+        error_report((error_code_t)(1U << (i & 7U)), (uint8_t)(i & 1U), "native");
+    }
+    report("error_report", calls, native_now_ns() - start, (uint32_t)error_get_last().code);
+}
+
+/**
+ * @brief Host benchmark entry point
+ * @param argc Argument count
+ * @param argv argv[1] = samples per benchmark (optional)
+ */
+int main(int argc, char **argv) {
+    stream_length = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : NATIVE_DEFAULT_SAMPLES;
+    stream_length -= stream_length % NATIVE_CHUNK;
+    if (stream_length == 0) {
+        fprintf(stderr, "sample count must be at least %u\n", NATIVE_CHUNK);
+        return 1;
+    }
+
+    stream = malloc((size_t)stream_length * sizeof(uint16_t));
+    if (stream == NULL) {
+        fprintf(stderr, "cannot allocate %lu samples\n", (unsigned long)stream_length);
+        return 1;
+    }
+    generate_stream(stream_length);
+
+    printf("NATIVE_BEGIN,1,%lu\n", (unsigned long)stream_length);
+    bench_ring_buffer();
+    bench_spsc_ring();
+    bench_conversion();
+    bench_filter();
+    bench_statistics();
+    bench_telemetry();
+    bench_error();
+    printf("NATIVE_END\n");
+
+    free(stream);
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "core/timebase.h"
+#include "native/native_shim.h"
+#include <time.h>
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static uint64_t epoch_us = 0;
+static uint64_t offset_us = 0;              // native_timebase_advance_us()
+
+/* ============================================
+   core/timebase.h on the Host
+   ============================================ */
+
+static uint64_t monotonic_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000U;
+}
+
+void timebase_init(void) {
+    epoch_us = monotonic_us();
+    offset_us = 0;
+}
+
+uint64_t timebase_now_us(void) {
+    return monotonic_us() - epoch_us + offset_us;
+}
+
+uint64_t timebase_now_ms(void) {
+    return timebase_now_us() / 1000U;
+}
+
+uint64_t timebase_extend_us(uint32_t stamp_us) {
+    uint64_t now = timebase_now_us();
+    uint32_t age = (uint32_t)now - stamp_us;
+    return now - age;
+}
+
+void native_timebase_advance_us(uint64_t us) {
+    offset_us += us;
+}
@@ -0,0 +1,89 @@
+#include "core/uart.h"
+#include "native/native_shim.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ============================================
+   Static Variables
+   ============================================ */
+uint32_t SystemCoreClock = 0;
+
+static uint64_t uart_bytes = 0;
+static uint32_t uart_checksum = 2166136261U;
+
+/* ============================================
+   core/uart.h on the Host
+   ============================================ */
+
+void uart_init(void) {
+    uart_bytes = 0;
+    uart_checksum = 2166136261U;
+}
+
+bool uart_tx_write(const uint8_t *data, uint16_t length) {
+    if (data == NULL) {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < length; i++) {
+        uart_checksum = (uart_checksum ^ data[i]) * 16777619U;
+    }
+    uart_bytes += length;
+    return true;
+}
+
+bool uart_send_string(const char *str) {
+    if (str == NULL) {
+        return false;
+    }
+    return uart_tx_write((const uint8_t *)str, (uint16_t)strlen(str));
+}
+
+uint16_t uart_tx_free(void) {
+    return UART_TX_BUFFER_SIZE;
+}
+
+uint16_t uart_tx_pending(void) {
+    return 0;
+}
+
+bool uart_tx_is_idle(void) {
+    return true;
+}
+
+void uart_tx_flush(void) {
+}
+
+uint32_t uart_tx_get_dropped(void) {
+    return 0;
+}
+
+uint16_t uart_tx_get_high_water(void) {
+    return 0;
+}
+
+void uart_set_tx_idle_callback(void (*callback)(void)) {
+    (void)callback;
+}
+
+void uart_send_char_blocking(char c) {
+    fputc(c, stdout);
+}
+
+void uart_send_string_blocking(const char *str) {
+    if (str != NULL) {
+        fputs(str, stdout);
+    }
+}
+
+/* ============================================
+   Shim Accessors
+   ============================================ */
+
+uint64_t native_uart_get_bytes(void) {
+    return uart_bytes;
+}
+
+uint32_t native_uart_get_checksum(void) {
+    return uart_checksum;
+}
@@ -1,61 +1,244 @@
 #include "utils/error.h"
+#include "core/timebase.h"
+#include "stm32f4xx.h"
 #include <string.h>
 
+#ifdef NATIVE_BUILD
+#include "native/native_shim.h"
+#endif
+
+#if (ERROR_LOG_SIZE & (ERROR_LOG_SIZE - 1)) != 0
+#error "ERROR_LOG_SIZE must be a power of two"
+#endif
+
 /* ============================================
    Static Variables
    ============================================ */
-#define MAX_ERROR_HISTORY 10
+#define ERROR_LOG_MASK (ERROR_LOG_SIZE - 1U)
+
+// Counter slots: ERROR_NONE, the seven single-bit codes 0x01-0x40, the
+// extended codes 0x80-0x8F, then one shared by everything else
+#define ERROR_BIT_CODES 7U
+#define ERROR_EXTENDED_CODES 16U
+#define ERROR_CODE_SLOTS (1U + ERROR_BIT_CODES + ERROR_EXTENDED_CODES + 1U)
+
+_Static_assert(ERROR_NO_MEMORY < ERROR_TIMEOUT + ERROR_EXTENDED_CODES,
+               "extended error codes outgrew their counter slots");
+
+// Rate-limit clock: timebase us >> 10 (~1.024 ms), wraps after ~51 days
+#define RATE_TICK_SHIFT 10U
+#define RATE_LIMIT_TICKS (((uint32_t)ERROR_RATE_LIMIT_MS * 1000U) >> RATE_TICK_SHIFT)
+
+typedef struct {
+    volatile uint32_t stamp;            // sequence + 1 once complete, 0 while written
+    error_t entry;
+} error_slot_t;
+
+static error_slot_t error_log[ERROR_LOG_SIZE];
+static volatile uint32_t log_sequence = 0;      // Next sequence to reserve
+static volatile uint32_t total_count = 0;
+static volatile uint32_t code_counts[ERROR_CODE_SLOTS];
+static volatile uint32_t code_suppressed[ERROR_CODE_SLOTS];
+static volatile uint32_t code_last_tick[ERROR_CODE_SLOTS];  // Rate tick + 1 of the last logged event, 0 = never
+static volatile bool critical_error_flag = false;
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static uint8_t code_slot(error_code_t code) {
+    uint32_t value = (uint32_t)code;
+
+    if (value == 0) {
+        return 0;
+    }
+    if (value < ERROR_TIMEOUT && (value & (value - 1U)) == 0) {
+        return (uint8_t)(1U + __builtin_ctz(value));
+    }
+    if (value >= ERROR_TIMEOUT && value < ERROR_TIMEOUT + ERROR_EXTENDED_CODES) {
+        return (uint8_t)(1U + ERROR_BIT_CODES + (value - ERROR_TIMEOUT));
+    }
+    return ERROR_CODE_SLOTS - 1U;
+}
+
+static error_code_t slot_code(uint8_t slot) {
+    if (slot == 0) {
+        return ERROR_NONE;
+    }
+    if (slot <= ERROR_BIT_CODES) {
+        return (error_code_t)(1U << (slot - 1U));
+    }
+    if (slot < ERROR_CODE_SLOTS - 1U) {
+        return (error_code_t)(ERROR_TIMEOUT + (slot - 1U - ERROR_BIT_CODES));
+    }
+    return ERROR_UNKNOWN;
+}
+
+/**
+ * @brief Saturating atomic increment
+ * @return Value after the increment
+ */
+static uint32_t atomic_increment(volatile uint32_t *counter) {
+    uint32_t value;
+
+    do {
+        value = __LDREXW(counter);
+        if (value == UINT32_MAX) {
+            __CLREX();
+            return value;
+        }
+    } while (__STREXW(value + 1U, counter) != 0U);
+
+    return value + 1U;
+}
+
+/**
+ * @brief Reserve the next log sequence (wraps, never saturates)
+ */
+static uint32_t reserve_sequence(void) {
+    uint32_t value;
+
+    do {
+        value = __LDREXW(&log_sequence);
+    } while (__STREXW(value + 1U, &log_sequence) != 0U);
+
+    return value;
+}
+
+/**
+ * @brief Take the code's log slot for this rate-limit window
+ * @return false if an event of the code was logged less than
+ *         ERROR_RATE_LIMIT_MS ago (or a concurrent report just took it)
+ */
+static bool claim_window(volatile uint32_t *last_tick, uint32_t tick) {
+    uint32_t last;
+
+    do {
+        last = __LDREXW(last_tick);
+        if (last != 0 && (tick - (last - 1U)) < RATE_LIMIT_TICKS) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(tick + 1U, last_tick) != 0U);
 
-static error_t error_history[MAX_ERROR_HISTORY] = {0};
-static uint16_t error_count = 0;
-static uint16_t error_index = 0;
-static bool critical_error_flag = false;
+    return true;
+}
+
+static void clear_state(void) {
+    total_count = 0;
+    critical_error_flag = false;
+    for (uint8_t i = 0; i < ERROR_CODE_SLOTS; i++) {
+        code_counts[i] = 0;
+        code_suppressed[i] = 0;
+        code_last_tick[i] = 0;
+    }
+    for (uint32_t i = 0; i < ERROR_LOG_SIZE; i++) {
+        error_log[i].stamp = 0;
+    }
+}
 
 /* ============================================
    Public Functions
    ============================================ */
 
 void error_init(void) {
-    error_count = 0;
-    error_index = 0;
-    critical_error_flag = false;
-    memset(error_history, 0, sizeof(error_history));
+    log_sequence = 0;
+    clear_state();
+    memset(error_log, 0, sizeof(error_log));
 }
 
 void error_report(error_code_t code, uint8_t severity, const char *message) {
-    error_t *err = &error_history[error_index];
-
-    err->code = code;
-    err->severity = severity;
-    err->message = message;
-    // err->timestamp_ms = get_system_time_ms(); // TODO: Implement
+    uint8_t slot = code_slot(code);
+    uint64_t now_us = timebase_now_us();
+    uint32_t count = atomic_increment(&code_counts[slot]);
 
-    error_count++;
+    atomic_increment(&total_count);
     if (severity >= 3) {  // Critical
         critical_error_flag = true;
     }
 
-    error_index = (error_index + 1) % MAX_ERROR_HISTORY;
+    if (severity < 3 && !claim_window(&code_last_tick[slot], (uint32_t)(now_us >> RATE_TICK_SHIFT))) {
+        atomic_increment(&code_suppressed[slot]);
+        return;
+    }
+
+    // A writer pre-empted here for ERROR_LOG_SIZE nested reports could
+    // share its slot with the last of them; the stamp still tells
+    // readers which sequence the slot holds
+    uint32_t sequence = reserve_sequence();
+    error_slot_t *entry = &error_log[sequence & ERROR_LOG_MASK];
+
+    entry->stamp = 0;
+    __DMB();
+    entry->entry.code = code;
+    entry->entry.severity = severity;
+    entry->entry.sequence = sequence;
+    entry->entry.count = count;
+    entry->entry.timestamp_us = now_us;
+    entry->entry.message = message;
+    __DMB();
+    entry->stamp = sequence + 1U;
+}
+
+bool error_read(uint32_t sequence, error_t *out) {
+    const error_slot_t *entry = &error_log[sequence & ERROR_LOG_MASK];
+
+    if (out == NULL) {
+        return false;
+    }
+
+    uint32_t stamp = entry->stamp;
+    __DMB();
+    *out = entry->entry;
+    __DMB();
+
+    return stamp == sequence + 1U && entry->stamp == stamp;
+}
+
+uint32_t error_get_sequence(void) {
+    return log_sequence;
 }
 
 error_t error_get_last(void) {
-    uint16_t last_index = (error_index > 0) ? (error_index - 1) : (MAX_ERROR_HISTORY - 1);
-    return error_history[last_index];
+    error_t last = {0};
+    uint32_t next = log_sequence;
+
+    // Step back over a slot that is still being written
+    for (uint32_t back = 1; back <= ERROR_LOG_SIZE && back <= next; back++) {
+        if (error_read(next - back, &last)) {
+            return last;
+        }
+    }
+
+    memset(&last, 0, sizeof(last));
+    return last;
 }
 
 void error_clear(void) {
-    error_count = 0;
-    error_index = 0;
-    critical_error_flag = false;
-    memset(error_history, 0, sizeof(error_history));
+    clear_state();
 }
 
 bool error_is_critical(void) {
     return critical_error_flag;
 }
 
-uint16_t error_get_count(void) {
-    return error_count;
+uint32_t error_get_count(void) {
+    return total_count;
+}
+
+uint32_t error_get_code_count(error_code_t code) {
+    return code_counts[code_slot(code)];
+}
+
+bool error_get_code_stats(uint8_t index, error_code_stats_t *stats) {
+    if (index >= ERROR_CODE_SLOTS || stats == NULL) {
+        return false;
+    }
+
+    stats->code = slot_code(index);
+    stats->count = code_counts[index];
+    stats->suppressed = code_suppressed[index];
+    return true;
 }
 
 const char* error_get_string(error_code_t code) {
@@ -78,7 +261,29 @@ const char* error_get_string(error_code_t code) {
             return "Invalid parameter";
         case ERROR_TIMEOUT:
             return "Operation timeout";
+        case ERROR_ADC_OVERRUN:
+            return "ADC overrun";
+        case ERROR_SAMPLES_DROPPED:
+            return "Samples dropped";
+        case ERROR_TX_DROPPED:
+            return "UART TX dropped";
+        case ERROR_FLASH_FAILED:
+            return "Flash operation failed";
+        case ERROR_USB_FAILED:
+            return "USB init failed";
+        case ERROR_STALL:
+            return "Pipeline stall";
+        case ERROR_FAULT:
+            return "Fault reset";
+        case ERROR_NO_MEMORY:
+            return "Arena exhausted";
         default:
             return "Unknown error";
     }
 }
+
+#ifdef NATIVE_BUILD
+void native_error_set_code_count(error_code_t code, uint32_t count) {
+    code_counts[code_slot(code)] = count;
+}
+#endif
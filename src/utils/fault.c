@@ -0,0 +1,225 @@
+#include "utils/fault.h"
+#include "utils/error.h"
+#include "core/timebase.h"
+#include "middleware/scheduler.h"
+#include <stddef.h>
+#include <string.h>
+
+#define FAULT_STACK_BYTES 512
+#define FAULT_FRAME_BYTES 32                // r0-r3, r12, lr, pc, xPSR
+
+#define FAULT_STR(x) #x
+#define FAULT_XSTR(x) FAULT_STR(x)
+
+extern uint32_t _estack;                    // Top of SRAM (linker script)
+
+/* ============================================
+   Static Variables
+   ============================================ */
+
+// Not zeroed by the startup code; validated in fault_init()
+static fault_record_t record __attribute__((section(".noinit")));
+
+// Handler stack: the faulting stack may have overflowed
+__attribute__((used, aligned(8))) static uint32_t fault_stack[FAULT_STACK_BYTES / 4];
+
+typedef struct {
+    uint32_t mask;
+    const char *name;
+} fault_bit_t;
+
+static const fault_bit_t cfsr_bits[] = {
+    {SCB_CFSR_IACCVIOL_Msk, "IACCVIOL"},
+    {SCB_CFSR_DACCVIOL_Msk, "DACCVIOL"},
+    {SCB_CFSR_MUNSTKERR_Msk, "MUNSTKERR"},
+    {SCB_CFSR_MSTKERR_Msk, "MSTKERR"},
+    {SCB_CFSR_MLSPERR_Msk, "MLSPERR"},
+    {SCB_CFSR_MMARVALID_Msk, "MMARVALID"},
+    {SCB_CFSR_IBUSERR_Msk, "IBUSERR"},
+    {SCB_CFSR_PRECISERR_Msk, "PRECISERR"},
+    {SCB_CFSR_IMPRECISERR_Msk, "IMPRECISERR"},
+    {SCB_CFSR_UNSTKERR_Msk, "UNSTKERR"},
+    {SCB_CFSR_STKERR_Msk, "STKERR"},
+    {SCB_CFSR_LSPERR_Msk, "LSPERR"},
+    {SCB_CFSR_BFARVALID_Msk, "BFARVALID"},
+    {SCB_CFSR_UNDEFINSTR_Msk, "UNDEFINSTR"},
+    {SCB_CFSR_INVSTATE_Msk, "INVSTATE"},
+    {SCB_CFSR_INVPC_Msk, "INVPC"},
+    {SCB_CFSR_NOCP_Msk, "NOCP"},
+    {SCB_CFSR_UNALIGNED_Msk, "UNALIGNED"},
+    {SCB_CFSR_DIVBYZERO_Msk, "DIVBYZERO"},
+};
+
+static const fault_bit_t hfsr_bits[] = {
+    {SCB_HFSR_VECTTBL_Msk, "VECTTBL"},
+    {SCB_HFSR_FORCED_Msk, "FORCED"},
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static uint32_t record_checksum(void) {
+    const uint32_t *words = (const uint32_t *)&record;
+    uint32_t sum = 0;
+
+    for (size_t i = 0; i < offsetof(fault_record_t, checksum) / sizeof(uint32_t); i++) {
+        sum = (sum << 1 | sum >> 31) ^ words[i];
+    }
+    return ~sum;
+}
+
+static bool record_valid(void) {
+    return record.magic == FAULT_RECORD_MAGIC && record.checksum == record_checksum();
+}
+
+static bool frame_readable(uint32_t sp) {
+    return (sp & 3U) == 0 && sp >= SRAM1_BASE && sp + FAULT_FRAME_BYTES <= (uint32_t)&_estack;
+}
+
+static uint16_t describe_bits(const fault_bit_t *bits, size_t count, uint32_t value,
+                              char *buffer, uint16_t size, uint16_t len) {
+    for (size_t i = 0; i < count; i++) {
+        if (!(value & bits[i].mask)) {
+            continue;
+        }
+
+        size_t n = strlen(bits[i].name);
+        if (len + n + 2U > size) {
+            break;
+        }
+        if (len > 0) {
+            buffer[len++] = ' ';
+        }
+        memcpy(&buffer[len], bits[i].name, n);
+        len += (uint16_t)n;
+        buffer[len] = '\0';
+    }
+    return len;
+}
+
+/**
+ * @brief Fill the record and reset (entered from the handler stub)
+ * @param frame Stack pointer at exception entry (stacked r0)
+ * @param exc_return Handler LR
+ */
+__attribute__((used, noreturn)) void fault_capture(const uint32_t *frame, uint32_t exc_return) {
+    uint32_t faults = record_valid() ? record.faults + 1U : 1U;
+    uint32_t sp = (uint32_t)frame;
+
+    memset(&record, 0, sizeof(record));
+    record.magic = FAULT_RECORD_MAGIC;
+    record.faults = faults;
+    record.pending = 1;
+    record.exception = __get_IPSR() & 0x1FFU;
+    record.exc_return = exc_return;
+
+    if (frame_readable(sp)) {
+        record.frame_valid = 1;
+        record.r0 = frame[0];
+        record.r1 = frame[1];
+        record.r2 = frame[2];
+        record.r3 = frame[3];
+        record.r12 = frame[4];
+        record.lr = frame[5];
+        record.pc = frame[6];
+        record.xpsr = frame[7];
+
+        // Undo the stacking: extended (FPU) frame, 8-byte alignment pad
+        sp += (exc_return & 0x10U) ? FAULT_FRAME_BYTES : 0x68U;
+        if (record.xpsr & (1UL << 9)) {
+            sp += 4U;
+        }
+    }
+    record.sp = sp;
+
+    record.cfsr = SCB->CFSR;
+    record.hfsr = SCB->HFSR;
+    record.mmfar = SCB->MMFAR;
+    record.bfar = SCB->BFAR;
+    record.uptime_ms = (uint32_t)timebase_now_ms();
+    record.cycles = DWT->CYCCNT;
+    record.task = scheduler_get_running_task();
+    record.last_error = (uint32_t)error_get_last().code;
+    record.error_count = error_get_count();
+    record.checksum = record_checksum();
+    __DSB();
+
+    if (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk) {
+        __BKPT(0);
+    }
+    NVIC_SystemReset();
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void fault_init(void) {
+    if (!record_valid()) {
+        memset(&record, 0, sizeof(record));
+        record.magic = FAULT_RECORD_MAGIC;
+        record.checksum = record_checksum();
+    }
+
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk | SCB_SHCSR_BUSFAULTENA_Msk | SCB_SHCSR_USGFAULTENA_Msk;
+}
+
+const fault_record_t *fault_get_pending(void) {
+    return (record_valid() && record.pending) ? &record : NULL;
+}
+
+void fault_clear_pending(void) {
+    record.pending = 0;
+    record.checksum = record_checksum();
+}
+
+const char *fault_get_name(uint32_t exception) {
+    switch (exception) {
+        case 3:
+            return "hard";
+        case 4:
+            return "memmanage";
+        case 5:
+            return "bus";
+        case 6:
+            return "usage";
+        default:
+            return "?";
+    }
+}
+
+void fault_describe(const fault_record_t *fault, char *buffer, uint16_t size) {
+    if (fault == NULL || buffer == NULL || size == 0) {
+        return;
+    }
+
+    buffer[0] = '\0';
+    uint16_t len = describe_bits(cfsr_bits, sizeof(cfsr_bits) / sizeof(cfsr_bits[0]),
+                                 fault->cfsr, buffer, size, 0);
+    describe_bits(hfsr_bits, sizeof(hfsr_bits) / sizeof(hfsr_bits[0]), fault->hfsr, buffer, size, len);
+}
+
+/* ============================================
+   Exception Handlers
+   ============================================ */
+
+/**
+ * @brief Shared fault entry: pick the active stack, switch stacks, capture
+ */
+__attribute__((naked)) void HardFault_Handler(void) {
+    __asm volatile(
+        "tst lr, #4\n"
+        "ite eq\n"
+        "mrseq r0, msp\n"
+        "mrsne r0, psp\n"
+        "mov r1, lr\n"
+        "ldr r2, =fault_stack + " FAULT_XSTR(FAULT_STACK_BYTES) "\n"
+        "mov sp, r2\n"
+        "b fault_capture\n"
+    );
+}
+
+void MemManage_Handler(void) __attribute__((alias("HardFault_Handler")));
+void BusFault_Handler(void) __attribute__((alias("HardFault_Handler")));
+void UsageFault_Handler(void) __attribute__((alias("HardFault_Handler")));
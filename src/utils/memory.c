@@ -0,0 +1,102 @@
+#include "utils/memory.h"
+#include "utils/error.h"
+#include <stddef.h>
+#include <string.h>
+
+#if (MEMORY_ALIGN & (MEMORY_ALIGN - 1)) != 0 || MEMORY_ALIGN < 4
+#error "MEMORY_ALIGN must be a power of two, at least 4"
+#endif
+
+// Keep this below the deepest frame of memory_paint_stack() itself
+#define MEMORY_STACK_GUARD  64U
+
+// Linker script symbols
+extern uint32_t _sdata;                     // Start of .data (first static RAM byte)
+extern uint32_t _enoinit;                   // End of .noinit (last static section)
+extern uint32_t _end;                       // Heap start; the stack grows down to here
+extern uint32_t _estack;                    // Top of SRAM
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static uint8_t arena[MEMORY_ARENA_SIZE] __attribute__((aligned(MEMORY_ALIGN)));
+static uint32_t arena_used = 0;
+static uint32_t owner_bytes[MEMORY_OWNER_COUNT];
+static uint32_t failures = 0;
+static bool sealed = false;
+
+static const char *const owner_names[MEMORY_OWNER_COUNT] = {
+    [MEMORY_OWNER_ADC] = "adc",
+    [MEMORY_OWNER_PIPELINE] = "pipeline",
+    [MEMORY_OWNER_UART] = "uart",
+    [MEMORY_OWNER_LOGGER] = "logger",
+    [MEMORY_OWNER_TRIGGER] = "trigger",
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static uint32_t *stack_floor(void) {
+    return (uint32_t *)(((uint32_t)&_end + 3U) & ~3U);
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void memory_paint_stack(void) {
+    // Volatile: a memset() call would run on the stack being painted
+    volatile uint32_t *word = stack_floor();
+    volatile uint32_t *top = (volatile uint32_t *)((__get_MSP() - MEMORY_STACK_GUARD) & ~3U);
+
+    while (word < top) {
+        *word++ = MEMORY_STACK_PAINT;
+    }
+}
+
+void *memory_alloc(memory_owner_t owner, uint32_t size) {
+    uint32_t rounded = MEMORY_ROUND(size);
+
+    if (owner >= MEMORY_OWNER_COUNT || sealed || rounded > MEMORY_ARENA_SIZE - arena_used) {
+        failures++;
+        error_report(ERROR_NO_MEMORY, 3, (owner < MEMORY_OWNER_COUNT) ? owner_names[owner] : "?");
+        return NULL;
+    }
+
+    void *buffer = &arena[arena_used];
+    arena_used += rounded;
+    owner_bytes[owner] += rounded;
+    memset(buffer, 0, rounded);
+    return buffer;
+}
+
+void memory_seal(void) {
+    sealed = true;
+}
+
+void memory_get_report(memory_report_t *report) {
+    if (report == NULL) {
+        return;
+    }
+
+    report->ram_size = (uint32_t)&_estack - SRAM1_BASE;
+    report->static_bytes = (uint32_t)&_enoinit - (uint32_t)&_sdata;
+    report->arena_size = MEMORY_ARENA_SIZE;
+    report->arena_used = arena_used;
+    memcpy(report->owner_bytes, owner_bytes, sizeof(owner_bytes));
+    report->failures = failures;
+
+    // Painted words are only ever overwritten, so scan up from the floor
+    const volatile uint32_t *word = stack_floor();
+    const uint32_t *top = &_estack;
+    while (word < top && *word == MEMORY_STACK_PAINT) {
+        word++;
+    }
+    report->stack_size = (uint32_t)top - (uint32_t)stack_floor();
+    report->stack_peak = (uint32_t)top - (uint32_t)word;
+}
+
+const char *memory_owner_name(memory_owner_t owner) {
+    return (owner < MEMORY_OWNER_COUNT) ? owner_names[owner] : "?";
+}
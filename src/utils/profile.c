@@ -0,0 +1,106 @@
+#include "utils/profile.h"
+#include <stddef.h>
+#include <string.h>
+
+/* ============================================
+   Static Variables
+   ============================================ */
+static profile_stats_t probes[PROFILE_PROBE_COUNT];
+static uint32_t profile_overhead = 0;
+
+static const char *const probe_names[PROFILE_PROBE_COUNT] = {
+    [PROFILE_PROBE_ADC_BLOCK] = "adc_block",
+    [PROFILE_PROBE_ADC_SAMPLE] = "adc_sample",
+    [PROFILE_PROBE_TELEMETRY_SEND] = "telemetry_send",
+    [PROFILE_PROBE_UART_SEND] = "uart_send",
+    [PROFILE_PROBE_ADC_DMA_ISR] = "adc_dma_isr",
+    [PROFILE_PROBE_UART_DMA_ISR] = "uart_dma_isr",
+};
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static uint8_t profile_bin(uint32_t cycles) {
+    // floor(log2(cycles)) via CLZ; 0 and 1 cycle share bin 0
+    uint8_t bin = (cycles > 1) ? (uint8_t)(31 - __builtin_clz(cycles)) : 0;
+    return (bin < PROFILE_HISTOGRAM_BINS) ? bin : (PROFILE_HISTOGRAM_BINS - 1);
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void profile_init(void) {
+    // Trace enable gates the DWT; then start CYCCNT from zero
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    profile_reset();
+
+    // Cost of two back-to-back reads (the bare BEGIN/END pair)
+    uint32_t best = UINT32_MAX;
+    for (uint8_t i = 0; i < 8; i++) {
+        uint32_t start = profile_now();
+        uint32_t cycles = profile_now() - start;
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    profile_overhead = best;
+}
+
+void profile_record(profile_probe_t probe, uint32_t cycles) {
+    if ((uint32_t)probe >= PROFILE_PROBE_COUNT) {
+        return;
+    }
+
+    profile_stats_t *p = &probes[probe];
+    cycles = (cycles > profile_overhead) ? (cycles - profile_overhead) : 0;
+
+    if (cycles < p->min) {
+        p->min = cycles;
+    }
+    if (cycles > p->max) {
+        p->max = cycles;
+    }
+    p->total += cycles;
+    p->histogram[profile_bin(cycles)]++;
+    p->count++;
+}
+
+bool profile_get(profile_probe_t probe, profile_stats_t *out) {
+    if ((uint32_t)probe >= PROFILE_PROBE_COUNT || out == NULL) {
+        return false;
+    }
+
+    // ISR probes may be mid-update; copy with interrupts masked
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *out = probes[probe];
+    __set_PRIMASK(primask);
+
+    return true;
+}
+
+const char *profile_get_name(profile_probe_t probe) {
+    if ((uint32_t)probe >= PROFILE_PROBE_COUNT) {
+        return "unknown";
+    }
+    return probe_names[probe];
+}
+
+uint32_t profile_get_overhead(void) {
+    return profile_overhead;
+}
+
+void profile_reset(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(probes, 0, sizeof(probes));
+    for (uint8_t i = 0; i < PROFILE_PROBE_COUNT; i++) {
+        probes[i].min = UINT32_MAX;
+    }
+    __set_PRIMASK(primask);
+}
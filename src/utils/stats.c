@@ -0,0 +1,190 @@
+#include "utils/stats.h"
+#include <stddef.h>
+#include <string.h>
+
+#if (STATS_WINDOW_SIZE & (STATS_WINDOW_SIZE - 1)) != 0
+#error "STATS_WINDOW_SIZE must be a power of two"
+#endif
+
+/* ============================================
+   Private Functions
+   ============================================ */
+
+static uint32_t isqrt64(uint64_t x) {
+    // Bitwise integer square root, floor(sqrt(x))
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+
+    while (bit != 0) {
+        if (x >= result + bit) {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (uint32_t)result;
+}
+
+static void stats_window_push(stats_t *s, uint16_t x) {
+    uint32_t pos = s->window_pos;
+    uint32_t slot = pos & STATS_WINDOW_MASK;
+
+    // Replace the oldest sample once the window is full
+    if (pos >= STATS_WINDOW_SIZE) {
+        uint16_t old = s->window[slot];
+        s->window_sum -= old;
+        s->window_sum_sq -= (uint32_t)old * old;
+    }
+    s->window[slot] = x;
+    s->window_sum += x;
+    s->window_sum_sq += (uint32_t)x * x;
+
+    // Expire deque fronts that left the window
+    uint32_t oldest = (pos >= STATS_WINDOW_SIZE) ? (pos - STATS_WINDOW_SIZE + 1) : 0;
+    if (s->min_head != s->min_tail && s->min_deque[s->min_head & STATS_WINDOW_MASK] < oldest) {
+        s->min_head++;
+    }
+    if (s->max_head != s->max_tail && s->max_deque[s->max_head & STATS_WINDOW_MASK] < oldest) {
+        s->max_head++;
+    }
+
+    // Drop back entries the new sample dominates; each index is pushed
+    // and popped at most once, hence amortised O(1)
+    while (s->min_head != s->min_tail &&
+           s->window[s->min_deque[(s->min_tail - 1) & STATS_WINDOW_MASK] & STATS_WINDOW_MASK] >= x) {
+        s->min_tail--;
+    }
+    s->min_deque[s->min_tail++ & STATS_WINDOW_MASK] = pos;
+
+    while (s->max_head != s->max_tail &&
+           s->window[s->max_deque[(s->max_tail - 1) & STATS_WINDOW_MASK] & STATS_WINDOW_MASK] <= x) {
+        s->max_tail--;
+    }
+    s->max_deque[s->max_tail++ & STATS_WINDOW_MASK] = pos;
+
+    s->window_pos = pos + 1;
+}
+
+static uint64_t mean_q16(uint64_t sum, uint32_t n) {
+    // sum / n in Q16 without shifting sum first: sum_sq passes 2^48 after
+    // ~16.7M full-scale 12-bit samples (~65k at 16 bits)
+    uint64_t q = sum / n;
+    uint64_t r = sum % n;
+    return (q << 16) + (r << 16) / n;
+}
+
+static void stats_fill_spread(stats_summary_t *out, uint64_t variance_q8, uint64_t mean_sq_q16) {
+    out->variance_q8 = (uint32_t)variance_q8;
+    out->stddev_q8 = isqrt64(variance_q8 << 8);     // sqrt(Q16) = Q8
+    out->rms_q8 = isqrt64(mean_sq_q16);
+}
+
+/* ============================================
+   Public Functions
+   ============================================ */
+
+void stats_init(stats_t *s) {
+    if (s == NULL) {
+        return;
+    }
+
+    memset(s, 0, sizeof(*s));
+    stats_reset_running(s);
+}
+
+void stats_reset_running(stats_t *s) {
+    if (s == NULL) {
+        return;
+    }
+
+    s->count = 0;
+    s->min = UINT16_MAX;
+    s->max = 0;
+    s->mean_q16 = 0;
+    s->m2_q8 = 0;
+    s->sum_sq = 0;
+}
+
+void stats_update(stats_t *s, uint16_t x) {
+    // Running min/max
+    if (x < s->min) {
+        s->min = x;
+    }
+    if (x > s->max) {
+        s->max = x;
+    }
+
+    // Welford: mean += d / n, M2 += d * (x - mean_new). The mean is kept
+    // in Q16 so per-sample truncation does not bias it; the deltas are
+    // narrowed to Q8 before multiplying so the product fits in 64 bits
+    int64_t x_q16 = (int64_t)x << 16;
+    s->count++;
+    int64_t delta = x_q16 - s->mean_q16;
+    s->mean_q16 += delta / (int64_t)s->count;
+    int64_t delta2 = x_q16 - s->mean_q16;
+    s->m2_q8 += (uint64_t)(((delta >> 8) * (delta2 >> 8)) >> 8);
+
+    s->sum_sq += (uint32_t)x * x;
+
+    stats_window_push(s, x);
+}
+
+void stats_update_block(stats_t *s, const uint16_t *in, uint16_t count, uint16_t stride) {
+    if (s == NULL || in == NULL) {
+        return;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        stats_update(s, in[(uint32_t)i * stride]);
+    }
+}
+
+void stats_get_summary(const stats_t *s, stats_summary_t *out) {
+    if (s == NULL || out == NULL) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    if (s->count == 0) {
+        return;
+    }
+
+    out->count = s->count;
+    out->min = s->min;
+    out->max = s->max;
+    out->mean_q8 = (uint32_t)(s->mean_q16 >> 8);
+    stats_fill_spread(out, s->m2_q8 / s->count, mean_q16(s->sum_sq, s->count));
+}
+
+void stats_get_window_summary(const stats_t *s, stats_summary_t *out) {
+    if (s == NULL || out == NULL) {
+        return;
+    }
+
+    memset(out, 0, sizeof(*out));
+    uint32_t n = (s->window_pos < STATS_WINDOW_SIZE) ? s->window_pos : STATS_WINDOW_SIZE;
+    if (n == 0) {
+        return;
+    }
+
+    out->count = n;
+    out->min = s->window[s->min_deque[s->min_head & STATS_WINDOW_MASK] & STATS_WINDOW_MASK];
+    out->max = s->window[s->max_deque[s->max_head & STATS_WINDOW_MASK] & STATS_WINDOW_MASK];
+
+    // mean = sum / n, variance = E[x^2] - mean^2 (computed in Q16)
+    uint64_t mean_q16 = ((uint64_t)s->window_sum << 16) / n;
+    uint64_t mean_sq_q16 = (s->window_sum_sq << 16) / n;
+    uint64_t mean_q8 = mean_q16 >> 8;
+    uint64_t square_of_mean_q16 = mean_q8 * mean_q8;
+    uint64_t variance_q16 = (mean_sq_q16 > square_of_mean_q16) ? (mean_sq_q16 - square_of_mean_q16) : 0;
+
+    out->mean_q8 = (uint32_t)mean_q8;
+    stats_fill_spread(out, variance_q16 >> 8, mean_sq_q16);
+}
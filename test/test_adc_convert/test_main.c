@@ -0,0 +1,91 @@
+/**
+ * Host unit tests: core/adc_convert.h (raw-to-millivolt tables)
+ *
+ *   pio test -e native_test -f test_adc_convert
+ */
+
+#include "core/adc_convert.h"
+#include <unity.h>
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// The formula the tables replace, in floating point
+static uint16_t reference_mv(uint32_t raw) {
+    double counts = (raw > ADC_CAL_OFFSET_COUNTS) ? (double)(raw - ADC_CAL_OFFSET_COUNTS) : 0.0;
+    double mv = counts * ADC_REFERENCE_MV * ((double)ADC_CAL_GAIN_Q16 / 65536.0) / ADC_MAX_VALUE;
+    uint32_t rounded = (uint32_t)(mv + 0.5);
+    return (uint16_t)((rounded > 0xFFFFU) ? 0xFFFFU : rounded);
+}
+
+/* ============================================
+   Tests
+   ============================================ */
+
+static void test_table_matches_reference_formula(void) {
+    for (uint32_t raw = 0; raw <= ADC_MAX_VALUE; raw++) {
+        TEST_ASSERT_EQUAL_UINT16_MESSAGE(reference_mv(raw), adc_mv_table[raw], "adc_mv_table");
+        TEST_ASSERT_EQUAL_UINT16(adc_mv_table[raw], adc_convert_raw_to_mv((uint16_t)raw));
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, adc_convert_raw_to_mv(0));
+}
+
+static void test_split_matches_table(void) {
+    for (uint32_t raw = 0; raw <= ADC_MAX_VALUE; raw++) {
+        uint32_t whole, decimal;
+        adc_convert_raw_to_split((uint16_t)raw, &whole, &decimal);
+        TEST_ASSERT_EQUAL_UINT32(adc_mv_table[raw] / 1000U, whole);
+        TEST_ASSERT_EQUAL_UINT32(adc_mv_table[raw] % 1000U, decimal);
+    }
+}
+
+static void test_lookup_masks_to_resolution(void) {
+    TEST_ASSERT_EQUAL_UINT16(adc_mv_table[5], adc_convert_raw_to_mv((uint16_t)(ADC_MAX_VALUE + 1 + 5)));
+}
+
+static void test_block_matches_per_sample(void) {
+    // Odd length exercises the unrolled loop and its tail
+    uint16_t in[37];
+    uint16_t out[37];
+    for (uint16_t i = 0; i < 37; i++) {
+        in[i] = (uint16_t)((i * 331U) & ADC_MAX_VALUE);
+    }
+
+    adc_convert_block_mv(in, out, 37, ADC_RESOLUTION);
+    for (uint16_t i = 0; i < 37; i++) {
+        TEST_ASSERT_EQUAL_UINT16(adc_convert_raw_to_mv(in[i]), out[i]);
+    }
+
+    // In-place conversion
+    adc_convert_block_mv(in, in, 37, ADC_RESOLUTION);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(out, in, 37);
+}
+
+static void test_oversampled_values_interpolate(void) {
+    // 14-bit: every fourth code lands on a table entry
+    for (uint32_t raw = 0; raw < ADC_MAX_VALUE; raw += 97) {
+        uint32_t lo = adc_mv_table[raw];
+        uint32_t hi = adc_mv_table[raw + 1];
+        TEST_ASSERT_EQUAL_UINT32(lo, adc_convert_value_to_mv(raw << 2, 14));
+        TEST_ASSERT_EQUAL_UINT32(lo + ((hi - lo) * 2U + 2U) / 4U, adc_convert_value_to_mv((raw << 2) + 2, 14));
+    }
+
+    // Codes above the last segment clamp to full scale
+    TEST_ASSERT_EQUAL_UINT32(adc_mv_table[ADC_MAX_VALUE],
+                             adc_convert_value_to_mv(((uint32_t)ADC_MAX_VALUE << 2) + 3, 14));
+    TEST_ASSERT_EQUAL_UINT32(adc_mv_table[ADC_MAX_VALUE],
+                             adc_convert_value_to_mv(0xFFFFU, 16));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_table_matches_reference_formula);
+    RUN_TEST(test_split_matches_table);
+    RUN_TEST(test_lookup_masks_to_resolution);
+    RUN_TEST(test_block_matches_per_sample);
+    RUN_TEST(test_oversampled_values_interpolate);
+    return UNITY_END();
+}
@@ -0,0 +1,160 @@
+/**
+ * Host unit tests: core/adc_oversample.h (4^k:1 block oversampling)
+ *
+ *   pio test -e native_test -f test_adc_oversample
+ *
+ * native_test builds with ADC_OVERSAMPLE_SHIFT 4 (256 inputs per output);
+ * the cases are written against ADC_OVERSAMPLE_RATIO and hold for k >= 2.
+ */
+
+#include "core/adc_oversample.h"
+#include <stddef.h>
+#include <unity.h>
+
+#if ADC_OVERSAMPLE_SHIFT < 2
+#error "test_adc_oversample splits groups at up to 10 samples; needs ADC_OVERSAMPLE_SHIFT >= 2"
+#endif
+
+#define RATIO ADC_OVERSAMPLE_RATIO
+#define CHANNELS 3U
+
+static adc_oversampler_t os;
+static uint16_t input[3U * RATIO * CHANNELS];
+static uint16_t output[4U * CHANNELS];
+
+void setUp(void) {
+    adc_oversampler_reset(&os);
+    for (uint32_t i = 0; i < sizeof(output) / sizeof(output[0]); i++) {
+        output[i] = 0xFFFF;
+    }
+}
+
+void tearDown(void) {
+}
+
+// Reference: one group of samples start, start + stride, ... summed and shifted
+static uint16_t expected_group(const uint16_t *start, uint32_t stride) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < RATIO; i++) {
+        sum += start[i * stride];
+    }
+    return (uint16_t)(sum >> ADC_OVERSAMPLE_SHIFT);
+}
+
+static void fill_ramp(uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        input[i] = (uint16_t)((i * 37U) % (ADC_MAX_VALUE + 1U));
+    }
+}
+
+/* ============================================
+   Tests
+   ============================================ */
+
+static void test_full_scale_does_not_overflow(void) {
+    for (uint32_t i = 0; i < 2U * RATIO; i++) {
+        input[i] = ADC_MAX_VALUE;
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(2, adc_oversample_block(&os, input, (uint16_t)(2U * RATIO), 1, output, 1));
+    TEST_ASSERT_EQUAL_UINT16(ADC_MAX_VALUE << ADC_OVERSAMPLE_SHIFT, output[0]);
+    TEST_ASSERT_EQUAL_UINT16(ADC_MAX_VALUE << ADC_OVERSAMPLE_SHIFT, output[1]);
+#if ADC_OVERSAMPLE_SHIFT == 4
+    // 256 x 4095 = 1048320 in the accumulator, >> 4 is the 16-bit top
+    TEST_ASSERT_EQUAL_UINT16(65520, output[0]);
+#endif
+}
+
+static void test_group_split_across_blocks(void) {
+    fill_ramp(3U * RATIO);
+
+    // Block 1: one full group and 5 samples of the next
+    TEST_ASSERT_EQUAL_UINT16(1, adc_oversample_block(&os, input, (uint16_t)(RATIO + 5U), 1, output, 1));
+    TEST_ASSERT_EQUAL_UINT16(expected_group(input, 1), output[0]);
+    TEST_ASSERT_EQUAL_UINT16(5, os.pending);
+
+    // Block 2: the rest of that group, one more full group, 2 left over
+    uint16_t count = (uint16_t)(2U * RATIO - 3U);
+    TEST_ASSERT_EQUAL_UINT16(2, adc_oversample_block(&os, &input[RATIO + 5U], count, 1, &output[1], 1));
+    TEST_ASSERT_EQUAL_UINT16(expected_group(&input[RATIO], 1), output[1]);
+    TEST_ASSERT_EQUAL_UINT16(expected_group(&input[2U * RATIO], 1), output[2]);
+    TEST_ASSERT_EQUAL_UINT16(2, os.pending);
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, output[3]);
+}
+
+static void test_block_shorter_than_a_group(void) {
+    fill_ramp(RATIO);
+
+    // Three short blocks complete one group only in the last call
+    TEST_ASSERT_EQUAL_UINT16(0, adc_oversample_block(&os, input, 3, 1, output, 1));
+    TEST_ASSERT_EQUAL_UINT16(0, adc_oversample_block(&os, &input[3], 0, 1, output, 1));
+    TEST_ASSERT_EQUAL_UINT16(0, adc_oversample_block(&os, &input[3], (uint16_t)(RATIO - 4U), 1, output, 1));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, output[0]);
+    TEST_ASSERT_EQUAL_UINT16(1, adc_oversample_block(&os, &input[RATIO - 1U], 1, 1, output, 1));
+    TEST_ASSERT_EQUAL_UINT16(expected_group(input, 1), output[0]);
+    TEST_ASSERT_EQUAL_UINT16(0, os.pending);
+}
+
+static void test_strided_multichannel(void) {
+    adc_oversampler_t channel_os[CHANNELS];
+    const uint32_t frames = 2U * RATIO + 7U;
+
+    // Interleaved frames: channel c carries its own offset on a shared ramp
+    for (uint32_t f = 0; f < frames; f++) {
+        for (uint32_t c = 0; c < CHANNELS; c++) {
+            input[f * CHANNELS + c] = (uint16_t)((f * 13U + c * 1000U) % (ADC_MAX_VALUE + 1U));
+        }
+    }
+
+    for (uint32_t c = 0; c < CHANNELS; c++) {
+        adc_oversampler_reset(&channel_os[c]);
+        uint16_t n = adc_oversample_block(&channel_os[c], &input[c], (uint16_t)frames, CHANNELS,
+                                          &output[c], CHANNELS);
+        TEST_ASSERT_EQUAL_UINT16(2, n);
+        TEST_ASSERT_EQUAL_UINT16(7, channel_os[c].pending);
+    }
+
+    // Outputs land interleaved the same way
+    for (uint32_t o = 0; o < 2U; o++) {
+        for (uint32_t c = 0; c < CHANNELS; c++) {
+            TEST_ASSERT_EQUAL_UINT16(expected_group(&input[o * RATIO * CHANNELS + c], CHANNELS),
+                                     output[o * CHANNELS + c]);
+        }
+    }
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, output[2U * CHANNELS]);
+}
+
+static void test_reset_drops_carry(void) {
+    for (uint32_t i = 0; i < RATIO + 10U; i++) {
+        input[i] = (i < 10U) ? ADC_MAX_VALUE : 100U;
+    }
+
+    adc_oversample_block(&os, input, 10, 1, output, 1);
+    TEST_ASSERT_EQUAL_UINT16(10, os.pending);
+    adc_oversampler_reset(&os);
+    TEST_ASSERT_EQUAL_UINT16(0, os.pending);
+    TEST_ASSERT_EQUAL_UINT32(0, os.sum);
+
+    // The next group starts clean: no full-scale samples carried in
+    TEST_ASSERT_EQUAL_UINT16(0, adc_oversample_block(&os, &input[10], (uint16_t)(RATIO - 10U), 1, output, 1));
+    TEST_ASSERT_EQUAL_UINT16(1, adc_oversample_block(&os, &input[10], 10, 1, output, 1));
+    TEST_ASSERT_EQUAL_UINT16((100U * RATIO) >> ADC_OVERSAMPLE_SHIFT, output[0]);
+}
+
+static void test_rejects_null_arguments(void) {
+    TEST_ASSERT_EQUAL_UINT16(0, adc_oversample_block(NULL, input, RATIO, 1, output, 1));
+    TEST_ASSERT_EQUAL_UINT16(0, adc_oversample_block(&os, NULL, RATIO, 1, output, 1));
+    TEST_ASSERT_EQUAL_UINT16(0, adc_oversample_block(&os, input, RATIO, 1, NULL, 1));
+    adc_oversampler_reset(NULL);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_full_scale_does_not_overflow);
+    RUN_TEST(test_group_split_across_blocks);
+    RUN_TEST(test_block_shorter_than_a_group);
+    RUN_TEST(test_strided_multichannel);
+    RUN_TEST(test_reset_drops_carry);
+    RUN_TEST(test_rejects_null_arguments);
+    return UNITY_END();
+}
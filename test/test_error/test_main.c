@@ -0,0 +1,244 @@
+/**
+ * Host unit tests: utils/error.h (per-code counters and event log)
+ *
+ *   pio test -e native_test -f test_error
+ */
+
+#include "utils/error.h"
+#include "core/timebase.h"
+#include "native/native_shim.h"
+#include <stddef.h>
+#include <unity.h>
+
+// Counter order: ERROR_NONE, the bit codes, the extended codes, the shared slot
+static const error_code_t slot_codes[] = {
+    ERROR_NONE,
+    ERROR_ADC_FAILED, ERROR_DMA_FAILED, ERROR_UART_FAILED, ERROR_TIMER_FAILED,
+    ERROR_BUFFER_OVERFLOW, ERROR_BUFFER_UNDERFLOW, ERROR_INVALID_PARAM,
+    ERROR_TIMEOUT, ERROR_ADC_OVERRUN, ERROR_SAMPLES_DROPPED, ERROR_TX_DROPPED,
+    ERROR_FLASH_FAILED, ERROR_USB_FAILED, ERROR_STALL, ERROR_FAULT, ERROR_NO_MEMORY,
+};
+
+#define SLOT_CODE_COUNT (sizeof(slot_codes) / sizeof(slot_codes[0]))
+#define RATE_LIMIT_US ((uint64_t)ERROR_RATE_LIMIT_MS * 1000U)
+#define SHARED_SLOT 24U                 // ERROR_NONE + 7 bit codes + 16 extended (0x80-0x8F)
+
+void setUp(void) {
+    timebase_init();
+    error_init();
+}
+
+void tearDown(void) {
+}
+
+/* ============================================
+   Per-Code Counters
+   ============================================ */
+
+static void test_each_code_has_its_own_counter(void) {
+    // Code i is reported i + 1 times; critical, so every report is logged
+    for (uint8_t i = 1; i < SLOT_CODE_COUNT; i++) {
+        for (uint8_t n = 0; n <= i; n++) {
+            error_report(slot_codes[i], 3, "test");
+        }
+    }
+
+    for (uint8_t i = 1; i < SLOT_CODE_COUNT; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i + 1U, error_get_code_count(slot_codes[i]));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, error_get_code_count(ERROR_NONE));
+    TEST_ASSERT_EQUAL_UINT32(0, error_get_code_count(ERROR_UNKNOWN));
+    TEST_ASSERT_TRUE(error_is_critical());
+}
+
+static void test_code_stats_walk_slot_order(void) {
+    error_code_stats_t stats;
+
+    error_report(ERROR_DMA_FAILED, 2, "dma");
+    error_report(ERROR_NO_MEMORY, 2, "arena");
+
+    for (uint8_t i = 0; i < SLOT_CODE_COUNT; i++) {
+        TEST_ASSERT_TRUE(error_get_code_stats(i, &stats));
+        TEST_ASSERT_EQUAL_HEX8(slot_codes[i], stats.code);
+    }
+    TEST_ASSERT_TRUE(error_get_code_stats(2, &stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.count);
+    TEST_ASSERT_TRUE(error_get_code_stats(16, &stats));
+    TEST_ASSERT_EQUAL_HEX8(ERROR_NO_MEMORY, stats.code);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.count);
+
+    // Unused extended slots up to 0x8F, then the shared one
+    TEST_ASSERT_TRUE(error_get_code_stats(17, &stats));
+    TEST_ASSERT_EQUAL_HEX8(0x89, stats.code);
+    TEST_ASSERT_TRUE(error_get_code_stats(SHARED_SLOT, &stats));
+    TEST_ASSERT_EQUAL_HEX8(ERROR_UNKNOWN, stats.code);
+    TEST_ASSERT_FALSE(error_get_code_stats(SHARED_SLOT + 1U, &stats));
+    TEST_ASSERT_FALSE(error_get_code_stats(0, NULL));
+}
+
+static void test_unlisted_codes_share_one_counter(void) {
+    // Not a single bit, and past the extended range
+    error_report((error_code_t)0x03, 2, "two bits");
+    error_report((error_code_t)0x90, 2, "past 0x8F");
+    error_report(ERROR_UNKNOWN, 2, "unknown");
+
+    TEST_ASSERT_EQUAL_UINT32(3, error_get_code_count(ERROR_UNKNOWN));
+    TEST_ASSERT_EQUAL_UINT32(3, error_get_code_count((error_code_t)0x41));
+    TEST_ASSERT_EQUAL_UINT32(0, error_get_code_count(ERROR_DMA_FAILED));
+    TEST_ASSERT_EQUAL_UINT32(0, error_get_code_count(ERROR_ADC_FAILED));
+    TEST_ASSERT_EQUAL_UINT32(3, error_get_count());
+}
+
+static void test_counters_saturate(void) {
+    error_t entry;
+
+    native_error_set_code_count(ERROR_STALL, UINT32_MAX - 1U);
+    error_report(ERROR_STALL, 3, "stall");
+    error_report(ERROR_STALL, 3, "stall");
+    error_report(ERROR_STALL, 3, "stall");
+
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, error_get_code_count(ERROR_STALL));
+    TEST_ASSERT_TRUE(error_read(0, &entry));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, entry.count);
+    TEST_ASSERT_TRUE(error_read(2, &entry));
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, entry.count);
+
+    // Saturation of one code leaves the others alone
+    error_report(ERROR_FAULT, 3, "fault");
+    TEST_ASSERT_EQUAL_UINT32(1, error_get_code_count(ERROR_FAULT));
+    TEST_ASSERT_EQUAL_UINT32(4, error_get_count());
+}
+
+/* ============================================
+   Rate Limit
+   ============================================ */
+
+static void test_repeats_within_window_are_counted_not_logged(void) {
+    error_code_stats_t stats;
+    error_t entry;
+
+    for (uint8_t i = 0; i < 5; i++) {
+        error_report(ERROR_TX_DROPPED, 1, "tx");
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, error_get_code_count(ERROR_TX_DROPPED));
+    TEST_ASSERT_EQUAL_UINT32(1, error_get_sequence());
+    TEST_ASSERT_TRUE(error_get_code_stats(11, &stats));
+    TEST_ASSERT_EQUAL_HEX8(ERROR_TX_DROPPED, stats.code);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.suppressed);
+
+    // The window is per code: a flood of one does not hide another
+    error_report(ERROR_ADC_OVERRUN, 2, "ovr");
+    TEST_ASSERT_EQUAL_UINT32(2, error_get_sequence());
+
+    // Once the window has passed the code is logged again, with its running count
+    native_timebase_advance_us(RATE_LIMIT_US + 2000U);
+    error_report(ERROR_TX_DROPPED, 1, "tx");
+    TEST_ASSERT_EQUAL_UINT32(3, error_get_sequence());
+    TEST_ASSERT_TRUE(error_read(2, &entry));
+    TEST_ASSERT_EQUAL_HEX8(ERROR_TX_DROPPED, entry.code);
+    TEST_ASSERT_EQUAL_UINT32(6, entry.count);
+    TEST_ASSERT_TRUE(error_get_code_stats(11, &stats));
+    TEST_ASSERT_EQUAL_UINT32(4, stats.suppressed);
+}
+
+static void test_critical_reports_are_always_logged(void) {
+    error_code_stats_t stats;
+
+    error_report(ERROR_FAULT, 2, "first");
+    error_report(ERROR_FAULT, 2, "suppressed");
+    TEST_ASSERT_FALSE(error_is_critical());
+
+    error_report(ERROR_FAULT, 3, "critical");
+    error_report(ERROR_FAULT, 3, "critical");
+    TEST_ASSERT_EQUAL_UINT32(3, error_get_sequence());
+    TEST_ASSERT_TRUE(error_is_critical());
+    TEST_ASSERT_EQUAL_HEX8(ERROR_FAULT, error_get_last().code);
+    TEST_ASSERT_EQUAL_UINT32(4, error_get_last().count);
+
+    TEST_ASSERT_TRUE(error_get_code_stats(15, &stats));
+    TEST_ASSERT_EQUAL_HEX8(ERROR_FAULT, stats.code);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.suppressed);
+}
+
+/* ============================================
+   Event Log
+   ============================================ */
+
+static void test_empty_log(void) {
+    error_t entry;
+
+    TEST_ASSERT_EQUAL_UINT32(0, error_get_sequence());
+    TEST_ASSERT_EQUAL_HEX8(ERROR_NONE, error_get_last().code);
+    TEST_ASSERT_FALSE(error_read(0, &entry));
+}
+
+static void test_read_rejects_overwritten_and_unwritten(void) {
+    error_t entry;
+    const uint32_t total = ERROR_LOG_SIZE + 3U;
+
+    for (uint32_t i = 0; i < total; i++) {
+        error_report(ERROR_STALL, 3, "stall");
+    }
+    TEST_ASSERT_EQUAL_UINT32(total, error_get_sequence());
+
+    // The first three slots were reused by the last three events
+    TEST_ASSERT_FALSE(error_read(0, &entry));
+    TEST_ASSERT_FALSE(error_read(2, &entry));
+    TEST_ASSERT_TRUE(error_read(3, &entry));
+    TEST_ASSERT_EQUAL_UINT32(3, entry.sequence);
+    TEST_ASSERT_EQUAL_UINT32(4, entry.count);
+
+    // A sequence not reached yet maps onto a slot holding an older one
+    TEST_ASSERT_FALSE(error_read(total, &entry));
+    TEST_ASSERT_FALSE(error_read(total + ERROR_LOG_SIZE, &entry));
+    TEST_ASSERT_FALSE(error_read(3, NULL));
+}
+
+static void test_last_after_wrap(void) {
+    const uint32_t total = 2U * ERROR_LOG_SIZE + 5U;
+
+    for (uint32_t i = 0; i < total; i++) {
+        error_report((i & 1U) ? ERROR_FAULT : ERROR_STALL, 3, (i == total - 1U) ? "last" : "not last");
+    }
+
+    error_t last = error_get_last();
+    TEST_ASSERT_EQUAL_HEX8(ERROR_STALL, last.code);
+    TEST_ASSERT_EQUAL_UINT32(total - 1U, last.sequence);
+    TEST_ASSERT_EQUAL_UINT8(3, last.severity);
+    TEST_ASSERT_EQUAL_UINT32(total / 2U + 1U, last.count);
+    TEST_ASSERT_EQUAL_STRING("last", last.message);
+}
+
+static void test_clear_keeps_sequence_running(void) {
+    error_t entry;
+
+    error_report(ERROR_STALL, 3, "before");
+    error_report(ERROR_STALL, 3, "before");
+    error_clear();
+
+    TEST_ASSERT_EQUAL_UINT32(2, error_get_sequence());
+    TEST_ASSERT_FALSE(error_read(1, &entry));
+    TEST_ASSERT_EQUAL_HEX8(ERROR_NONE, error_get_last().code);
+    TEST_ASSERT_EQUAL_UINT32(0, error_get_count());
+    TEST_ASSERT_FALSE(error_is_critical());
+
+    error_report(ERROR_FAULT, 3, "after");
+    TEST_ASSERT_TRUE(error_read(2, &entry));
+    TEST_ASSERT_EQUAL_HEX8(ERROR_FAULT, entry.code);
+    TEST_ASSERT_EQUAL_UINT32(1, entry.count);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_each_code_has_its_own_counter);
+    RUN_TEST(test_code_stats_walk_slot_order);
+    RUN_TEST(test_unlisted_codes_share_one_counter);
+    RUN_TEST(test_counters_saturate);
+    RUN_TEST(test_repeats_within_window_are_counted_not_logged);
+    RUN_TEST(test_critical_reports_are_always_logged);
+    RUN_TEST(test_empty_log);
+    RUN_TEST(test_read_rejects_overwritten_and_unwritten);
+    RUN_TEST(test_last_after_wrap);
+    RUN_TEST(test_clear_keeps_sequence_running);
+    return UNITY_END();
+}
@@ -0,0 +1,136 @@
+/**
+ * Host unit tests: middleware/filter.h (FIR decimator)
+ *
+ *   pio test -e native_test -f test_filter
+ */
+
+#include "middleware/filter.h"
+#include <stddef.h>
+#include <unity.h>
+
+#define TEST_BASELINE 2048U             // Mid-scale, so negative taps stay in range
+#define TEST_IMPULSE 1024U
+#define TEST_BLOCK 256U
+
+static fir_decimator_t filter;
+static uint16_t in[TEST_BLOCK];
+static uint16_t out[TEST_BLOCK];
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static void fill(uint16_t value, uint16_t count) {
+    for (uint16_t i = 0; i < count; i++) {
+        in[i] = value;
+    }
+}
+
+// Baseline plus impulse: y = B + round(A * h / 32768), matching the Q15 rounding
+static uint16_t impulse_expected(int16_t h) {
+    return (uint16_t)(TEST_BASELINE + (((int32_t)TEST_IMPULSE * h + (1 << 14)) >> 15));
+}
+
+/* ============================================
+   Tests
+   ============================================ */
+
+static void test_init_rejects_invalid_arguments(void) {
+    TEST_ASSERT_FALSE(fir_decimator_init(&filter, filter_lowpass_d4, 0, 1));
+    TEST_ASSERT_FALSE(fir_decimator_init(&filter, filter_lowpass_d4, FILTER_MAX_TAPS + 1, 1));
+    TEST_ASSERT_FALSE(fir_decimator_init(&filter, filter_lowpass_d4, FILTER_LOWPASS_D4_TAPS, 0));
+    TEST_ASSERT_FALSE(fir_decimator_init(&filter, NULL, FILTER_LOWPASS_D4_TAPS, 1));
+}
+
+static void test_dc_gain_is_unity(void) {
+    TEST_ASSERT_TRUE(fir_decimator_init(&filter, filter_lowpass_d4, FILTER_LOWPASS_D4_TAPS, 4));
+
+    // Settle the history, then every output equals the input level
+    fill(1000, TEST_BLOCK);
+    TEST_ASSERT_EQUAL_UINT16(TEST_BLOCK / 4, fir_decimator_process(&filter, in, TEST_BLOCK, 1, out, 1));
+    TEST_ASSERT_EQUAL_UINT16(TEST_BLOCK / 4, fir_decimator_process(&filter, in, TEST_BLOCK, 1, out, 1));
+    for (uint16_t i = 0; i < TEST_BLOCK / 4; i++) {
+        TEST_ASSERT_EQUAL_UINT16(1000, out[i]);
+    }
+}
+
+static void test_impulse_response_matches_taps(void) {
+    TEST_ASSERT_TRUE(fir_decimator_init(&filter, filter_lowpass_d4, FILTER_LOWPASS_D4_TAPS, 1));
+
+    fill(TEST_BASELINE, TEST_BLOCK);
+    fir_decimator_process(&filter, in, TEST_BLOCK, 1, out, 1);
+
+    in[0] = TEST_BASELINE + TEST_IMPULSE;
+    TEST_ASSERT_EQUAL_UINT16(TEST_BLOCK, fir_decimator_process(&filter, in, TEST_BLOCK, 1, out, 1));
+    for (uint16_t k = 0; k < FILTER_LOWPASS_D4_TAPS; k++) {
+        TEST_ASSERT_EQUAL_UINT16(impulse_expected(filter_lowpass_d4[k]), out[k]);
+    }
+    for (uint16_t k = FILTER_LOWPASS_D4_TAPS; k < TEST_BLOCK; k++) {
+        TEST_ASSERT_EQUAL_UINT16(TEST_BASELINE, out[k]);
+    }
+}
+
+static void test_decimated_impulse_keeps_every_nth_tap(void) {
+    TEST_ASSERT_TRUE(fir_decimator_init(&filter, filter_lowpass_d4, FILTER_LOWPASS_D4_TAPS, 4));
+
+    fill(TEST_BASELINE, TEST_BLOCK);
+    fir_decimator_process(&filter, in, TEST_BLOCK, 1, out, 1);
+
+    // Outputs fall on inputs 3, 7, 11, ... so output m sees tap 4m + 3
+    in[0] = TEST_BASELINE + TEST_IMPULSE;
+    fir_decimator_process(&filter, in, TEST_BLOCK, 1, out, 1);
+    for (uint16_t m = 0; m < FILTER_LOWPASS_D4_TAPS / 4; m++) {
+        TEST_ASSERT_EQUAL_UINT16(impulse_expected(filter_lowpass_d4[4 * m + 3]), out[m]);
+    }
+}
+
+static void test_split_calls_match_one_call(void) {
+    uint16_t whole[TEST_BLOCK / 4];
+    uint16_t pieces[TEST_BLOCK / 4];
+    uint16_t produced = 0;
+
+    for (uint16_t i = 0; i < TEST_BLOCK; i++) {
+        in[i] = (uint16_t)((i * 97U) & ADC_MAX_VALUE);
+    }
+
+    fir_decimator_init(&filter, filter_lowpass_d4, FILTER_LOWPASS_D4_TAPS, 4);
+    TEST_ASSERT_EQUAL_UINT16(TEST_BLOCK / 4, fir_decimator_process(&filter, in, TEST_BLOCK, 1, whole, 1));
+
+    // Odd-sized calls carry history and decimation phase across calls
+    fir_decimator_reset(&filter);
+    for (uint16_t off = 0; off < TEST_BLOCK; off += 7) {
+        uint16_t n = (TEST_BLOCK - off < 7) ? (uint16_t)(TEST_BLOCK - off) : 7;
+        produced += fir_decimator_process(&filter, &in[off], n, 1, &pieces[produced], 1);
+    }
+    TEST_ASSERT_EQUAL_UINT16(TEST_BLOCK / 4, produced);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(whole, pieces, TEST_BLOCK / 4);
+}
+
+static void test_strides_filter_one_channel(void) {
+    // Channel 1 of an interleaved pair is DC 3000, channel 0 is noise
+    static uint16_t scan[TEST_BLOCK * 2];
+    for (uint16_t i = 0; i < TEST_BLOCK; i++) {
+        scan[2 * i] = (uint16_t)((i * 1237U) & ADC_MAX_VALUE);
+        scan[2 * i + 1] = 3000;
+    }
+
+    fir_decimator_init(&filter, filter_lowpass_d4, FILTER_LOWPASS_D4_TAPS, 4);
+    fir_decimator_process(&filter, &scan[1], TEST_BLOCK, 2, out, 2);
+    fir_decimator_process(&filter, &scan[1], TEST_BLOCK, 2, out, 2);
+    for (uint16_t m = 0; m < TEST_BLOCK / 4; m++) {
+        TEST_ASSERT_EQUAL_UINT16(3000, out[2 * m]);
+    }
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_init_rejects_invalid_arguments);
+    RUN_TEST(test_dc_gain_is_unity);
+    RUN_TEST(test_impulse_response_matches_taps);
+    RUN_TEST(test_decimated_impulse_keeps_every_nth_tap);
+    RUN_TEST(test_split_calls_match_one_call);
+    RUN_TEST(test_strides_filter_one_channel);
+    return UNITY_END();
+}
@@ -0,0 +1,183 @@
+/**
+ * Host unit tests: drivers/buffer.h (ring_buffer_t)
+ *
+ *   pio test -e native_test -f test_ring_buffer
+ */
+
+#include "drivers/buffer.h"
+#include <stddef.h>
+#include <unity.h>
+
+#define TEST_RING_SIZE 8U
+
+static ring_buffer_t rb;
+static uint16_t storage[TEST_RING_SIZE];
+
+void setUp(void) {
+    ring_buffer_init(&rb, storage, TEST_RING_SIZE);
+}
+
+void tearDown(void) {
+}
+
+/* ============================================
+   Per-Element Access
+   ============================================ */
+
+static void test_init_rejects_invalid_arguments(void) {
+    TEST_ASSERT_FALSE(ring_buffer_init(NULL, storage, TEST_RING_SIZE));
+    TEST_ASSERT_FALSE(ring_buffer_init(&rb, NULL, TEST_RING_SIZE));
+    TEST_ASSERT_FALSE(ring_buffer_init(&rb, storage, 0));
+}
+
+static void test_write_read_wraps_in_order(void) {
+    uint16_t value;
+
+    // Move head and tail near the end so the next writes wrap
+    for (uint16_t i = 0; i < 6; i++) {
+        TEST_ASSERT_TRUE(ring_buffer_write(&rb, i));
+        TEST_ASSERT_TRUE(ring_buffer_read(&rb, &value));
+    }
+    TEST_ASSERT_TRUE(ring_buffer_is_empty(&rb));
+
+    for (uint16_t i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(ring_buffer_write(&rb, (uint16_t)(100 + i)));
+    }
+    TEST_ASSERT_EQUAL_UINT16(5, ring_buffer_count(&rb));
+
+    TEST_ASSERT_TRUE(ring_buffer_peek(&rb, 4, &value));
+    TEST_ASSERT_EQUAL_UINT16(104, value);
+    TEST_ASSERT_FALSE(ring_buffer_peek(&rb, 5, &value));
+
+    for (uint16_t i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(ring_buffer_read(&rb, &value));
+        TEST_ASSERT_EQUAL_UINT16(100 + i, value);
+    }
+    TEST_ASSERT_FALSE(ring_buffer_read(&rb, &value));
+    TEST_ASSERT_EQUAL_UINT32(0, ring_buffer_get_overwritten(&rb));
+}
+
+static void test_write_when_full_overwrites_oldest(void) {
+    uint16_t value;
+
+    for (uint16_t i = 0; i < TEST_RING_SIZE; i++) {
+        ring_buffer_write(&rb, i);
+    }
+    TEST_ASSERT_TRUE(ring_buffer_is_full(&rb));
+    TEST_ASSERT_EQUAL_UINT32(0, ring_buffer_get_overwritten(&rb));
+
+    // Three more writes drop 0, 1 and 2
+    ring_buffer_write(&rb, 8);
+    ring_buffer_write(&rb, 9);
+    ring_buffer_write(&rb, 10);
+    TEST_ASSERT_TRUE(ring_buffer_is_full(&rb));
+    TEST_ASSERT_EQUAL_UINT16(TEST_RING_SIZE, ring_buffer_count(&rb));
+    TEST_ASSERT_EQUAL_UINT32(3, ring_buffer_get_overwritten(&rb));
+
+    for (uint16_t i = 3; i <= 10; i++) {
+        TEST_ASSERT_TRUE(ring_buffer_read(&rb, &value));
+        TEST_ASSERT_EQUAL_UINT16(i, value);
+    }
+    TEST_ASSERT_TRUE(ring_buffer_is_empty(&rb));
+}
+
+static void test_clear_empties_buffer(void) {
+    ring_buffer_write(&rb, 1);
+    ring_buffer_write(&rb, 2);
+    ring_buffer_clear(&rb);
+
+    TEST_ASSERT_TRUE(ring_buffer_is_empty(&rb));
+    TEST_ASSERT_FALSE(ring_buffer_is_full(&rb));
+    TEST_ASSERT_EQUAL_UINT16(0, ring_buffer_count(&rb));
+}
+
+/* ============================================
+   Span (Zero-Copy) Access
+   ============================================ */
+
+static void test_claim_write_splits_at_wrap(void) {
+    ring_buffer_span_t spans[2];
+    uint16_t value;
+
+    // head = tail = 5: free space is 3 elements at the end, 5 at the start
+    for (uint16_t i = 0; i < 5; i++) {
+        ring_buffer_write(&rb, i);
+        ring_buffer_read(&rb, &value);
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(TEST_RING_SIZE, ring_buffer_claim_write(&rb, spans));
+    TEST_ASSERT_EQUAL_PTR(&storage[5], spans[0].data);
+    TEST_ASSERT_EQUAL_UINT16(3, spans[0].length);
+    TEST_ASSERT_EQUAL_PTR(&storage[0], spans[1].data);
+    TEST_ASSERT_EQUAL_UINT16(5, spans[1].length);
+
+    // Fill six elements across the wrap, then read them back in order
+    for (uint16_t i = 0; i < spans[0].length; i++) {
+        spans[0].data[i] = (uint16_t)(200 + i);
+    }
+    for (uint16_t i = 0; i < 3; i++) {
+        spans[1].data[i] = (uint16_t)(203 + i);
+    }
+    TEST_ASSERT_TRUE(ring_buffer_commit_write(&rb, 6));
+    TEST_ASSERT_EQUAL_UINT16(6, ring_buffer_count(&rb));
+
+    for (uint16_t i = 0; i < 6; i++) {
+        TEST_ASSERT_TRUE(ring_buffer_read(&rb, &value));
+        TEST_ASSERT_EQUAL_UINT16(200 + i, value);
+    }
+}
+
+static void test_claim_write_never_overwrites(void) {
+    ring_buffer_span_t spans[2];
+
+    for (uint16_t i = 0; i < 6; i++) {
+        ring_buffer_write(&rb, i);
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(2, ring_buffer_claim_write(&rb, spans));
+    TEST_ASSERT_FALSE(ring_buffer_commit_write(&rb, 3));
+    TEST_ASSERT_TRUE(ring_buffer_commit_write(&rb, 2));
+    TEST_ASSERT_TRUE(ring_buffer_is_full(&rb));
+    TEST_ASSERT_EQUAL_UINT16(0, ring_buffer_claim_write(&rb, spans));
+    TEST_ASSERT_EQUAL_UINT32(0, ring_buffer_get_overwritten(&rb));
+}
+
+static void test_peek_read_splits_at_wrap(void) {
+    ring_buffer_span_t spans[2];
+    uint16_t value;
+
+    // tail = 6, then seven elements: two at the end, five at the start
+    for (uint16_t i = 0; i < 6; i++) {
+        ring_buffer_write(&rb, i);
+        ring_buffer_read(&rb, &value);
+    }
+    for (uint16_t i = 0; i < 7; i++) {
+        ring_buffer_write(&rb, (uint16_t)(300 + i));
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(7, ring_buffer_peek_read(&rb, spans));
+    TEST_ASSERT_EQUAL_PTR(&storage[6], spans[0].data);
+    TEST_ASSERT_EQUAL_UINT16(2, spans[0].length);
+    TEST_ASSERT_EQUAL_PTR(&storage[0], spans[1].data);
+    TEST_ASSERT_EQUAL_UINT16(5, spans[1].length);
+    TEST_ASSERT_EQUAL_UINT16(300, spans[0].data[0]);
+    TEST_ASSERT_EQUAL_UINT16(302, spans[1].data[0]);
+
+    TEST_ASSERT_FALSE(ring_buffer_release_read(&rb, 8));
+    TEST_ASSERT_TRUE(ring_buffer_release_read(&rb, 3));
+    TEST_ASSERT_EQUAL_UINT16(4, ring_buffer_count(&rb));
+    TEST_ASSERT_TRUE(ring_buffer_read(&rb, &value));
+    TEST_ASSERT_EQUAL_UINT16(303, value);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_init_rejects_invalid_arguments);
+    RUN_TEST(test_write_read_wraps_in_order);
+    RUN_TEST(test_write_when_full_overwrites_oldest);
+    RUN_TEST(test_clear_empties_buffer);
+    RUN_TEST(test_claim_write_splits_at_wrap);
+    RUN_TEST(test_claim_write_never_overwrites);
+    RUN_TEST(test_peek_read_splits_at_wrap);
+    return UNITY_END();
+}
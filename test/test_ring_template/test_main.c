@@ -0,0 +1,172 @@
+/**
+ * Host unit tests: drivers/ring_template.h (RING_DECLARE)
+ *
+ *   pio test -e native_test -f test_ring_template
+ */
+
+#include "drivers/ring_template.h"
+#include <unity.h>
+
+typedef struct {
+    uint16_t raw;
+    uint32_t timestamp;
+} test_item_t;
+
+// Two instantiations: struct elements with 8-bit indices, words with 16-bit
+RING_DECLARE(item_ring, test_item_t, 4, uint8_t)
+RING_DECLARE(word_ring, uint32_t, 8, uint16_t)
+
+static item_ring_t items;
+static word_ring_t words;
+
+void setUp(void) {
+    item_ring_init(&items);
+    word_ring_init(&words);
+}
+
+void tearDown(void) {
+}
+
+static void advance_words(uint32_t count) {
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        word_ring_push(&words, &value);
+        word_ring_pop(&words, &value);
+    }
+}
+
+/* ============================================
+   Tests
+   ============================================ */
+
+static void test_empty_after_init(void) {
+    test_item_t item;
+    uint32_t value = 0;
+
+    TEST_ASSERT_TRUE(item_ring_is_empty(&items));
+    TEST_ASSERT_FALSE(item_ring_is_full(&items));
+    TEST_ASSERT_EQUAL_UINT32(4, item_ring_free(&items));
+    TEST_ASSERT_FALSE(item_ring_pop(&items, &item));
+    TEST_ASSERT_NULL(item_ring_peek(&items, 0));
+    TEST_ASSERT_NULL(item_ring_back(&items));
+
+    TEST_ASSERT_TRUE(word_ring_is_empty(&words));
+    TEST_ASSERT_EQUAL_UINT32(8, word_ring_free(&words));
+    TEST_ASSERT_FALSE(word_ring_pop(&words, &value));
+}
+
+static void test_struct_elements_across_wrap(void) {
+    test_item_t in;
+    test_item_t out = { 0 };
+
+    // Offset 3: one element fits before the end, two wrap
+    for (uint16_t i = 0; i < 3; i++) {
+        in = (test_item_t){ i, i };
+        item_ring_push(&items, &in);
+        item_ring_pop(&items, &out);
+    }
+    for (uint16_t i = 0; i < 3; i++) {
+        in = (test_item_t){ (uint16_t)(100 + i), 1000UL + i };
+        TEST_ASSERT_TRUE(item_ring_push(&items, &in));
+    }
+    TEST_ASSERT_EQUAL_UINT32(3, item_ring_count(&items));
+    TEST_ASSERT_EQUAL_UINT16(100, items.buffer[3].raw);
+    TEST_ASSERT_EQUAL_UINT16(101, items.buffer[0].raw);
+
+    TEST_ASSERT_EQUAL_UINT16(101, item_ring_peek(&items, 1)->raw);
+    TEST_ASSERT_EQUAL_UINT32(1002, item_ring_back(&items)->timestamp);
+    TEST_ASSERT_NULL(item_ring_peek(&items, 3));
+
+    for (uint16_t i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(item_ring_pop(&items, &out));
+        TEST_ASSERT_EQUAL_UINT16(100 + i, out.raw);
+        TEST_ASSERT_EQUAL_UINT32(1000UL + i, out.timestamp);
+    }
+    TEST_ASSERT_TRUE(item_ring_is_empty(&items));
+}
+
+static void test_push_when_full_drops_newest(void) {
+    uint32_t value = 0;
+
+    advance_words(5);
+    for (uint32_t i = 0; i < 8; i++) {
+        value = 50 + i;
+        TEST_ASSERT_TRUE(word_ring_push(&words, &value));
+    }
+    TEST_ASSERT_TRUE(word_ring_is_full(&words));
+    TEST_ASSERT_EQUAL_UINT32(0, word_ring_free(&words));
+
+    value = 99;
+    TEST_ASSERT_FALSE(word_ring_push(&words, &value));
+    TEST_ASSERT_EQUAL_UINT32(1, words.dropped);
+
+    // Unread data is intact: the rejected element was the newest
+    for (uint32_t i = 0; i < 8; i++) {
+        TEST_ASSERT_TRUE(word_ring_pop(&words, &value));
+        TEST_ASSERT_EQUAL_UINT32(50 + i, value);
+    }
+    TEST_ASSERT_TRUE(word_ring_is_empty(&words));
+}
+
+static void test_push_overwrite_drops_oldest(void) {
+    test_item_t in;
+    test_item_t out = { 0 };
+
+    for (uint16_t i = 0; i < 6; i++) {
+        in = (test_item_t){ i, i };
+        item_ring_push_overwrite(&items, &in);
+    }
+    TEST_ASSERT_TRUE(item_ring_is_full(&items));
+    TEST_ASSERT_EQUAL_UINT32(2, items.dropped);
+
+    for (uint16_t i = 2; i < 6; i++) {
+        TEST_ASSERT_TRUE(item_ring_pop(&items, &out));
+        TEST_ASSERT_EQUAL_UINT16(i, out.raw);
+    }
+    TEST_ASSERT_TRUE(item_ring_is_empty(&items));
+}
+
+static void test_clear_keeps_indices_running(void) {
+    uint32_t value = 7;
+
+    advance_words(3);
+    word_ring_push(&words, &value);
+    word_ring_push(&words, &value);
+    word_ring_clear(&words);
+    TEST_ASSERT_TRUE(word_ring_is_empty(&words));
+    TEST_ASSERT_EQUAL_UINT32(5, words.head);
+    TEST_ASSERT_EQUAL_UINT32(8, word_ring_free(&words));
+}
+
+static void test_indices_survive_counter_overflow(void) {
+    test_item_t in;
+    test_item_t out = { 0 };
+
+    // 8-bit indices wrap after 256 elements
+    items.head = 0xFE;
+    items.tail = 0xFE;
+    for (uint16_t i = 0; i < 4; i++) {
+        in = (test_item_t){ (uint16_t)(200 + i), 0 };
+        TEST_ASSERT_TRUE(item_ring_push(&items, &in));
+    }
+    TEST_ASSERT_EQUAL_UINT8(0x02, items.head);
+    TEST_ASSERT_TRUE(item_ring_is_full(&items));
+    TEST_ASSERT_EQUAL_UINT16(203, item_ring_back(&items)->raw);
+
+    for (uint16_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(item_ring_pop(&items, &out));
+        TEST_ASSERT_EQUAL_UINT16(200 + i, out.raw);
+    }
+    TEST_ASSERT_TRUE(item_ring_is_empty(&items));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_after_init);
+    RUN_TEST(test_struct_elements_across_wrap);
+    RUN_TEST(test_push_when_full_drops_newest);
+    RUN_TEST(test_push_overwrite_drops_oldest);
+    RUN_TEST(test_clear_keeps_indices_running);
+    RUN_TEST(test_indices_survive_counter_overflow);
+    return UNITY_END();
+}
@@ -0,0 +1,114 @@
+/**
+ * Host unit tests: drivers/spsc_ring.h (spsc_ring_t)
+ *
+ *   pio test -e native_test -f test_spsc_ring
+ */
+
+#include "drivers/spsc_ring.h"
+#include <stddef.h>
+#include <unity.h>
+
+#define TEST_RING_SIZE 8U
+
+static spsc_ring_t rb;
+static uint16_t storage[TEST_RING_SIZE];
+
+void setUp(void) {
+    spsc_ring_init(&rb, storage, TEST_RING_SIZE);
+}
+
+void tearDown(void) {
+}
+
+static void advance(uint32_t count) {
+    uint16_t value;
+    for (uint32_t i = 0; i < count; i++) {
+        spsc_ring_write(&rb, 0);
+        spsc_ring_read(&rb, &value);
+    }
+}
+
+/* ============================================
+   Tests
+   ============================================ */
+
+static void test_init_requires_power_of_two(void) {
+    TEST_ASSERT_FALSE(spsc_ring_init(&rb, storage, 6));
+    TEST_ASSERT_FALSE(spsc_ring_init(&rb, storage, 0));
+    TEST_ASSERT_FALSE(spsc_ring_init(&rb, NULL, TEST_RING_SIZE));
+    TEST_ASSERT_TRUE(spsc_ring_init(&rb, storage, TEST_RING_SIZE));
+    TEST_ASSERT_TRUE(spsc_ring_is_empty(&rb));
+    TEST_ASSERT_EQUAL_UINT32(TEST_RING_SIZE, spsc_ring_free(&rb));
+}
+
+static void test_write_n_read_n_across_wrap(void) {
+    const uint16_t in[6] = { 10, 11, 12, 13, 14, 15 };
+    uint16_t out[6] = { 0 };
+
+    // Offset 5: three elements fit before the end, three wrap
+    advance(5);
+    TEST_ASSERT_EQUAL_UINT32(6, spsc_ring_write_n(&rb, in, 6));
+    TEST_ASSERT_EQUAL_UINT32(6, spsc_ring_count(&rb));
+    TEST_ASSERT_EQUAL_UINT16(13, storage[0]);
+    TEST_ASSERT_EQUAL_UINT16(12, storage[7]);
+
+    TEST_ASSERT_EQUAL_UINT32(6, spsc_ring_read_n(&rb, out, 6));
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(in, out, 6);
+    TEST_ASSERT_TRUE(spsc_ring_is_empty(&rb));
+    TEST_ASSERT_EQUAL_UINT32(0, rb.dropped);
+}
+
+static void test_read_n_returns_available(void) {
+    const uint16_t in[3] = { 1, 2, 3 };
+    uint16_t out[8] = { 0 };
+
+    advance(7);
+    spsc_ring_write_n(&rb, in, 3);
+    TEST_ASSERT_EQUAL_UINT32(3, spsc_ring_read_n(&rb, out, 8));
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(in, out, 3);
+    TEST_ASSERT_EQUAL_UINT32(0, spsc_ring_read_n(&rb, out, 8));
+}
+
+static void test_write_when_full_drops_newest(void) {
+    uint16_t in[10];
+    uint16_t out[TEST_RING_SIZE];
+    for (uint16_t i = 0; i < 10; i++) {
+        in[i] = (uint16_t)(50 + i);
+    }
+
+    advance(3);
+    TEST_ASSERT_EQUAL_UINT32(TEST_RING_SIZE, spsc_ring_write_n(&rb, in, 10));
+    TEST_ASSERT_TRUE(spsc_ring_is_full(&rb));
+    TEST_ASSERT_EQUAL_UINT32(2, rb.dropped);
+
+    TEST_ASSERT_FALSE(spsc_ring_write(&rb, 99));
+    TEST_ASSERT_EQUAL_UINT32(3, rb.dropped);
+
+    // Unread data is intact: the rejected elements were the newest
+    TEST_ASSERT_EQUAL_UINT32(TEST_RING_SIZE, spsc_ring_read_n(&rb, out, TEST_RING_SIZE));
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(in, out, TEST_RING_SIZE);
+}
+
+static void test_indices_survive_counter_overflow(void) {
+    const uint16_t in[5] = { 7, 8, 9, 10, 11 };
+    uint16_t out[5] = { 0 };
+
+    rb.head = 0xFFFFFFFEU;
+    rb.tail = 0xFFFFFFFEU;
+    TEST_ASSERT_EQUAL_UINT32(5, spsc_ring_write_n(&rb, in, 5));
+    TEST_ASSERT_EQUAL_UINT32(5, spsc_ring_count(&rb));
+    TEST_ASSERT_EQUAL_UINT32(3, spsc_ring_free(&rb));
+    TEST_ASSERT_EQUAL_UINT32(5, spsc_ring_read_n(&rb, out, 5));
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(in, out, 5);
+    TEST_ASSERT_TRUE(spsc_ring_is_empty(&rb));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_init_requires_power_of_two);
+    RUN_TEST(test_write_n_read_n_across_wrap);
+    RUN_TEST(test_read_n_returns_available);
+    RUN_TEST(test_write_when_full_drops_newest);
+    RUN_TEST(test_indices_survive_counter_overflow);
+    return UNITY_END();
+}
@@ -0,0 +1,167 @@
+/**
+ * Host unit tests: utils/stats.h (Welford running and sliding-window statistics)
+ *
+ *   pio test -e native_test -f test_stats
+ */
+
+#include "utils/stats.h"
+#include <unity.h>
+
+static stats_t stats;
+static stats_summary_t summary;
+
+void setUp(void) {
+    stats_init(&stats);
+}
+
+void tearDown(void) {
+}
+
+/* ============================================
+   Running Statistics
+   ============================================ */
+
+static void test_empty_summary_is_zero(void) {
+    stats_get_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.mean_q8);
+
+    stats_get_window_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.count);
+}
+
+static void test_welford_known_sequence(void) {
+    // Mean 5, population variance 4, standard deviation 2, RMS sqrt(29)
+    const uint16_t data[8] = { 2, 4, 4, 4, 5, 5, 7, 9 };
+    stats_update_block(&stats, data, 8, 1);
+
+    stats_get_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT32(8, summary.count);
+    TEST_ASSERT_EQUAL_UINT16(2, summary.min);
+    TEST_ASSERT_EQUAL_UINT16(9, summary.max);
+    TEST_ASSERT_UINT32_WITHIN(1, 5U * 256U, summary.mean_q8);
+    TEST_ASSERT_UINT32_WITHIN(2, 4U * 256U, summary.variance_q8);
+    TEST_ASSERT_UINT32_WITHIN(1, 2U * 256U, summary.stddev_q8);
+    TEST_ASSERT_UINT32_WITHIN(1, 1378, summary.rms_q8);
+}
+
+static void test_welford_large_offset(void) {
+    // A large mean with a small spread is where a naive E[x^2] - mean^2 loses precision
+    for (uint32_t i = 0; i < 10000; i++) {
+        stats_update(&stats, (uint16_t)(4000 + (i & 1U) * 2U));
+    }
+
+    stats_get_summary(&stats, &summary);
+    TEST_ASSERT_UINT32_WITHIN(1, 4001U * 256U, summary.mean_q8);
+    TEST_ASSERT_UINT32_WITHIN(4, 1U * 256U, summary.variance_q8);
+    TEST_ASSERT_UINT32_WITHIN(2, 1U * 256U, summary.stddev_q8);
+}
+
+static void test_stride_selects_one_channel(void) {
+    // Interleaved two-channel block: channel 0 = 10, channel 1 = 1000
+    uint16_t block[16];
+    for (uint16_t i = 0; i < 16; i++) {
+        block[i] = (i & 1U) ? 1000 : 10;
+    }
+
+    stats_update_block(&stats, &block[1], 8, 2);
+    stats_get_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT32(8, summary.count);
+    TEST_ASSERT_EQUAL_UINT16(1000, summary.min);
+    TEST_ASSERT_EQUAL_UINT16(1000, summary.max);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.variance_q8);
+}
+
+static void test_rms_after_long_full_scale_run(void) {
+    // More than 2^24 samples of 4095 push sum_sq past 2^48
+    static uint16_t block[4096];
+    for (uint16_t i = 0; i < 4096; i++) {
+        block[i] = 4095;
+    }
+    for (uint32_t i = 0; i < 4200; i++) {
+        stats_update_block(&stats, block, 4096, 1);
+    }
+
+    stats_get_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT32(4200U * 4096U, summary.count);
+    TEST_ASSERT_UINT32_WITHIN(1, 4095U * 256U, summary.mean_q8);
+    TEST_ASSERT_UINT32_WITHIN(1, 4095U * 256U, summary.rms_q8);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.variance_q8);
+}
+
+/* ============================================
+   Sliding Window
+   ============================================ */
+
+static void test_window_covers_last_samples(void) {
+    // Ramp 0..199: the window holds 136..199
+    for (uint16_t i = 0; i < 200; i++) {
+        stats_update(&stats, i);
+    }
+
+    stats_get_window_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT32(STATS_WINDOW_SIZE, summary.count);
+    TEST_ASSERT_EQUAL_UINT16(200 - STATS_WINDOW_SIZE, summary.min);
+    TEST_ASSERT_EQUAL_UINT16(199, summary.max);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)(2 * 199 - STATS_WINDOW_SIZE + 1) * 128U, summary.mean_q8);
+
+    // Variance of N consecutive integers is (N^2 - 1) / 12
+    uint32_t variance_q8 = (uint32_t)(((uint64_t)STATS_WINDOW_SIZE * STATS_WINDOW_SIZE - 1U) * 256U / 12U);
+    TEST_ASSERT_UINT32_WITHIN(2, variance_q8, summary.variance_q8);
+
+    // The running summary still covers everything
+    stats_get_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT32(200, summary.count);
+    TEST_ASSERT_EQUAL_UINT16(0, summary.min);
+    TEST_ASSERT_EQUAL_UINT16(199, summary.max);
+}
+
+static void test_window_max_expires(void) {
+    // Falling ramp: the window minimum is always the newest sample and
+    // the maximum must expire as old samples leave
+    for (uint16_t i = 0; i < 200; i++) {
+        stats_update(&stats, (uint16_t)(1000 - i));
+    }
+
+    stats_get_window_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT16(801, summary.min);
+    TEST_ASSERT_EQUAL_UINT16(800 + STATS_WINDOW_SIZE, summary.max);
+
+    // A spike followed by a full window of a constant leaves no trace
+    stats_update(&stats, 4095);
+    for (uint16_t i = 0; i < STATS_WINDOW_SIZE; i++) {
+        stats_update(&stats, 500);
+    }
+    stats_get_window_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT16(500, summary.min);
+    TEST_ASSERT_EQUAL_UINT16(500, summary.max);
+    TEST_ASSERT_EQUAL_UINT32(500U * 256U, summary.mean_q8);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.variance_q8);
+}
+
+static void test_reset_running_keeps_window(void) {
+    for (uint16_t i = 0; i < 10; i++) {
+        stats_update(&stats, 100);
+    }
+
+    stats_reset_running(&stats);
+    stats_get_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT32(0, summary.count);
+
+    stats_get_window_summary(&stats, &summary);
+    TEST_ASSERT_EQUAL_UINT32(10, summary.count);
+    TEST_ASSERT_EQUAL_UINT32(100U * 256U, summary.mean_q8);
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_summary_is_zero);
+    RUN_TEST(test_welford_known_sequence);
+    RUN_TEST(test_welford_large_offset);
+    RUN_TEST(test_stride_selects_one_channel);
+    RUN_TEST(test_rms_after_long_full_scale_run);
+    RUN_TEST(test_window_covers_last_samples);
+    RUN_TEST(test_window_max_expires);
+    RUN_TEST(test_reset_running_keeps_window);
+    return UNITY_END();
+}
@@ -0,0 +1,151 @@
+/**
+ * Host unit tests: middleware/telemetry.h (binary framing and CRC)
+ *
+ *   pio test -e native_test -f test_telemetry
+ */
+
+#include "middleware/telemetry.h"
+#include "core/uart.h"
+#include "native/native_shim.h"
+#include <unity.h>
+
+static uint8_t frame[TELEMETRY_FRAME_MAX_SIZE];
+
+void setUp(void) {
+    uart_init();
+    telemetry_init();
+}
+
+void tearDown(void) {
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// What a host decoder does: CRC over bytes 2..11 and the payload
+static uint16_t frame_crc(const uint8_t *f, uint16_t length) {
+    uint16_t crc = telemetry_crc16(0xFFFF, &f[2], 10);
+    return telemetry_crc16(crc, &f[TELEMETRY_HEADER_SIZE], (uint16_t)(length - TELEMETRY_HEADER_SIZE));
+}
+
+/* ============================================
+   CRC
+   ============================================ */
+
+static void test_crc16_check_value(void) {
+    // CRC-16/CCITT-FALSE catalogue check: "123456789" -> 0x29B1
+    const uint8_t check[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, telemetry_crc16(0xFFFF, check, 9));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, telemetry_crc16(0xFFFF, check, 0));
+
+    // Incremental updates match one pass
+    uint16_t crc = telemetry_crc16(0xFFFF, check, 4);
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, telemetry_crc16(crc, &check[4], 5));
+}
+
+/* ============================================
+   Frame Encoding
+   ============================================ */
+
+static void test_packed_frame_layout(void) {
+    const uint16_t samples[3] = { 0x123, 0xABC, 0xFFF };
+
+    uint16_t length = telemetry_encode_samples(frame, 0x1234, 0xDEADBEEFUL, 1, samples, 3);
+    TEST_ASSERT_EQUAL_UINT16(TELEMETRY_HEADER_SIZE + TELEMETRY_PACKED_SIZE(3), length);
+
+    TEST_ASSERT_EQUAL_HEX8(TELEMETRY_SYNC_0, frame[0]);
+    TEST_ASSERT_EQUAL_HEX8(TELEMETRY_SYNC_1, frame[1]);
+    TEST_ASSERT_EQUAL_HEX8(TELEMETRY_FRAME_SAMPLES, frame[2]);
+    TEST_ASSERT_EQUAL_UINT8(1, frame[3]);
+    TEST_ASSERT_EQUAL_HEX16(0x1234, get_u16(&frame[4]));
+    TEST_ASSERT_EQUAL_UINT16(3, get_u16(&frame[6]));
+    TEST_ASSERT_EQUAL_HEX32(0xDEADBEEFUL, get_u32(&frame[8]));
+
+    // Pair: s0[7:0], s1[3:0] << 4 | s0[11:8], s1[11:4]; odd tail in two bytes
+    const uint8_t payload[5] = { 0x23, 0xC1, 0xAB, 0xFF, 0x0F };
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(payload, &frame[TELEMETRY_HEADER_SIZE], 5);
+
+    TEST_ASSERT_EQUAL_HEX16(frame_crc(frame, length), get_u16(&frame[12]));
+    TEST_ASSERT_EQUAL_UINT16(length, telemetry_frame_length(frame));
+}
+
+static void test_crc_detects_corruption(void) {
+    const uint16_t samples[4] = { 1, 2, 3, 4 };
+    uint16_t length = telemetry_encode_samples(frame, 7, 0, 1, samples, 4);
+
+    frame[TELEMETRY_HEADER_SIZE + 2] ^= 0x01;
+    TEST_ASSERT_NOT_EQUAL(get_u16(&frame[12]), frame_crc(frame, length));
+}
+
+static void test_wide_frame_layout(void) {
+    const uint16_t samples[2] = { 0x3FFF, 0x1234 };
+
+    telemetry_set_sample_bits(14);
+    uint16_t length = telemetry_encode_samples(frame, 1, 0, 1, samples, 2);
+    TEST_ASSERT_EQUAL_UINT16(TELEMETRY_HEADER_SIZE + TELEMETRY_WIDE_SIZE(2), length);
+    TEST_ASSERT_EQUAL_HEX8(TELEMETRY_FRAME_SAMPLES16, frame[2]);
+    TEST_ASSERT_EQUAL_UINT8(14, frame[TELEMETRY_HEADER_SIZE]);
+    TEST_ASSERT_EQUAL_HEX16(0x3FFF, get_u16(&frame[TELEMETRY_HEADER_SIZE + 1]));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, get_u16(&frame[TELEMETRY_HEADER_SIZE + 3]));
+    TEST_ASSERT_EQUAL_HEX16(frame_crc(frame, length), get_u16(&frame[12]));
+    TEST_ASSERT_EQUAL_UINT16(length, telemetry_frame_length(frame));
+}
+
+static void test_status_frame_layout(void) {
+    const uint32_t values[2] = { 0x01020304UL, 0xCAFEF00DUL };
+
+    uint16_t length = telemetry_encode_status(frame, 9, 1000, values, 2);
+    TEST_ASSERT_EQUAL_UINT16(TELEMETRY_HEADER_SIZE + TELEMETRY_STATUS_SIZE(2), length);
+    TEST_ASSERT_EQUAL_HEX8(TELEMETRY_FRAME_STATUS, frame[2]);
+    TEST_ASSERT_EQUAL_UINT8(0, frame[3]);
+    TEST_ASSERT_EQUAL_HEX32(0x01020304UL, get_u32(&frame[TELEMETRY_HEADER_SIZE]));
+    TEST_ASSERT_EQUAL_HEX32(0xCAFEF00DUL, get_u32(&frame[TELEMETRY_HEADER_SIZE + 4]));
+    TEST_ASSERT_EQUAL_HEX16(frame_crc(frame, length), get_u16(&frame[12]));
+    TEST_ASSERT_EQUAL_UINT16(length, telemetry_frame_length(frame));
+}
+
+static void test_encode_rejects_invalid_parameters(void) {
+    const uint16_t samples[1] = { 0 };
+    const uint32_t values[1] = { 0 };
+
+    TEST_ASSERT_EQUAL_UINT16(0, telemetry_encode_samples(frame, 0, 0, 1, samples, 0));
+    TEST_ASSERT_EQUAL_UINT16(0, telemetry_encode_samples(frame, 0, 0, 1, samples, TELEMETRY_MAX_SAMPLES + 1));
+    TEST_ASSERT_EQUAL_UINT16(0, telemetry_encode_status(frame, 0, 0, values, 0));
+    TEST_ASSERT_EQUAL_UINT16(0, telemetry_encode_status(frame, 0, 0, values, TELEMETRY_STATUS_MAX_WORDS + 1));
+
+    frame[0] = 0;
+    TEST_ASSERT_EQUAL_UINT16(0, telemetry_frame_length(frame));
+}
+
+/* ============================================
+   Sending
+   ============================================ */
+
+static void test_send_splits_large_blocks(void) {
+    static uint16_t samples[TELEMETRY_MAX_SAMPLES + 10];
+    for (uint16_t i = 0; i < TELEMETRY_MAX_SAMPLES + 10; i++) {
+        samples[i] = (uint16_t)(i & 0x0FFF);
+    }
+
+    TEST_ASSERT_TRUE(telemetry_send_samples(samples, TELEMETRY_MAX_SAMPLES + 10, 1, 0));
+    TEST_ASSERT_EQUAL_UINT32(2U * TELEMETRY_HEADER_SIZE + TELEMETRY_PACKED_SIZE(TELEMETRY_MAX_SAMPLES) +
+                             TELEMETRY_PACKED_SIZE(10), (uint32_t)native_uart_get_bytes());
+    TEST_ASSERT_EQUAL_UINT32(0, telemetry_get_dropped_frames());
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc16_check_value);
+    RUN_TEST(test_packed_frame_layout);
+    RUN_TEST(test_crc_detects_corruption);
+    RUN_TEST(test_wide_frame_layout);
+    RUN_TEST(test_status_frame_layout);
+    RUN_TEST(test_encode_rejects_invalid_parameters);
+    RUN_TEST(test_send_splits_large_blocks);
+    return UNITY_END();
+}
@@ -0,0 +1,86 @@
+#!/usr/bin/env python3
+"""
+Parse and compare benchmark captures from the blackpill_f411ce_bench firmware.
+
+Capture layout (see src/bench/bench_main.c):
+
+    BENCH_BEGIN,<format>,<sysclk_hz>,<clock_profile>,<flags>
+    BENCH,<name>,<unit>,<units>,<total_cycles>,<cycles_per_unit>
+    BENCH_END,<rows>
+
+Usage:
+    bench_compare.py new.log                      # print as a table
+    bench_compare.py base.log new.log             # compare, exit 1 on regression
+    bench_compare.py base.log new.log --threshold 5
+
+Lines not starting with BENCH are ignored, so raw serial logs work.
+"""
+
+import argparse
+import sys
+
+
+def parse(path):
+    meta = {}
+    rows = {}
+    with open(path, "r", errors="replace") as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if fields[0] == "BENCH_BEGIN" and len(fields) >= 5:
+                meta = {"format": int(fields[1]), "sysclk_hz": int(fields[2]),
+                        "profile": int(fields[3]), "flags": int(fields[4])}
+                rows = {}
+            elif fields[0] == "BENCH" and len(fields) >= 6:
+                rows[fields[1]] = {"unit": fields[2], "units": int(fields[3]),
+                                   "cycles": int(fields[4]), "per_unit": float(fields[5])}
+    if not rows:
+        sys.exit("%s: no BENCH rows found" % path)
+    return meta, rows
+
+
+def value(row):
+    # Throughput rows carry their result in the units column
+    return float(row["units"]) if row["unit"] == "Bps" else row["per_unit"]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("base", help="baseline capture (or the only capture)")
+    parser.add_argument("new", nargs="?", help="capture to compare against base")
+    parser.add_argument("--threshold", type=float, default=2.0,
+                        help="regression threshold in percent (default: 2)")
+    args = parser.parse_args()
+
+    base_meta, base = parse(args.base)
+    if args.new is None:
+        print("sysclk %d Hz, profile %d, flags 0x%x"
+              % (base_meta.get("sysclk_hz", 0), base_meta.get("profile", -1), base_meta.get("flags", 0)))
+        for name, row in base.items():
+            suffix = "bytes/s" if row["unit"] == "Bps" else "cycles/" + row["unit"]
+            print("%-32s %12.2f %s" % (name, value(row), suffix))
+        return 0
+
+    new_meta, new = parse(args.new)
+    if base_meta != new_meta:
+        print("warning: build/clock differs: %s vs %s" % (base_meta, new_meta), file=sys.stderr)
+
+    regressions = 0
+    print("%-32s %12s %12s %8s" % ("benchmark", "base", "new", "delta"))
+    for name in sorted(set(base) | set(new)):
+        if name not in base or name not in new:
+            print("%-32s %s" % (name, "only in " + ("new" if name in new else "base")))
+            continue
+        b, n = value(base[name]), value(new[name])
+        delta = ((n - b) / b * 100.0) if b else 0.0
+        # Throughput rows are better when larger, cycle rows when smaller
+        worse = -delta if base[name]["unit"] == "Bps" else delta
+        flag = "  REGRESSION" if worse > args.threshold else ""
+        regressions += bool(flag)
+        print("%-32s %12.2f %12.2f %+7.1f%%%s" % (name, b, n, delta, flag))
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
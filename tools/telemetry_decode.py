@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+Decode binary telemetry frames (TELEMETRY_FORMAT_BINARY) into CSV.
+
+Frame layout matches include/middleware/telemetry.h:
+
+    sync(2) type(1) channels(1) seq(2) count(2) timestamp_us(4) crc16(2) payload
+
+Usage:
+    telemetry_decode.py capture.bin            # decode a raw capture file
+    telemetry_decode.py --port /dev/ttyUSB0    # decode live (needs pyserial)
+
+CSV columns: seq,timestamp_us,index,channel,raw,mv
+Sequence gaps, CRC failures, status (loss counter) frames and
+triggered capture headers (ENABLE_TRIGGER) are reported on stderr.
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+HEADER = struct.Struct("<2sBBHHIH")
+FRAME_SAMPLES = 0x01
+FRAME_SAMPLES16 = 0x02
+FRAME_STATUS = 0x03
+FRAME_CAPTURE = 0x04
+STATUS_NAMES = ("adc_ovr", "dma_lost", "blocks", "tx_bytes", "tx_frames",
+                "blocks_seen", "tx_peak")
+MAX_SAMPLES = 256
+REFERENCE_MV = 3300
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def packed_size(count):
+    return (count * 3 + 1) // 2
+
+
+def payload_size(ftype, count):
+    if ftype == FRAME_SAMPLES:
+        return packed_size(count)
+    if ftype in (FRAME_STATUS, FRAME_CAPTURE):
+        return 4 * count
+    return 1 + 2 * count
+
+
+def unpack16(payload, count):
+    return list(struct.unpack_from("<%dH" % count, payload, 1))
+
+
+def unpack12(payload, count):
+    samples = []
+    for i in range(0, count - 1, 2):
+        b0, b1, b2 = payload[3 * (i // 2):3 * (i // 2) + 3]
+        samples.append(b0 | ((b1 & 0x0F) << 8))
+        samples.append((b1 >> 4) | (b2 << 4))
+    if count % 2:
+        b0, b1 = payload[-2], payload[-1]
+        samples.append(b0 | ((b1 & 0x0F) << 8))
+    return samples
+
+
+class Decoder:
+    def __init__(self, out, log):
+        self.buf = bytearray()
+        self.out = out
+        self.log = log
+        self.expected_seq = None
+        self.frames = 0
+        self.lost_frames = 0
+        self.crc_errors = 0
+
+    def feed(self, data):
+        self.buf.extend(data)
+        while True:
+            start = self.buf.find(SYNC)
+            if start < 0:
+                # Keep a trailing 0xA5 that may start the next sync word
+                del self.buf[:max(0, len(self.buf) - 1)]
+                return
+            del self.buf[:start]
+            if len(self.buf) < HEADER.size:
+                return
+
+            _, ftype, channels, seq, count, ts, crc = HEADER.unpack_from(self.buf)
+            if ftype not in (FRAME_SAMPLES, FRAME_SAMPLES16, FRAME_STATUS, FRAME_CAPTURE) or count == 0 or count > MAX_SAMPLES:
+                del self.buf[:1]
+                continue
+
+            length = HEADER.size + payload_size(ftype, count)
+            if len(self.buf) < length:
+                return
+
+            frame = bytes(self.buf[:length])
+            calc = crc16_ccitt(frame[14:], crc16_ccitt(frame[2:12]))
+            if calc != crc:
+                self.crc_errors += 1
+                self.log.write("crc error at seq %d\n" % seq)
+                del self.buf[:1]
+                continue
+
+            del self.buf[:length]
+            if ftype == FRAME_STATUS:
+                self.status(seq, ts, struct.unpack_from("<%dI" % count, frame, 14))
+            elif ftype == FRAME_CAPTURE:
+                self.capture(seq, ts, channels, struct.unpack_from("<%dI" % count, frame, 14))
+            elif ftype == FRAME_SAMPLES:
+                self.handle(seq, ts, channels, unpack12(frame[14:], count), 12)
+            else:
+                self.handle(seq, ts, channels, unpack16(frame[14:], count), frame[14])
+
+    def check_sequence(self, seq):
+        if self.expected_seq is not None and seq != self.expected_seq:
+            gap = (seq - self.expected_seq) & 0xFFFF
+            self.lost_frames += gap
+            self.log.write("sequence gap: expected %d got %d (%d lost)\n"
+                           % (self.expected_seq, seq, gap))
+        self.expected_seq = (seq + 1) & 0xFFFF
+        self.frames += 1
+
+    def status(self, seq, ts, words):
+        self.check_sequence(seq)
+        fields = " ".join("%s=%d" % (STATUS_NAMES[i] if i < len(STATUS_NAMES) else "w%d" % i, w)
+                          for i, w in enumerate(words))
+        self.log.write("status at %d us: %s\n" % (ts, fields))
+
+    def capture(self, seq, ts, channels, words):
+        self.check_sequence(seq)
+        number, pre, post, period = words[:4]
+        trigger_us = (words[4] << 32) | ts if len(words) > 4 else ts
+        self.log.write("capture %d: trigger at %d us, %d before / %d from trigger, "
+                       "%d ch, %d us/frame\n" % (number, trigger_us, pre, post, channels, period))
+
+    def handle(self, seq, ts, channels, samples, bits):
+        self.check_sequence(seq)
+
+        channels = max(channels, 1)
+        full_scale = (1 << bits) - 1
+        for i, raw in enumerate(samples):
+            mv = raw * REFERENCE_MV // full_scale
+            self.out.write("%d,%d,%d,%d,%d,%d\n"
+                           % (seq, ts, i // channels, i % channels, raw, mv))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("file", nargs="?", help="raw capture file (default: stdin)")
+    parser.add_argument("--port", help="serial port to read live")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    decoder = Decoder(sys.stdout, sys.stderr)
+    sys.stdout.write("seq,timestamp_us,index,channel,raw,mv\n")
+
+    try:
+        if args.port:
+            import serial
+            with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+                while True:
+                    decoder.feed(port.read(4096))
+        else:
+            stream = open(args.file, "rb") if args.file else sys.stdin.buffer
+            while True:
+                chunk = stream.read(4096)
+                if not chunk:
+                    break
+                decoder.feed(chunk)
+    except KeyboardInterrupt:
+        pass
+
+    sys.stderr.write("frames=%d lost=%d crc_errors=%d\n"
+                     % (decoder.frames, decoder.lost_frames, decoder.crc_errors))
+
+
+if __name__ == "__main__":
+    main()